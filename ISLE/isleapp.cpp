@@ -5,6 +5,7 @@
 #include "3dmanager/lego3dmanager.h"
 #include "decomp.h"
 #include "isledebug.h"
+#include "isleheadless.h"
 #include "legoanimationmanager.h"
 #include "legobuildingmanager.h"
 #include "legogamestate.h"
@@ -19,9 +20,11 @@
 #include "mxbackgroundaudiomanager.h"
 #include "mxdirectx/mxdirect3d.h"
 #include "mxdsaction.h"
+#include "mxmemorystats.h"
 #include "mxmisc.h"
 #include "mxomnicreateflags.h"
 #include "mxomnicreateparam.h"
+#include "mxprofiler.h"
 #include "mxstreamer.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
@@ -33,6 +36,7 @@
 #include "res/isle_bmp.h"
 #include "res/no_bmp.h"
 #include "res/resource.h"
+#include "roi/legolod.h"
 #include "roi/legoroi.h"
 #include "tgl/d3drm/impl.h"
 #include "viewmanager/viewmanager.h"
@@ -147,8 +151,11 @@ IsleApp::IsleApp()
 
 	m_iniPath = NULL;
 	m_maxLod = RealtimeView::GetUserMaxLOD();
+	m_lodHysteresis = ViewManager::GetLODHysteresis();
 	m_maxAllowedExtras = m_islandQuality <= 1 ? 10 : 20;
 	m_transitionType = MxTransitionManager::e_mosaic;
+	m_lodCache = FALSE;
+	m_profileTrace = NULL;
 }
 
 // FUNCTION: ISLE 0x4011a0
@@ -159,6 +166,18 @@ IsleApp::~IsleApp()
 		MxOmni::DestroyInstance();
 	}
 
+	LegoLOD::configureLegoLOD(NULL);
+
+	if (m_profileTrace) {
+		if (MxProfiler::WriteTrace(m_profileTrace) != SUCCESS) {
+			SDL_Log("Failed to write profile trace to %s", m_profileTrace);
+		}
+
+		delete[] m_profileTrace;
+	}
+
+	MxTimer::StopRecording();
+
 	if (m_hdPath) {
 		delete[] m_hdPath;
 	}
@@ -270,7 +289,7 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv)
 	SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS, "0");
 	SDL_SetHint(SDL_HINT_TOUCH_MOUSE_EVENTS, "0");
 
-	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK)) {
+	if (!SDL_Init(IsleHeadless_Setup(argc, argv, SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK))) {
 		char buffer[256];
 		SDL_snprintf(
 			buffer,
@@ -334,6 +353,10 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv)
 
 SDL_AppResult SDL_AppIterate(void* appstate)
 {
+	if (IsleHeadless_Enabled()) {
+		return IsleHeadless_Iterate();
+	}
+
 	if (g_closed) {
 		return SDL_APP_SUCCESS;
 	}
@@ -642,6 +665,17 @@ MxResult IsleApp::SetupWindow()
 		return FAILURE;
 	}
 
+	if (IsleHeadless_Enabled()) {
+		// The dummy video driver only offers the software renderer
+		char deviceId[64];
+		IsleHeadless_GetDeviceId(deviceId, sizeof(deviceId));
+		delete[] m_deviceId;
+		m_deviceId = new char[strlen(deviceId) + 1];
+		strcpy(m_deviceId, deviceId);
+		m_fullScreen = FALSE;
+		IsleHeadless_SetupClock();
+	}
+
 	SetupVideoFlags(
 		m_fullScreen,
 		m_flipSurfaces,
@@ -656,7 +690,14 @@ MxResult IsleApp::SetupWindow()
 
 	MxOmni::SetSound3D(m_use3dSound);
 
-	srand(time(NULL));
+	if (MxTimer::IsRealClock()) {
+		srand(time(NULL));
+	}
+	else {
+		// Reproducible runs need reproducible random numbers as well
+		srand(0);
+		SDL_srand(0);
+	}
 
 	// [library:window] Use original game cursors in the resources instead?
 	m_cursorCurrent = m_cursorArrow = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_DEFAULT);
@@ -676,7 +717,7 @@ MxResult IsleApp::SetupWindow()
 	SDL_SetBooleanProperty(props, SDL_PROP_WINDOW_CREATE_FULLSCREEN_BOOLEAN, m_fullScreen);
 	SDL_SetStringProperty(props, SDL_PROP_WINDOW_CREATE_TITLE_STRING, WINDOW_TITLE);
 #if defined(MINIWIN) && !defined(__3DS__)
-	SDL_SetBooleanProperty(props, SDL_PROP_WINDOW_CREATE_OPENGL_BOOLEAN, true);
+	SDL_SetBooleanProperty(props, SDL_PROP_WINDOW_CREATE_OPENGL_BOOLEAN, !IsleHeadless_Enabled());
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
 #endif
@@ -747,6 +788,15 @@ MxResult IsleApp::SetupWindow()
 	LegoAnimationManager::configureLegoAnimationManager(m_maxAllowedExtras);
 	MxTransitionManager::configureMxTransitionManager(m_transitionType);
 	RealtimeView::SetUserMaxLOD(m_maxLod);
+	ViewManager::SetLODHysteresis(m_lodHysteresis);
+
+	if (m_lodCache) {
+		MxString lodCachePath(m_savePath);
+		lodCachePath += "\\lodcache.bin";
+		lodCachePath.MapPathToFilesystem();
+		LegoLOD::configureLegoLOD(lodCachePath.GetData());
+	}
+
 	if (LegoOmni::GetInstance()) {
 		if (LegoOmni::GetInstance()->GetInputManager()) {
 			LegoOmni::GetInstance()->GetInputManager()->SetUseJoystick(m_useJoystick);
@@ -768,6 +818,16 @@ MxResult IsleApp::SetupWindow()
 		}
 	}
 
+	IDirect3DRMMiniwinDevice* miniwinDevice = GetD3DRMMiniwinDevice();
+	if (miniwinDevice) {
+		miniwinDevice->SetProfileCallback(MxProfiler::MiniwinCallback);
+		miniwinDevice->SetMemoryCallback(MxMemoryStats::MiniwinCallback);
+	}
+
+	if (IsleHeadless_Enabled() && !IsleHeadless_Init()) {
+		return FAILURE;
+	}
+
 	IsleDebug_Init();
 
 	return SUCCESS;
@@ -849,8 +909,11 @@ bool IsleApp::LoadConfig()
 		iniparser_set(dict, "isle:Island Texture", SDL_itoa(m_islandTexture, buf, 10));
 		SDL_snprintf(buf, sizeof(buf), "%f", m_maxLod);
 		iniparser_set(dict, "isle:Max LOD", buf);
+		SDL_snprintf(buf, sizeof(buf), "%f", m_lodHysteresis);
+		iniparser_set(dict, "isle:LOD Hysteresis", buf);
 		iniparser_set(dict, "isle:Max Allowed Extras", SDL_itoa(m_maxAllowedExtras, buf, 10));
 		iniparser_set(dict, "isle:Transition Type", SDL_itoa(m_transitionType, buf, 10));
+		iniparser_set(dict, "isle:LOD Cache", m_lodCache ? "true" : "false");
 
 #ifdef __3DS__
 		N3DS_SetupDefaultConfigOverrides(dict);
@@ -915,9 +978,11 @@ bool IsleApp::LoadConfig()
 	m_islandQuality = iniparser_getint(dict, "isle:Island Quality", m_islandQuality);
 	m_islandTexture = iniparser_getint(dict, "isle:Island Texture", m_islandTexture);
 	m_maxLod = iniparser_getdouble(dict, "isle:Max LOD", m_maxLod);
+	m_lodHysteresis = iniparser_getdouble(dict, "isle:LOD Hysteresis", m_lodHysteresis);
 	m_maxAllowedExtras = iniparser_getint(dict, "isle:Max Allowed Extras", m_maxAllowedExtras);
 	m_transitionType =
 		(MxTransitionManager::TransitionType) iniparser_getint(dict, "isle:Transition Type", m_transitionType);
+	m_lodCache = iniparser_getboolean(dict, "isle:LOD Cache", m_lodCache);
 
 	const char* deviceId = iniparser_getstring(dict, "isle:3D Device ID", NULL);
 	if (deviceId != NULL) {
@@ -925,6 +990,17 @@ bool IsleApp::LoadConfig()
 		strcpy(m_deviceId, deviceId);
 	}
 
+	// Written at exit, see MxProfiler
+	const char* profileTrace = iniparser_getstring(dict, "isle:Profile Trace", NULL);
+	if (profileTrace != NULL) {
+		m_profileTrace = new char[strlen(profileTrace) + 1];
+		strcpy(m_profileTrace, profileTrace);
+		MxProfiler::Enable(TRUE);
+	}
+
+	// In seconds, 0 to not log memory use
+	MxMemoryStats::SetLogInterval(iniparser_getint(dict, "isle:Memory Log Interval", 0) * 1000);
+
 	// [library:config]
 	// The original game does not save any data if no savepath is given.
 	// Instead, we use SDLs prefPath as a default fallback and always save data.
@@ -971,20 +1047,28 @@ inline bool IsleApp::Tick()
 		return true;
 	}
 
+	// Fixed-step and replay clocks move a frame per tick instead of being waited on
+	MxTimer::AdvanceClock();
+
 	MxLong currentTime = Timer()->GetRealTime();
 	if (currentTime < g_lastFrameTime) {
 		g_lastFrameTime = -m_frameDelta;
 	}
 
 	if (m_frameDelta + g_lastFrameTime >= currentTime) {
-		SDL_Delay(1);
+		if (MxTimer::IsRealClock()) {
+			SDL_Delay(1);
+		}
 		return true;
 	}
 
+	Timer()->RecordFrame();
+
 	if (!Lego()->IsPaused()) {
 		TickleManager()->Tickle();
 	}
 	g_lastFrameTime = currentTime;
+	MxMemoryStats::Update();
 
 	if (IsleDebug_StepModeEnabled()) {
 		IsleDebug_SetPaused(true);
@@ -1087,6 +1171,8 @@ void IsleApp::SetupCursor(Cursor p_cursor)
 
 MxResult IsleApp::ParseArguments(int argc, char** argv)
 {
+	const char* headlessOption = NULL;
+
 	for (int i = 1, consumed; i < argc; i += consumed) {
 		consumed = -1;
 
@@ -1102,15 +1188,63 @@ MxResult IsleApp::ParseArguments(int argc, char** argv)
 #endif
 			consumed = 1;
 		}
+		else if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+			IsleHeadless_SetFrames(SDL_atoi(argv[i + 1]));
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+			IsleHeadless_SetStep(SDL_atoi(argv[i + 1]));
+			headlessOption = argv[i];
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+			IsleHeadless_SetScript(argv[i + 1]);
+			headlessOption = argv[i];
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+			IsleHeadless_SetStats(argv[i + 1]);
+			headlessOption = argv[i];
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--fixed-step") == 0 && i + 1 < argc) {
+			SetFixedStepClock(SDL_atoi(argv[i + 1]));
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--replay-clock") == 0 && i + 1 < argc) {
+			if (MxTimer::SetReplayClock(argv[i + 1])) {
+				consumed = 2;
+			}
+		}
+		else if (strcmp(argv[i], "--record-clock") == 0 && i + 1 < argc) {
+			MxTimer::StartRecording(argv[i + 1]);
+			consumed = 2;
+		}
 		if (consumed <= 0) {
 			SDL_Log("Invalid argument(s): %s", argv[i]);
 			return FAILURE;
 		}
 	}
 
+	if (headlessOption && !IsleHeadless_Enabled()) {
+		SDL_Log("Invalid argument(s): %s requires --headless", headlessOption);
+		return FAILURE;
+	}
+
 	return SUCCESS;
 }
 
+// Frames less than the frame delta apart are skipped, so the step is raised above it
+void IsleApp::SetFixedStepClock(MxS32 p_step)
+{
+	if (p_step <= m_frameDelta) {
+		p_step = m_frameDelta + 1;
+		SDL_Log("Fixed step raised to %d ms to exceed the frame delta", p_step);
+	}
+
+	MxTimer::SetFixedStepClock(p_step);
+}
+
 MxResult IsleApp::VerifyFilesystem()
 {
 #ifdef __EMSCRIPTEN__
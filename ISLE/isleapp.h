@@ -59,6 +59,7 @@ class IsleApp {
 	MxResult ParseArguments(int argc, char** argv);
 	MxResult VerifyFilesystem();
 	void DetectGameVersion();
+	void SetFixedStepClock(MxS32 p_step);
 
 private:
 	char* m_hdPath;              // 0x00
@@ -96,8 +97,11 @@ class IsleApp {
 
 	char* m_iniPath;
 	MxFloat m_maxLod;
+	MxFloat m_lodHysteresis;
 	MxU32 m_maxAllowedExtras;
 	MxTransitionManager::TransitionType m_transitionType;
+	MxBool m_lodCache;
+	char* m_profileTrace;
 };
 
 extern IsleApp* g_isle;
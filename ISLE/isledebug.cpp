@@ -1,15 +1,27 @@
 #include "isledebug.h"
 
 #include "isleapp.h"
+#include "lego/sources/3dmanager/lego3dmanager.h"
 #include "lego/sources/roi/legoroi.h"
 #include "legobuildingmanager.h"
+#include "legocachesoundmanager.h"
 #include "legoentity.h"
 #include "legogamestate.h"
 #include "legoplantmanager.h"
 #include "legosoundmanager.h"
+#include "legotextureinfo.h"
 #include "legovideomanager.h"
 #include "misc.h"
+#include "misc/legocontainer.h"
+#include "misc/legostorage.h"
+#include "mxmediapresenter.h"
+#include "mxmemorystats.h"
+#include "mxmisc.h"
+#include "mxprofiler.h"
+#include "mxstreamer.h"
+#include "mxstring.h"
 #include "mxticklemanager.h"
+#include "viewmanager/viewmanager.h"
 
 #include <SDL3/SDL.h>
 #include <backends/imgui_impl_sdl3.h>
@@ -38,6 +50,35 @@ static bool g_instrumentationEnabled;
 
 class DebugViewer {
 public:
+	static void InsideFrameStats()
+	{
+		static bool frameStatsEnabled;
+		if (ImGui::Checkbox("Frame stats", &frameStatsEnabled)) {
+			g_d3drmMiniwinDevice->EnableFrameStats(frameStatsEnabled);
+		}
+		MiniwinFrameStats stats;
+		if (!g_d3drmMiniwinDevice->GetFrameStats(&stats, ImGui::Button("Reset"))) {
+			return;
+		}
+		ImGui::Value("Frames", stats.frames);
+		if (!stats.frames) {
+			return;
+		}
+		double msPerTick = 1000.0 / SDL_GetPerformanceFrequency() / stats.frames;
+		ImGui::Text(
+			"Meshes tested/culled per frame: %u/%u",
+			stats.meshesTested / stats.frames,
+			stats.meshesCulled / stats.frames
+		);
+		ImGui::Text("Draws per frame: %u", stats.draws / stats.frames);
+		ImGui::Text("Triangles per frame: %u", stats.triangles / stats.frames);
+		ImGui::Text("Culling: %.3fms", stats.cullingTicks * msPerTick);
+		ImGui::Text("Lighting: %.3fms", stats.lightingTicks * msPerTick);
+		ImGui::Text("Rasterization: %.3fms", stats.rasterizationTicks * msPerTick);
+		ImGui::Text("Present: %.3fms", stats.presentTicks * msPerTick);
+		ImGui::Text("Image hash: %08x", stats.imageHash);
+	}
+
 	static void InsidePlantManager()
 	{
 		LegoPlantManager* plantManager = Lego()->GetPlantManager();
@@ -121,6 +162,84 @@ class DebugViewer {
 			ImGui::EndTable();
 		}
 	}
+	static void InsideMemory()
+	{
+		if (ImGui::BeginTable("Tags", 5, ImGuiTableFlags_Borders)) {
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Live KB");
+			ImGui::TableSetupColumn("Peak KB");
+			ImGui::TableSetupColumn("Allocations");
+			ImGui::TableSetupColumn("Frees");
+			ImGui::TableHeadersRow();
+			for (MxS32 i = 0; i < MxMemoryStats::e_numTags; i++) {
+				MxMemoryStats::Counters counters;
+				MxMemoryStats::Get((MxMemoryStats::Tag) i, counters);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%s", MxMemoryStats::GetName((MxMemoryStats::Tag) i));
+				ImGui::TableNextColumn();
+				ImGui::Text("%lld", (long long) (counters.m_live / 1024));
+				ImGui::TableNextColumn();
+				ImGui::Text("%lld", (long long) (counters.m_peak / 1024));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", counters.m_allocations);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", counters.m_frees);
+			}
+			ImGui::EndTable();
+		}
+		if (ImGui::Button("Log")) {
+			MxMemoryStats::Log();
+		}
+	}
+	static void InsideStreamer()
+	{
+		MxMemoryPoolStats stats[MxStreamer::e_numMemoryPools];
+		Streamer()->GetMemoryPoolStats(stats);
+		if (ImGui::BeginTable("Memory Pools", 6, ImGuiTableFlags_Borders)) {
+			ImGui::TableSetupColumn("Block Size");
+			ImGui::TableSetupColumn("Blocks");
+			ImGui::TableSetupColumn("Slabs");
+			ImGui::TableSetupColumn("Used");
+			ImGui::TableSetupColumn("High Water");
+			ImGui::TableSetupColumn("Misses");
+			ImGui::TableHeadersRow();
+			for (const MxMemoryPoolStats& pool : stats) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::Text("%uKB", pool.m_blockSize);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", pool.m_numBlocks);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", pool.m_numSlabs);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", pool.m_used);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", pool.m_highWater);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", pool.m_misses);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::Text("Looping chunk bytes shared: %u", MxMediaPresenter::GetLoopBytesShared());
+	}
+	static void InsideViewManager()
+	{
+		Lego3DManager* manager = Lego()->GetVideoManager()->Get3DManager();
+		if (!manager) {
+			ImGui::Text("No 3D manager");
+			return;
+		}
+		ViewManager* viewManager = manager->GetLego3DView()->GetViewManager();
+		const ViewManager::LODStats& stats = viewManager->GetLODStats();
+		ImGui::Text("ROIs visited: %u", stats.m_visited);
+		ImGui::Text("ROIs skipped: %u", stats.m_skipped);
+		ImGui::Text("ROIs switched: %u", stats.m_switched);
+		int threads = viewManager->GetLODSelectionThreads();
+		if (ImGui::SliderInt("LOD selection threads", &threads, 0, 8)) {
+			viewManager->SetLODSelectionThreads(threads);
+		}
+	}
 	static void InsideVideoManager()
 	{
 		auto videoManager = Lego()->GetVideoManager();
@@ -300,6 +419,7 @@ void IsleDebug_Render()
 			if (ImGui::TreeNode("Renderer")) {
 				if (g_d3drmMiniwinDevice) {
 					ImGui::Text("Using miniwin driver");
+					DebugViewer::InsideFrameStats();
 				}
 				else {
 					ImGui::Text("No miniwin driver");
@@ -314,12 +434,30 @@ void IsleDebug_Render()
 				if (volume != oldVolume) {
 					soundManager->SetVolume(volume);
 				}
+				MxAudioMixer::Stats stats;
+				soundManager->GetMixer()->GetStats(stats);
+				ImGui::Text("Mixer: %s", soundManager->GetMixer()->IsHeadless() ? "headless" : "threaded");
+				ImGui::Text("Commands applied: %u", stats.m_commands);
+				ImGui::Text("Blocks rendered: %u", stats.m_blocks);
+				ImGui::Text("Underruns: %u", stats.m_underruns);
+				ImGui::Text("Queue full waits: %u", stats.m_queueFull);
+				ImGui::Text("Allocations while mixing: %u", stats.m_realtimeAllocations);
+				LegoCacheSoundManager::Stats cacheStats;
+				soundManager->GetCacheSoundManager()->GetStats(cacheStats);
+				ImGui::Text("Cached sounds: %u", cacheStats.m_sounds);
+				ImGui::Text("Clones: %u (%u created)", cacheStats.m_clones, cacheStats.m_clonesCreated);
+				ImGui::Text("Resident PCM: %uKB", cacheStats.m_residentBytes / 1024);
+				ImGui::Text("Shared PCM: %uKB", cacheStats.m_sharedBytes / 1024);
 				ImGui::TreePop();
 			}
 			if (ImGui::TreeNode("Video Manager")) {
 				DebugViewer::InsideVideoManager();
 				ImGui::TreePop();
 			}
+			if (ImGui::TreeNode("View Manager")) {
+				DebugViewer::InsideViewManager();
+				ImGui::TreePop();
+			}
 			if (ImGui::TreeNode("Plant Manager")) {
 				DebugViewer::InsidePlantManager();
 				ImGui::TreePop();
@@ -332,6 +470,50 @@ void IsleDebug_Render()
 				DebugViewer::InsideTickleManager();
 				ImGui::TreePop();
 			}
+			if (ImGui::TreeNode("Streamer")) {
+				DebugViewer::InsideStreamer();
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Strings")) {
+				ImGui::Text("Heap allocations: %u", MxString::GetHeapAllocations());
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Textures")) {
+				ImGui::Text("Bytes loaded: %u", LegoTextureInfo::GetBytesLoaded());
+				LegoTextureContainer::Stats stats;
+				lego->GetTextureContainer()->GetStats(stats);
+				ImGui::Text("Cached: %u (%u idle)", stats.m_cached, stats.m_idle);
+				ImGui::Text("Cache hits: %u", stats.m_hits);
+				ImGui::Text("Cache misses: %u (%u created)", stats.m_misses, stats.m_created);
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Files")) {
+				LegoFile::Stats stats;
+				LegoFile::GetStats(stats);
+				ImGui::Text("Reads and writes: %u", stats.m_calls);
+				ImGui::Text("Passed on to SDL: %u", stats.m_ioCalls);
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Memory")) {
+				DebugViewer::InsideMemory();
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Profiler")) {
+				bool profilerEnabled = MxProfiler::IsEnabled();
+				if (ImGui::Checkbox("Enabled", &profilerEnabled)) {
+					MxProfiler::Enable(profilerEnabled);
+				}
+				if (ImGui::Button("Reset")) {
+					MxProfiler::Reset();
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Write isle-trace.json")) {
+					if (MxProfiler::WriteTrace("isle-trace.json") != SUCCESS) {
+						SDL_Log("Failed to write isle-trace.json: %s", SDL_GetError());
+					}
+				}
+				ImGui::TreePop();
+			}
 		}
 		ImGui::End();
 	}
@@ -0,0 +1,273 @@
+#include "isleheadless.h"
+
+#include "isleapp.h"
+#include "mxaudiomixer.h"
+#include "mxmemorystats.h"
+#include "mxmisc.h"
+#include "mxsoundmanager.h"
+#include "mxtimer.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+struct ScriptEvent {
+	enum Type {
+		e_key,
+		e_click,
+		e_quit
+	};
+
+	MxU32 m_frame;
+	Type m_type;
+	SDL_Keycode m_key;
+	float m_x;
+	float m_y;
+};
+
+bool g_enabled = false;
+MxU32 g_numFrames = 0;
+MxU32 g_step = 16;
+const char* g_scriptPath = NULL;
+const char* g_statsPath = NULL;
+
+std::vector<ScriptEvent> g_script;
+size_t g_nextEvent = 0;
+MxU32 g_frame = 0;
+std::vector<Uint64> g_frameTicks; // SDL_GetPerformanceCounter ticks spent in IsleApp::Tick
+std::vector<Uint64> g_gameTimes;  // MxTimer clock after each frame
+
+bool LoadScript(const char* p_path)
+{
+	size_t size;
+	char* text = (char*) SDL_LoadFile(p_path, &size);
+
+	if (!text) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load headless script %s: %s", p_path, SDL_GetError());
+		return false;
+	}
+
+	MxU32 lineNumber = 0;
+	bool result = true;
+
+	for (char* line = text; line && *line; lineNumber++) {
+		char* end = strchr(line, '\n');
+		if (end) {
+			*end = '\0';
+		}
+
+		ScriptEvent event;
+		char action[16];
+		char arg[64];
+		SDL_zero(event);
+
+		if (line[0] == '#' || sscanf(line, "%u %15s", &event.m_frame, action) != 2) {
+			// Comment or blank line
+		}
+		else if (!strcmp(action, "key") && sscanf(line, "%*u %*s %63s", arg) == 1 &&
+				 (event.m_key = SDL_GetKeyFromName(arg)) != SDLK_UNKNOWN) {
+			event.m_type = ScriptEvent::e_key;
+			g_script.push_back(event);
+		}
+		else if (!strcmp(action, "click") && sscanf(line, "%*u %*s %f %f", &event.m_x, &event.m_y) == 2) {
+			event.m_type = ScriptEvent::e_click;
+			g_script.push_back(event);
+		}
+		else if (!strcmp(action, "quit")) {
+			event.m_type = ScriptEvent::e_quit;
+			g_script.push_back(event);
+		}
+		else {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s:%u: invalid script line", p_path, lineNumber + 1);
+			result = false;
+			break;
+		}
+
+		line = end ? end + 1 : NULL;
+	}
+
+	SDL_free(text);
+
+	std::stable_sort(g_script.begin(), g_script.end(), [](const ScriptEvent& a, const ScriptEvent& b) {
+		return a.m_frame < b.m_frame;
+	});
+	return result;
+}
+
+// Queued now, handled by SDL_AppEvent before the next frame is ticked
+void PushScriptEvents(MxU32 p_frame)
+{
+	for (; g_nextEvent < g_script.size() && g_script[g_nextEvent].m_frame <= p_frame; g_nextEvent++) {
+		const ScriptEvent& scriptEvent = g_script[g_nextEvent];
+		SDL_Event event;
+		SDL_zero(event);
+
+		switch (scriptEvent.m_type) {
+		case ScriptEvent::e_key:
+			event.type = SDL_EVENT_KEY_DOWN;
+			event.key.key = scriptEvent.m_key;
+			event.key.down = true;
+			SDL_PushEvent(&event);
+			event.type = SDL_EVENT_KEY_UP;
+			event.key.down = false;
+			SDL_PushEvent(&event);
+			break;
+		case ScriptEvent::e_click:
+			// Touches carry game coordinates and the left button state, unlike pushed mouse events
+			event.type = SDL_EVENT_FINGER_DOWN;
+			event.tfinger.x = scriptEvent.m_x / 640.0f;
+			event.tfinger.y = scriptEvent.m_y / 480.0f;
+			SDL_PushEvent(&event);
+			event.type = SDL_EVENT_FINGER_UP;
+			SDL_PushEvent(&event);
+			break;
+		case ScriptEvent::e_quit:
+			// Ends the run at the next frame, so the stats are still written
+			g_numFrames = p_frame;
+			break;
+		}
+	}
+}
+
+void WriteStats()
+{
+	if (g_frameTicks.empty()) {
+		return;
+	}
+
+	double msPerTick = 1000.0 / SDL_GetPerformanceFrequency();
+	std::vector<Uint64> sorted(g_frameTicks);
+	std::sort(sorted.begin(), sorted.end());
+
+	Uint64 total = 0;
+	for (Uint64 ticks : sorted) {
+		total += ticks;
+	}
+
+	SDL_Log(
+		"Headless: %u frames over %u ms, tick mean %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms",
+		(MxU32) sorted.size(),
+		(MxU32) g_gameTimes.back(),
+		total * msPerTick / sorted.size(),
+		sorted[sorted.size() / 2] * msPerTick,
+		sorted[sorted.size() * 95 / 100] * msPerTick,
+		sorted[sorted.size() * 99 / 100] * msPerTick,
+		sorted.back() * msPerTick
+	);
+	MxMemoryStats::Log();
+
+	if (g_statsPath) {
+		SDL_IOStream* file = SDL_IOFromFile(g_statsPath, "w");
+
+		if (!file) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s: %s", g_statsPath, SDL_GetError());
+			return;
+		}
+
+		SDL_IOprintf(file, "frame,game_time_ms,tick_ms\n");
+		for (size_t i = 0; i < g_frameTicks.size(); i++) {
+			SDL_IOprintf(file, "%u,%u,%.4f\n", (MxU32) i, (MxU32) g_gameTimes[i], g_frameTicks[i] * msPerTick);
+		}
+
+		SDL_CloseIO(file);
+	}
+}
+} // namespace
+
+SDL_InitFlags IsleHeadless_Setup(int argc, char** argv, SDL_InitFlags p_flags)
+{
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			// Without the audio subsystem the sound manager cannot open a device and runs headless
+			SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+			return p_flags & ~(SDL_INIT_AUDIO | SDL_INIT_JOYSTICK);
+		}
+	}
+
+	return p_flags;
+}
+
+bool IsleHeadless_Enabled()
+{
+	return g_enabled;
+}
+
+void IsleHeadless_SetFrames(MxU32 p_frames)
+{
+	g_enabled = true;
+	g_numFrames = p_frames;
+}
+
+void IsleHeadless_SetStep(MxU32 p_milliseconds)
+{
+	g_step = p_milliseconds;
+}
+
+void IsleHeadless_SetScript(const char* p_path)
+{
+	g_scriptPath = p_path;
+}
+
+void IsleHeadless_SetStats(const char* p_path)
+{
+	g_statsPath = p_path;
+}
+
+void IsleHeadless_GetDeviceId(char* p_buffer, size_t p_size)
+{
+	// Miniwin's SOFTWARE_GUID, laid out the way LegoDeviceEnumerate::FormatDeviceName reads a GUID
+	const GUID softwareGuid = {0x682656f3, 0x0000, 0x0000, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02}};
+	Uint32 words[4];
+	memcpy(words, &softwareGuid, sizeof(words));
+
+	SDL_snprintf(p_buffer, p_size, "0 0x%x 0x%x 0x%x 0x%x", words[0], words[1], words[2], words[3]);
+}
+
+void IsleHeadless_SetupClock()
+{
+	// A clock replay given on the command line takes precedence
+	if (!MxTimer::IsRealClock()) {
+		return;
+	}
+
+	g_isle->SetFixedStepClock(g_step);
+}
+
+bool IsleHeadless_Init()
+{
+	if (g_scriptPath && !LoadScript(g_scriptPath)) {
+		return false;
+	}
+
+	g_frameTicks.reserve(g_numFrames);
+	g_gameTimes.reserve(g_numFrames);
+	PushScriptEvents(0);
+	return true;
+}
+
+SDL_AppResult IsleHeadless_Iterate()
+{
+	if (g_closed || g_frame >= g_numFrames || MxTimer::IsReplayFinished()) {
+		WriteStats();
+		return SDL_APP_SUCCESS;
+	}
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	if (!g_isle->Tick()) {
+		return SDL_APP_FAILURE;
+	}
+	g_frameTicks.push_back(SDL_GetPerformanceCounter() - start);
+	g_gameTimes.push_back(MxTimer::GetTicks());
+
+	if (MSoundManager() && MSoundManager()->GetMixer()->IsHeadless()) {
+		MSoundManager()->GetMixer()->Pump(MxTimer::GetFrameTime());
+	}
+
+	g_frame++;
+	PushScriptEvents(g_frame);
+	return SDL_APP_CONTINUE;
+}
@@ -0,0 +1,45 @@
+#ifndef ISLEHEADLESS_H
+#define ISLEHEADLESS_H
+
+#include "mxtypes.h"
+
+#include <SDL3/SDL_init.h>
+
+// Runs the game for a fixed number of frames without real-time pacing, for
+// soak runs and performance comparisons on machines without a display or
+// sound card. The software renderer draws into SDL's dummy video driver, and
+// the sound manager runs headless, with the mix pulled once a frame.
+//
+// Time comes from MxTimer's fixed-step clock, or a clock replay if one was
+// given, so every run goes through the same game time. A script can inject
+// input at given frames. At the end, the time each frame took to tickle is
+// logged and optionally written to a CSV file.
+//
+// Script lines are "<frame> key <SDL key name>", "<frame> click <x> <y>" or
+// "<frame> quit", with clicks in 640x480 game coordinates. Lines starting
+// with # are ignored.
+
+// Must be called before SDL_Init, which is passed the returned flags
+extern SDL_InitFlags IsleHeadless_Setup(int argc, char** argv, SDL_InitFlags p_flags);
+
+extern bool IsleHeadless_Enabled();
+
+extern void IsleHeadless_SetFrames(MxU32 p_frames);
+
+extern void IsleHeadless_SetStep(MxU32 p_milliseconds);
+
+extern void IsleHeadless_SetScript(const char* p_path);
+
+extern void IsleHeadless_SetStats(const char* p_path);
+
+// Formats the software renderer's "3D Device ID"
+extern void IsleHeadless_GetDeviceId(char* p_buffer, size_t p_size);
+
+// Must be called before MxOmni is created
+extern void IsleHeadless_SetupClock();
+
+extern bool IsleHeadless_Init();
+
+extern SDL_AppResult IsleHeadless_Iterate();
+
+#endif
@@ -5,12 +5,16 @@
 #include "legopathactor.h"
 
 class LegoAnim;
+class LegoFlatAnim;
 
-// SIZE 0x20
 struct LegoAnimActorStruct {
 	LegoAnimActorStruct(float p_unk0x00, LegoAnim* p_AnimTreePtr, LegoROI** p_roiMap, MxU32 p_numROIs);
 	~LegoAnimActorStruct();
 
+	// Not in the original: copies build a LegoFlatAnim of their own
+	LegoAnimActorStruct(const LegoAnimActorStruct& p_laas);
+	LegoAnimActorStruct& operator=(const LegoAnimActorStruct& p_laas);
+
 	float GetDuration();
 
 	// FUNCTION: BETA10 0x1000fb10
@@ -28,6 +32,9 @@ struct LegoAnimActorStruct {
 	LegoROI** m_roiMap;           // 0x08
 	MxU32 m_numROIs;              // 0x0c
 	vector<undefined*> m_unk0x10; // 0x10
+
+	// Not in the original: m_AnimTreePtr bound to m_roiMap, with key cursors of its own
+	LegoFlatAnim* m_flatAnim;
 };
 
 // VTABLE: LEGO1 0x100d5440 LegoPathActor
@@ -2,6 +2,7 @@
 #define LEGOCACHESOUNDMANAGER_H
 
 #include "decomp.h"
+#include "lego1_export.h"
 #include "legocachsound.h"
 #include "mxstl/stlcompat.h"
 #include "mxtypes.h"
@@ -51,7 +52,15 @@ typedef list<LegoCacheSoundEntry> List100d6b4c;
 // SIZE 0x20
 class LegoCacheSoundManager {
 public:
-	LegoCacheSoundManager() {}
+	struct Stats {
+		MxU32 m_sounds;        // cached sounds
+		MxU32 m_clones;        // clones currently playing
+		MxU32 m_clonesCreated; // since startup
+		MxU32 m_residentBytes; // PCM held, each shared block counted once
+		MxU32 m_sharedBytes;   // PCM clones would have copied
+	};
+
+	LegoCacheSoundManager() : m_clonesCreated(0) {}
 	~LegoCacheSoundManager();
 
 	virtual MxResult Tickle(); // vtable+0x00
@@ -63,9 +72,14 @@ class LegoCacheSoundManager {
 	void Stop(LegoCacheSound*& p_sound);
 	void Destroy(LegoCacheSound*& p_sound);
 
+	LEGO1_EXPORT void GetStats(Stats& p_stats);
+
 private:
 	Set100d6b4c m_set;   // 0x04
 	List100d6b4c m_list; // 0x14
+
+	// Not in the original
+	MxU32 m_clonesCreated;
 };
 
 // TODO: Function names subject to change.
@@ -4,6 +4,7 @@
 #include "decomp.h"
 #include "lego3dsound.h"
 #include "mxcore.h"
+#include "mxsharedbuffer.h"
 #include "mxstring.h"
 #include "mxwavepresenter.h"
 
@@ -41,6 +42,8 @@ class LegoCacheSound : public MxCore {
 
 	const MxString& GetUnknown0x48() const { return m_unk0x48; }
 	const MxBool GetUnknown0x58() const { return m_unk0x58; }
+	const MxSharedBuffer* GetSharedData() const { return m_data; }
+	MxU32 GetDataSize() const { return m_dataSize; }
 
 	LegoCacheSound* Clone();
 	MxResult Play(const char* p_name, MxBool p_looping);
@@ -66,7 +69,7 @@ class LegoCacheSound : public MxCore {
 	MxMiniaudio<ma_sound> m_cacheSound;
 	undefined m_unk0x0c[4];            // 0x0c
 	Lego3DSound m_sound;               // 0x10
-	MxU8* m_data;                      // 0x40
+	MxSharedBuffer* m_data;            // 0x40
 	MxU32 m_dataSize;                  // 0x44
 	MxString m_unk0x48;                // 0x48
 	MxBool m_unk0x58;                  // 0x58
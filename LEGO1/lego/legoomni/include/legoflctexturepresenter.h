@@ -38,6 +38,9 @@ class LegoFlcTexturePresenter : public MxFlcPresenter {
 
 	MxS32 m_rectCount;          // 0x68
 	LegoTextureInfo* m_texture; // 0x6c
+
+	// Not in the original
+	MxRect32 m_dirtyRect; // rows of m_frameBitmap changed since the last PutFrame
 };
 
 #endif // LEGOFLCTEXTUREPRESENTER_H
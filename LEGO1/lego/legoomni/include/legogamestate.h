@@ -10,6 +10,7 @@
 #include <string.h>
 
 class LegoFile;
+class LegoSaveWriter;
 class LegoState;
 class LegoStorage;
 class MxVariableTable;
@@ -256,6 +257,7 @@ class LegoGameState {
 	LegoBackgroundColor* m_backgroundColor;     // 0x18
 	LegoBackgroundColor* m_tempBackgroundColor; // 0x1c
 	LegoFullScreenMovie* m_fullScreenMovie;     // 0x20
+	LegoSaveWriter* m_saveWriter;               // Not in the original
 
 public:
 	MxS16 m_currentPlayerId;              // 0x24
@@ -182,6 +182,12 @@ class LegoOmni : public MxOmni {
 	void SetUserActor(LegoPathActor* p_userActor) { m_userActor = p_userActor; }
 	void SetCurrentWorld(LegoWorld* p_currentWorld) { m_currentWorld = p_currentWorld; }
 
+	// Not in the original: lets the tests save and load a game without creating the video and input managers
+	void SetGameState(LegoGameState* p_gameState) { m_gameState = p_gameState; }
+	void SetCharacterManager(LegoCharacterManager* p_characterManager) { m_characterManager = p_characterManager; }
+	void SetPlantManager(LegoPlantManager* p_plantManager) { m_plantManager = p_plantManager; }
+	void SetBuildingManager(LegoBuildingManager* p_buildingManager) { m_buildingManager = p_buildingManager; }
+
 	// FUNCTION: BETA10 0x100d55c0
 	void SetExit(MxBool p_exit) { m_exit = p_exit; }
 
@@ -45,6 +45,9 @@ class LegoPhonemePresenter : public MxFlcPresenter {
 	MxBool m_unk0x70;               // 0x70
 	MxString m_roiName;             // 0x74
 	MxBool m_unk0x84;               // 0x84
+
+	// Not in the original
+	MxRect32 m_dirtyRect; // rows of m_frameBitmap changed since the last PutFrame
 };
 
 // TEMPLATE: LEGO1 0x1004eb20
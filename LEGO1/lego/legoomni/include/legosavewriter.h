@@ -0,0 +1,49 @@
+#ifndef LEGOSAVEWRITER_H
+#define LEGOSAVEWRITER_H
+
+#include "mxstl/stlcompat.h"
+#include "mxstring.h"
+#include "mxtypes.h"
+
+#include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_thread.h>
+
+class LegoMemory;
+
+// Writes save files on a background thread, so that saving only costs the game
+// thread the time it takes to serialize into memory. Each file is written next
+// to its destination under a temporary name and renamed over it once complete,
+// so an interrupted write never leaves a truncated save behind. A file queued
+// again before the writer got to it is only written once, with the latest image.
+// Without thread support files are written as they are committed.
+class LegoSaveWriter {
+public:
+	LegoSaveWriter();
+	~LegoSaveWriter();
+
+	// Queues p_image to be written to p_path and takes ownership of it
+	void Commit(const char* p_path, LegoMemory* p_image);
+
+	// Returns once every file committed so far has been written or has failed to.
+	// Must be called before reading, moving or deleting any of them.
+	void Flush();
+
+private:
+	struct Job {
+		MxString m_path;
+		LegoMemory* m_image;
+	};
+
+	static MxResult Write(const char* p_path, LegoMemory* p_image);
+	static int SDLCALL ThreadProc(void* p_writer);
+
+	SDL_Thread* m_thread;
+	SDL_Mutex* m_lock;
+	SDL_Condition* m_queued; // a job was queued, or the writer is shutting down
+	SDL_Condition* m_idle;   // the queue drained
+	list<Job> m_jobs;
+	MxBool m_busy; // a job has been taken off the queue and is being written
+	MxBool m_quit;
+};
+
+#endif // LEGOSAVEWRITER_H
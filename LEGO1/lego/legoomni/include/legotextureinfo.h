@@ -1,6 +1,7 @@
 #ifndef LEGOTEXTUREINFO_H
 #define LEGOTEXTUREINFO_H
 
+#include "lego1_export.h"
 #include "misc/legotypes.h"
 #include "tgl/tgl.h"
 
@@ -13,6 +14,7 @@
 #endif
 
 class LegoTexture;
+class MxRect32;
 
 // SIZE 0x10
 class LegoTextureInfo {
@@ -25,12 +27,22 @@ class LegoTextureInfo {
 	static BOOL GetGroupTexture(Tgl::Mesh* pMesh, LegoTextureInfo*& p_textureInfo);
 
 	LegoResult LoadBits(const LegoU8* p_bits);
+	LegoResult LoadBits(const LegoU8* p_bits, const MxRect32& p_rect);
+
+	// Bytes copied into texture surfaces by LoadBits
+	LEGO1_EXPORT static LegoU32 GetBytesLoaded();
+
+	void TrackSurface(LegoU32 p_width, LegoU32 p_height);
 
 	// private:
 	char* m_name;                   // 0x00
 	LPDIRECTDRAWSURFACE m_surface;  // 0x04
 	LPDIRECTDRAWPALETTE m_palette;  // 0x08
 	LPDIRECT3DRMTEXTURE2 m_texture; // 0x0c
+
+	// Not in the original
+	LegoS32 m_cacheSlot;   // in LegoTextureContainer's cache, -1 if not cached there
+	LegoU32 m_surfaceSize; // under MxMemoryStats::e_textures once the texture is complete
 };
 
 // GLOBAL: LEGO1 0x100db6f0
@@ -4,8 +4,7 @@
 #include "lego1_export.h"
 #include "legoentitypresenter.h"
 
-#include <SDL3/SDL_iostream.h>
-
+class LegoStorage;
 class LegoWorld;
 struct ModelDbPart;
 struct ModelDbModel;
@@ -51,8 +50,8 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 	// LegoWorldPresenter::`scalar deleting destructor'
 
 private:
-	MxResult LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_wdbFile);
-	MxResult LoadWorldModel(ModelDbModel& p_model, SDL_IOStream* p_wdbFile, LegoWorld* p_world);
+	MxResult LoadWorldPart(ModelDbPart& p_part, LegoStorage* p_wdbFile);
+	MxResult LoadWorldModel(ModelDbModel& p_model, LegoStorage* p_wdbFile, LegoWorld* p_world);
 
 	MxU32 m_nextObjectId;
 };
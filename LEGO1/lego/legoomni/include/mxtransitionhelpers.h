@@ -0,0 +1,127 @@
+#ifndef MXTRANSITIONHELPERS_H
+#define MXTRANSITIONHELPERS_H
+
+#include "mxtypes.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <string.h>
+#ifdef MINIWIN
+#include "miniwin/ddraw.h"
+#else
+#include <ddraw.h>
+#endif
+
+// Not in the original. The column order and pixel loops of the dissolve and
+// mosaic transitions, apart from MxTransitionManager so that tests can compare
+// them with the original loops. Every file including them gets its own copy.
+
+// Shuffles the first p_count columns, then stores them in the order they are
+// hit: p_columnOrder[i] is the column hit i-th, so that each tick's columns
+// are a contiguous slice.
+static inline void ShuffleColumns(MxU16* p_columnOrder, MxS32 p_count)
+{
+	MxU16 order[640];
+	MxS32 i;
+
+	for (i = 0; i < p_count; i++) {
+		order[i] = i;
+	}
+
+	for (i = 0; i < p_count; i++) {
+		MxS32 swap = SDL_rand(p_count);
+		MxU16 t = order[i];
+		order[i] = order[swap];
+		order[swap] = t;
+	}
+
+	for (i = 0; i < p_count; i++) {
+		p_columnOrder[order[i]] = i;
+	}
+}
+
+// Gets the p_count columns hit on p_tick in ascending order
+static inline void GetTickColumns(const MxU16* p_columnOrder, MxS32 p_tick, MxS32 p_count, MxU16* p_columns)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		MxU16 column = p_columnOrder[p_tick * p_count + i];
+		MxS32 j = i;
+
+		while (j > 0 && p_columns[j - 1] > column) {
+			p_columns[j] = p_columns[j - 1];
+			j--;
+		}
+
+		p_columns[j] = column;
+	}
+}
+
+template <class T>
+static inline void FillSpan(T* p_dest, MxS32 p_length, T p_value)
+{
+	for (MxS32 i = 0; i < p_length; i++) {
+		p_dest[i] = p_value;
+	}
+}
+
+template <>
+inline void FillSpan<MxU8>(MxU8* p_dest, MxS32 p_length, MxU8 p_value)
+{
+	memset(p_dest, p_value, p_length);
+}
+
+// Sets the given columns, shifted by each row's offset, to p_black on every row.
+// Adjacent columns are filled as one span, split where it wraps around the screen.
+template <class T>
+static void DissolveRows(LPDDSURFACEDESC p_ddsd, const MxU16* p_shift, const MxU16* p_columns, MxS32 p_count, T p_black)
+{
+	MxS32 runStart[16];
+	MxS32 runLength[16];
+	MxS32 numRuns = 0;
+
+	for (MxS32 i = 0; i < p_count; i++) {
+		if (numRuns && runStart[numRuns - 1] + runLength[numRuns - 1] == p_columns[i]) {
+			runLength[numRuns - 1]++;
+		}
+		else {
+			runStart[numRuns] = p_columns[i];
+			runLength[numRuns] = 1;
+			numRuns++;
+		}
+	}
+
+	for (MxS32 row = 0; row < 480; row++) {
+		T* line = (T*) ((MxU8*) p_ddsd->lpSurface + p_ddsd->lPitch * row);
+
+		for (MxS32 i = 0; i < numRuns; i++) {
+			MxS32 x = (p_shift[row] + runStart[i]) % 640;
+			MxS32 length = runLength[i];
+
+			if (x + length > 640) {
+				FillSpan(line, x + length - 640, p_black);
+				length = 640 - x;
+			}
+
+			FillSpan(line + x, length, p_black);
+		}
+	}
+}
+
+// Fills each chosen 10x10 block with the color of its top left pixel
+template <class T>
+static void MosaicBlocks(LPDDSURFACEDESC p_ddsd, const MxU16* p_shift, const MxU16* p_columns, MxS32 p_count)
+{
+	for (MxS32 row = 0; row < 48; row++) {
+		MxU8* block = (MxU8*) p_ddsd->lpSurface + 10 * row * p_ddsd->lPitch;
+
+		for (MxS32 i = 0; i < p_count; i++) {
+			MxS32 xShift = 10 * ((p_shift[row] + p_columns[i]) % 64);
+			T sample = ((T*) block)[xShift];
+
+			for (MxS32 k = 0; k < 10; k++) {
+				FillSpan((T*) (block + k * p_ddsd->lPitch) + xShift, 10, sample);
+			}
+		}
+	}
+}
+
+#endif // MXTRANSITIONHELPERS_H
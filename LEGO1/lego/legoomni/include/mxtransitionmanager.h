@@ -71,6 +71,8 @@ class MxTransitionManager : public MxCore {
 	void BrokenTransition();
 	void FakeMosaicTransition();
 
+	void PresentRect(RECT& p_rect);
+
 	void SubmitCopyRect(LPDDSURFACEDESC p_ddsc);
 	void SetupCopyRect(LPDDSURFACEDESC p_ddsc);
 
@@ -86,7 +88,7 @@ class MxTransitionManager : public MxCore {
 
 	LPDIRECTDRAWSURFACE m_ddSurface; // 0x30
 	MxU16 m_animationTimer;          // 0x34
-	MxU16 m_columnOrder[640];        // 0x36
+	MxU16 m_columnOrder[640];        // 0x36 columns in the order they are hit
 	MxU16 m_randomShift[480];        // 0x536
 	Uint64 m_systemTime;             // 0x8f8
 	MxS32 m_animationSpeed;          // 0x8fc
@@ -9,8 +9,6 @@
 
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(Lego3DSound, 0x30)
-
 // FUNCTION: LEGO1 0x10011630
 Lego3DSound::Lego3DSound()
 {
@@ -33,6 +31,7 @@ void Lego3DSound::Init()
 	m_enabled = FALSE;
 	m_isActor = FALSE;
 	m_volume = 79;
+	m_lastPositionValid = FALSE;
 }
 
 // FUNCTION: LEGO1 0x100116a0
@@ -44,10 +43,11 @@ MxResult Lego3DSound::Create(ma_sound* p_sound, const char* p_name, MxS32 p_volu
 	if (MxOmni::IsSound3D()) {
 		m_sound = p_sound;
 
-		ma_sound_set_min_distance(m_sound, 15.0f);
-		ma_sound_set_max_distance(m_sound, 100.0f);
-		ma_sound_set_position(m_sound, 0.0f, 0.0f, 40.0f);
-		ma_sound_set_rolloff(m_sound, 10.0f);
+		SoundManager()->GetMixer()->SetMinDistance(m_sound, 15.0f);
+		SoundManager()->GetMixer()->SetMaxDistance(m_sound, 100.0f);
+		SoundManager()->GetMixer()->SetPosition(m_sound, 0.0f, 0.0f, 40.0f);
+		SoundManager()->GetMixer()->SetRolloff(m_sound, 10.0f);
+		m_lastPositionValid = FALSE;
 	}
 
 	if (m_sound == NULL || p_name == NULL) {
@@ -82,8 +82,7 @@ MxResult Lego3DSound::Create(ma_sound* p_sound, const char* p_name, MxS32 p_volu
 	}
 
 	if (MxOmni::IsSound3D()) {
-		const float* position = m_positionROI->GetWorldPosition();
-		ma_sound_set_position(m_sound, position[0], position[1], -position[2]);
+		PushPosition(m_positionROI->GetWorldPosition());
 	}
 
 	LegoEntity* entity = m_roi->GetEntity();
@@ -95,7 +94,7 @@ MxResult Lego3DSound::Create(ma_sound* p_sound, const char* p_name, MxS32 p_volu
 		m_frequencyFactor = m_actor->GetSoundFrequencyFactor();
 
 		if (m_frequencyFactor != 0.0) {
-			ma_sound_set_pitch(p_sound, m_frequencyFactor);
+			SoundManager()->GetMixer()->SetPitch(p_sound, m_frequencyFactor);
 		}
 	}
 
@@ -139,7 +138,7 @@ MxU32 Lego3DSound::UpdatePosition(ma_sound* p_sound)
 		}
 
 		if (m_sound != NULL) {
-			ma_sound_set_position(m_sound, position[0], position[1], -position[2]);
+			PushPosition(position);
 		}
 		else {
 			MxS32 newVolume = m_volume;
@@ -157,7 +156,7 @@ MxU32 Lego3DSound::UpdatePosition(ma_sound* p_sound)
 			}
 
 			newVolume = newVolume * SoundManager()->GetVolume() / 100;
-			ma_sound_set_volume(p_sound, SoundManager()->GetAttenuation(newVolume));
+			SoundManager()->GetMixer()->SetVolume(p_sound, SoundManager()->GetAttenuation(newVolume));
 		}
 
 		updated = TRUE;
@@ -166,7 +165,7 @@ MxU32 Lego3DSound::UpdatePosition(ma_sound* p_sound)
 	if (m_actor != NULL) {
 		if (abs(m_frequencyFactor - m_actor->GetSoundFrequencyFactor()) > 0.0001) {
 			m_frequencyFactor = m_actor->GetSoundFrequencyFactor();
-			ma_sound_set_pitch(p_sound, m_frequencyFactor);
+			SoundManager()->GetMixer()->SetPitch(p_sound, m_frequencyFactor);
 			updated = TRUE;
 		}
 	}
@@ -182,7 +181,7 @@ void Lego3DSound::FUN_10011a60(ma_sound* p_sound, const char* p_name)
 
 	if (p_name == NULL) {
 		if (m_sound != NULL) {
-			ma_sound_set_spatialization_enabled(m_sound, MA_FALSE);
+			SoundManager()->GetMixer()->SetSpatializationEnabled(m_sound, MA_FALSE);
 		}
 	}
 	else {
@@ -214,9 +213,8 @@ void Lego3DSound::FUN_10011a60(ma_sound* p_sound, const char* p_name)
 		}
 
 		if (m_sound != NULL) {
-			ma_sound_set_spatialization_enabled(m_sound, MA_TRUE);
-			const float* position = m_positionROI->GetWorldPosition();
-			ma_sound_set_position(m_sound, position[0], position[1], -position[2]);
+			SoundManager()->GetMixer()->SetSpatializationEnabled(m_sound, MA_TRUE);
+			PushPosition(m_positionROI->GetWorldPosition());
 		}
 		else {
 			const float* position = m_positionROI->GetWorldPosition();
@@ -241,7 +239,7 @@ void Lego3DSound::FUN_10011a60(ma_sound* p_sound, const char* p_name)
 				}
 
 				newVolume = newVolume * SoundManager()->GetVolume() / 100;
-				ma_sound_set_volume(p_sound, SoundManager()->GetAttenuation(newVolume));
+				SoundManager()->GetMixer()->SetVolume(p_sound, SoundManager()->GetAttenuation(newVolume));
 			}
 		}
 
@@ -254,7 +252,7 @@ void Lego3DSound::FUN_10011a60(ma_sound* p_sound, const char* p_name)
 			m_frequencyFactor = m_actor->GetSoundFrequencyFactor();
 
 			if (m_frequencyFactor != 0.0) {
-				ma_sound_set_pitch(p_sound, m_frequencyFactor);
+				SoundManager()->GetMixer()->SetPitch(p_sound, m_frequencyFactor);
 			}
 		}
 	}
@@ -286,10 +284,27 @@ MxS32 Lego3DSound::SetDistance(MxS32 p_min, MxS32 p_max)
 			return -1;
 		}
 
-		ma_sound_set_min_distance(m_sound, p_min);
-		ma_sound_set_max_distance(m_sound, p_max);
+		SoundManager()->GetMixer()->SetMinDistance(m_sound, p_min);
+		SoundManager()->GetMixer()->SetMaxDistance(m_sound, p_max);
 		return 0;
 	}
 
 	return 1;
 }
+
+// Most emitters are parked props and idle actors, so most updates would send the position the sound already has
+void Lego3DSound::PushPosition(const float* p_position)
+{
+	if (m_lastPositionValid && m_lastPosition[0] == p_position[0] && m_lastPosition[1] == p_position[1] &&
+		m_lastPosition[2] == p_position[2]) {
+		return;
+	}
+
+	m_lastPosition[0] = p_position[0];
+	m_lastPosition[1] = p_position[1];
+	m_lastPosition[2] = p_position[2];
+	m_lastPositionValid = TRUE;
+
+	// [library:audio] miniaudio's Z-axis points the other way, see LegoSoundManager::UpdateListener
+	SoundManager()->GetMixer()->SetPosition(m_sound, p_position[0], p_position[1], -p_position[2]);
+}
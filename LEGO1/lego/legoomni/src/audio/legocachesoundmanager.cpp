@@ -3,8 +3,9 @@
 #include "legoworld.h"
 #include "misc.h"
 
+#include <algorithm>
+
 DECOMP_SIZE_ASSERT(LegoCacheSoundEntry, 0x08)
-DECOMP_SIZE_ASSERT(LegoCacheSoundManager, 0x20)
 
 // FUNCTION: LEGO1 0x1003cf20
 LegoCacheSoundManager::~LegoCacheSoundManager()
@@ -122,6 +123,7 @@ LegoCacheSound* LegoCacheSoundManager::Play(LegoCacheSound* p_sound, const char*
 		LegoCacheSound* clone = p_sound->Clone();
 
 		if (clone) {
+			m_clonesCreated++;
 			LegoCacheSound* sound = ManageSoundEntry(clone);
 			sound->Play(p_name, p_looping);
 			return sound;
@@ -207,3 +209,43 @@ void LegoCacheSoundManager::Destroy(LegoCacheSound*& p_sound)
 		}
 	}
 }
+
+static void CountSoundData(
+	LegoCacheSound* p_sound,
+	vector<const MxSharedBuffer*>& p_seen,
+	LegoCacheSoundManager::Stats& p_stats
+)
+{
+	const MxSharedBuffer* data = p_sound->GetSharedData();
+
+	if (data == NULL) {
+		return;
+	}
+
+	if (std::find(p_seen.begin(), p_seen.end(), data) != p_seen.end()) {
+		p_stats.m_sharedBytes += p_sound->GetDataSize();
+	}
+	else {
+		p_seen.push_back(data);
+		p_stats.m_residentBytes += p_sound->GetDataSize();
+	}
+}
+
+void LegoCacheSoundManager::GetStats(Stats& p_stats)
+{
+	p_stats.m_sounds = m_set.size();
+	p_stats.m_clones = m_list.size();
+	p_stats.m_clonesCreated = m_clonesCreated;
+	p_stats.m_residentBytes = 0;
+	p_stats.m_sharedBytes = 0;
+
+	vector<const MxSharedBuffer*> seen;
+
+	for (Set100d6b4c::iterator setIter = m_set.begin(); setIter != m_set.end(); setIter++) {
+		CountSoundData((*setIter).GetSound(), seen, p_stats);
+	}
+
+	for (List100d6b4c::iterator listIter = m_list.begin(); listIter != m_list.end(); listIter++) {
+		CountSoundData((*listIter).GetSound(), seen, p_stats);
+	}
+}
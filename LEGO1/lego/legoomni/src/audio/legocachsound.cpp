@@ -6,8 +6,6 @@
 
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(LegoCacheSound, 0x88)
-
 // FUNCTION: LEGO1 0x100064d0
 // FUNCTION: BETA10 0x10066340
 LegoCacheSound::LegoCacheSound()
@@ -60,7 +58,7 @@ MxResult LegoCacheSound::Create(
 	ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(format, p_pwfx.m_channels);
 	ma_uint32 bufferSizeInFrames = p_dataSize / bytesPerFrame;
 	ma_audio_buffer_config config =
-		ma_audio_buffer_config_init(format, p_pwfx.m_channels, bufferSizeInFrames, m_data, NULL);
+		ma_audio_buffer_config_init(format, p_pwfx.m_channels, bufferSizeInFrames, m_data->GetData(), NULL);
 	config.sampleRate = p_pwfx.m_samplesPerSec;
 
 	if (m_buffer.Init(ma_audio_buffer_init, &config) != MA_SUCCESS) {
@@ -80,7 +78,7 @@ MxResult LegoCacheSound::Create(
 	m_volume = p_volume;
 
 	MxS32 volume = m_volume * SoundManager()->GetVolume() / 100;
-	ma_sound_set_volume(m_cacheSound, SoundManager()->GetAttenuation(volume));
+	SoundManager()->GetMixer()->SetVolume(m_cacheSound, SoundManager()->GetAttenuation(volume));
 
 	if (m_sound.Create(m_cacheSound, NULL, m_volume) != SUCCESS) {
 		return FAILURE;
@@ -98,20 +96,35 @@ void LegoCacheSound::CopyData(MxU8* p_data, MxU32 p_dataSize)
 	assert(p_data);
 	assert(p_dataSize);
 
-	delete[] m_data;
+	// A clone already shares the data of the sound it was made from, see Clone
+	if (m_data != NULL && m_data->GetData() == p_data && m_dataSize == p_dataSize) {
+		return;
+	}
+
+	if (m_data != NULL) {
+		m_data->Release();
+	}
+
 	m_dataSize = p_dataSize;
-	m_data = new MxU8[m_dataSize];
-	memcpy(m_data, p_data, m_dataSize);
+	m_data = new MxSharedBuffer(m_dataSize, MxMemoryStats::e_sounds);
+	memcpy(m_data->GetData(), p_data, m_dataSize);
 }
 
 // FUNCTION: LEGO1 0x10006920
 // FUNCTION: BETA10 0x1006685b
 void LegoCacheSound::Destroy()
 {
+	if (m_cacheSound && SoundManager()) {
+		SoundManager()->GetMixer()->Flush(m_cacheSound);
+	}
+
 	m_cacheSound.Destroy(ma_sound_uninit);
 	m_buffer.Destroy(ma_audio_buffer_uninit);
 
-	delete[] m_data;
+	if (m_data != NULL) {
+		m_data->Release();
+	}
+
 	Init();
 }
 
@@ -121,8 +134,14 @@ LegoCacheSound* LegoCacheSound::Clone()
 {
 	LegoCacheSound* pnew = new LegoCacheSound();
 	assert(pnew);
+	assert(m_data);
+
+	// The PCM is never written after Create, so all clones play from the same block
+	m_data->AddRef();
+	pnew->m_data = m_data;
+	pnew->m_dataSize = m_dataSize;
 
-	MxResult result = pnew->Create(m_wfx, m_unk0x48, m_volume, m_data, m_dataSize);
+	MxResult result = pnew->Create(m_wfx, m_unk0x48, m_volume, m_data->GetData(), m_dataSize);
 	if (result == SUCCESS) {
 		return pnew;
 	}
@@ -147,13 +166,13 @@ MxResult LegoCacheSound::Play(const char* p_name, MxBool p_looping)
 		m_unk0x74 = p_name;
 	}
 
-	if (ma_sound_seek_to_pcm_frame(m_cacheSound, 0) != MA_SUCCESS) {
+	if (SoundManager()->GetMixer()->SeekToPCMFrame(m_cacheSound, 0) != MA_SUCCESS) {
 		return FAILURE;
 	}
 
-	ma_sound_set_looping(m_cacheSound, p_looping);
+	SoundManager()->GetMixer()->SetLooping(m_cacheSound, p_looping);
 
-	if (ma_sound_start(m_cacheSound) != MA_SUCCESS) {
+	if (SoundManager()->GetMixer()->Start(m_cacheSound) != MA_SUCCESS) {
 		return FAILURE;
 	}
 
@@ -173,7 +192,7 @@ MxResult LegoCacheSound::Play(const char* p_name, MxBool p_looping)
 // FUNCTION: BETA10 0x10066ca3
 void LegoCacheSound::Stop()
 {
-	ma_sound_stop(m_cacheSound);
+	SoundManager()->GetMixer()->Stop(m_cacheSound);
 
 	m_unk0x58 = FALSE;
 	m_unk0x6a = FALSE;
@@ -190,15 +209,15 @@ void LegoCacheSound::FUN_10006be0()
 {
 	if (!m_looping) {
 		if (m_unk0x70) {
-			if (!ma_sound_is_playing(m_cacheSound)) {
+			if (!SoundManager()->GetMixer()->IsPlaying(m_cacheSound)) {
 				return;
 			}
 
 			m_unk0x70 = FALSE;
 		}
 
-		if (!ma_sound_is_playing(m_cacheSound)) {
-			ma_sound_stop(m_cacheSound);
+		if (!SoundManager()->GetMixer()->IsPlaying(m_cacheSound)) {
+			SoundManager()->GetMixer()->Stop(m_cacheSound);
 			m_sound.Reset();
 			if (m_unk0x74.GetLength() != 0) {
 				m_unk0x74 = "";
@@ -216,12 +235,12 @@ void LegoCacheSound::FUN_10006be0()
 	if (!m_muted) {
 		if (!m_sound.UpdatePosition(m_cacheSound)) {
 			if (!m_unk0x6a) {
-				ma_sound_stop(m_cacheSound);
+				SoundManager()->GetMixer()->Stop(m_cacheSound);
 				m_unk0x6a = TRUE;
 			}
 		}
 		else if (m_unk0x6a) {
-			ma_sound_start(m_cacheSound);
+			SoundManager()->GetMixer()->Start(m_cacheSound);
 			m_unk0x6a = FALSE;
 		}
 	}
@@ -247,11 +266,11 @@ void LegoCacheSound::MuteSilence(MxBool p_muted)
 		m_muted = p_muted;
 
 		if (m_muted) {
-			ma_sound_set_volume(m_cacheSound, ma_volume_db_to_linear(-3000.0f / 100.0f));
+			SoundManager()->GetMixer()->SetVolume(m_cacheSound, ma_volume_db_to_linear(-3000.0f / 100.0f));
 		}
 		else {
 			MxS32 volume = m_volume * SoundManager()->GetVolume() / 100;
-			ma_sound_set_volume(m_cacheSound, SoundManager()->GetAttenuation(volume));
+			SoundManager()->GetMixer()->SetVolume(m_cacheSound, SoundManager()->GetAttenuation(volume));
 		}
 	}
 }
@@ -264,10 +283,10 @@ void LegoCacheSound::MuteStop(MxBool p_muted)
 		m_muted = p_muted;
 
 		if (m_muted) {
-			ma_sound_stop(m_cacheSound);
+			SoundManager()->GetMixer()->Stop(m_cacheSound);
 		}
 		else {
-			ma_sound_start(m_cacheSound);
+			SoundManager()->GetMixer()->Start(m_cacheSound);
 		}
 	}
 }
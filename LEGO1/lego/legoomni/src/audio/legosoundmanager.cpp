@@ -6,8 +6,6 @@
 
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(LegoSoundManager, 0x44)
-
 // FUNCTION: LEGO1 0x100298a0
 LegoSoundManager::LegoSoundManager()
 {
@@ -75,10 +73,14 @@ void LegoSoundManager::Destroy()
 // FUNCTION: BETA10 0x100d030d
 MxResult LegoSoundManager::Tickle()
 {
+	// Position, volume and pitch updates of all 3D sounds this tick reach the mixer as one batch
+	m_mixer.BeginBatch();
 	MxSoundManager::Tickle();
 
 	AUTOLOCK(m_criticalSection);
-	return m_cacheSoundManager->Tickle();
+	MxResult result = m_cacheSoundManager->Tickle();
+	m_mixer.EndBatch();
+	return result;
 }
 
 // FUNCTION: LEGO1 0x1002a410
@@ -96,16 +98,16 @@ void LegoSoundManager::UpdateListener(
 		// uses DirectX' left-handed system. The Z-axis needs to be inverted.
 
 		if (p_position != NULL) {
-			ma_engine_listener_set_position(m_engine, 0, p_position[0], p_position[1], -p_position[2]);
+			m_mixer.SetListenerPosition(p_position[0], p_position[1], -p_position[2]);
 		}
 
 		if (p_direction != NULL && p_up != NULL) {
-			ma_engine_listener_set_direction(m_engine, 0, p_direction[0], p_direction[1], -p_direction[2]);
-			ma_engine_listener_set_world_up(m_engine, 0, p_up[0], p_up[1], -p_up[2]);
+			m_mixer.SetListenerDirection(p_direction[0], p_direction[1], -p_direction[2]);
+			m_mixer.SetListenerWorldUp(p_up[0], p_up[1], -p_up[2]);
 		}
 
 		if (p_velocity != NULL) {
-			ma_engine_listener_set_velocity(m_engine, 0, p_velocity[0], p_velocity[1], -p_velocity[2]);
+			m_mixer.SetListenerVelocity(p_velocity[0], p_velocity[1], -p_velocity[2]);
 		}
 	}
 }
@@ -24,6 +24,7 @@
 #include "mxsoundpresenter.h"
 #include "mxstillpresenter.h"
 #include "mxticklemanager.h"
+#include "mxtimer.h"
 #include "mxtransitionmanager.h"
 #include "mxvariabletable.h"
 #include "racecar.h"
@@ -31,7 +32,6 @@
 #include "scripts.h"
 
 #include <SDL3/SDL_stdinc.h>
-#include <SDL3/SDL_timer.h>
 #include <isle.h>
 #include <stdio.h>
 #include <vec.h>
@@ -556,7 +556,7 @@ MxResult LegoCarBuild::Tickle()
 	}
 
 	if (m_unk0x10a) {
-		Uint64 time = SDL_GetTicks();
+		Uint64 time = MxTimer::GetTicks();
 		Uint64 dTime = (time - m_unk0x10c) / 100;
 
 		if (m_carId == RaceCar_Actor) {
@@ -1601,7 +1601,7 @@ void LegoCarBuild::FUN_10025720(undefined4 p_param)
 #endif
 
 	if (m_unk0x10a != 0) {
-		m_unk0x10c = SDL_GetTicks();
+		m_unk0x10c = MxTimer::GetTicks();
 	}
 }
 
@@ -36,6 +36,7 @@
 #include "legomain.h"
 #include "legonavcontroller.h"
 #include "legoplantmanager.h"
+#include "legosavewriter.h"
 #include "legostate.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
@@ -67,7 +68,6 @@
 DECOMP_SIZE_ASSERT(LegoGameState::Username, 0x0e)
 DECOMP_SIZE_ASSERT(LegoGameState::ScoreItem, 0x2c)
 DECOMP_SIZE_ASSERT(LegoGameState::History, 0x374)
-DECOMP_SIZE_ASSERT(LegoGameState, 0x430)
 DECOMP_SIZE_ASSERT(ColorStringStruct, 0x08)
 DECOMP_SIZE_ASSERT(LegoBackgroundColor, 0x30)
 DECOMP_SIZE_ASSERT(LegoFullScreenMovie, 0x24)
@@ -183,6 +183,7 @@ LegoGameState::LegoGameState()
 	VariableTable()->SetVariable(m_fullScreenMovie);
 
 	VariableTable()->SetVariable("lightposition", "2");
+	m_saveWriter = new LegoSaveWriter;
 	SerializeScoreHistory(LegoFile::c_read);
 }
 
@@ -202,6 +203,8 @@ LegoGameState::~LegoGameState()
 		delete[] m_stateArray;
 	}
 
+	// Waits for any save still being written
+	delete m_saveWriter;
 	delete[] m_savePath;
 }
 
@@ -275,7 +278,7 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	}
 
 	MxResult result = FAILURE;
-	LegoFile storage;
+	LegoMemory* storage = new LegoMemory;
 	MxVariableTable* variableTable = VariableTable();
 	MxS16 count = 0;
 	MxU32 i;
@@ -285,32 +288,28 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
 
-	if (storage.Open(savePath.GetData(), LegoFile::c_write) == FAILURE) {
-		goto done;
-	}
-
-	storage.WriteS32(0x1000c);
-	storage.WriteS16(m_currentPlayerId);
-	storage.WriteU16(m_currentAct);
-	storage.WriteU8(m_actorId);
+	storage->WriteS32(0x1000c);
+	storage->WriteS16(m_currentPlayerId);
+	storage->WriteU16(m_currentAct);
+	storage->WriteU8(m_actorId);
 
 	for (i = 0; i < sizeOfArray(g_colorSaveData); i++) {
-		if (WriteVariable(&storage, variableTable, g_colorSaveData[i].m_targetName) == FAILURE) {
+		if (WriteVariable(storage, variableTable, g_colorSaveData[i].m_targetName) == FAILURE) {
 			goto done;
 		}
 	}
 
-	if (WriteVariable(&storage, variableTable, "backgroundcolor") == FAILURE) {
+	if (WriteVariable(storage, variableTable, "backgroundcolor") == FAILURE) {
 		goto done;
 	}
-	if (WriteVariable(&storage, variableTable, "lightposition") == FAILURE) {
+	if (WriteVariable(storage, variableTable, "lightposition") == FAILURE) {
 		goto done;
 	}
 
-	WriteEndOfVariables(&storage);
-	CharacterManager()->Write(&storage);
-	PlantManager()->Write(&storage);
-	result = BuildingManager()->Write(&storage);
+	WriteEndOfVariables(storage);
+	CharacterManager()->Write(storage);
+	PlantManager()->Write(storage);
+	result = BuildingManager()->Write(storage);
 
 	for (j = 0; j < m_stateCount; j++) {
 		if (m_stateArray[j]->IsSerializable()) {
@@ -318,20 +317,26 @@ MxResult LegoGameState::Save(MxULong p_slot)
 		}
 	}
 
-	storage.WriteS16(count);
+	storage->WriteS16(count);
 
 	for (j = 0; j < m_stateCount; j++) {
 		if (m_stateArray[j]->IsSerializable()) {
-			m_stateArray[j]->Serialize(&storage);
+			m_stateArray[j]->Serialize(storage);
 		}
 	}
 
 	area = m_unk0x42c;
-	storage.WriteU16(area);
+	storage->WriteU16(area);
+
+	// The file is only replaced once the complete image is written out
+	m_saveWriter->Commit(savePath.GetData(), storage);
+	storage = NULL;
+
 	SerializeScoreHistory(LegoFile::c_write);
 	m_isDirty = FALSE;
 
 done:
+	delete storage;
 	return result;
 }
 
@@ -368,6 +373,7 @@ MxResult LegoGameState::Load(MxULong p_slot)
 
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
+	m_saveWriter->Flush();
 
 	if (storage.Open(savePath.GetData(), LegoFile::c_read) == FAILURE) {
 		goto done;
@@ -402,11 +408,14 @@ MxResult LegoGameState::Load(MxULong p_slot)
 		}
 	} while (status != 2);
 
-	m_backgroundColor->SetLightColor();
-	lightPosition = VariableTable()->GetVariable("lightposition");
+	// Not in the original: without a video manager there is no light to set, as in LegoBackgroundColor::SetValue
+	if (VideoManager()) {
+		m_backgroundColor->SetLightColor();
+		lightPosition = VariableTable()->GetVariable("lightposition");
 
-	if (lightPosition) {
-		SetLightPosition(atoi(lightPosition));
+		if (lightPosition) {
+			SetLightPosition(atoi(lightPosition));
+		}
 	}
 
 	if (CharacterManager()->Read(&storage) == FAILURE) {
@@ -596,6 +605,20 @@ void LegoGameState::SerializePlayersInfo(MxS16 p_flags)
 	playersGSI += "\\";
 	playersGSI += g_playersGSI;
 
+	if (p_flags == LegoFile::c_write) {
+		LegoMemory* image = new LegoMemory;
+		image->WriteS16(m_playerCount);
+
+		for (MxS16 i = 0; i < m_playerCount; i++) {
+			m_players[i].Serialize(image);
+		}
+
+		m_saveWriter->Commit(playersGSI.GetData(), image);
+		return;
+	}
+
+	m_saveWriter->Flush();
+
 	if (storage.Open(playersGSI.GetData(), p_flags) == SUCCESS) {
 		if (storage.IsReadMode()) {
 			storage.ReadS16(m_playerCount);
@@ -615,6 +638,8 @@ MxResult LegoGameState::AddPlayer(Username& p_player)
 {
 	MxString from, to;
 
+	m_saveWriter->Flush();
+
 	if (m_playerCount == 9) {
 		GetFileSavePath(&from, 8);
 		SDL_RemovePath(from.GetData());
@@ -645,6 +670,8 @@ void LegoGameState::SwitchPlayer(MxS16 p_playerId)
 	if (p_playerId > 0) {
 		MxString from, temp, to;
 
+		m_saveWriter->Flush();
+
 		GetFileSavePath(&from, p_playerId);
 		GetFileSavePath(&temp, 36);
 
@@ -1636,8 +1663,15 @@ void LegoGameState::SerializeScoreHistory(MxS16 p_flags)
 
 	if (p_flags == LegoFile::c_write) {
 		m_history.WriteScoreHistory();
+
+		LegoMemory* image = new LegoMemory;
+		m_history.Serialize(image);
+		m_saveWriter->Commit(savePath.GetData(), image);
+		return;
 	}
 
+	m_saveWriter->Flush();
+
 	if (storage.Open(savePath.GetData(), p_flags) == SUCCESS) {
 		m_history.Serialize(&storage);
 	}
@@ -0,0 +1,144 @@
+#include "legosavewriter.h"
+
+#include "misc/legostorage.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
+
+LegoSaveWriter::LegoSaveWriter()
+{
+	m_lock = SDL_CreateMutex();
+	m_queued = SDL_CreateCondition();
+	m_idle = SDL_CreateCondition();
+	m_busy = FALSE;
+	m_quit = FALSE;
+	m_thread = NULL;
+
+	if (m_lock && m_queued && m_idle) {
+		m_thread = SDL_CreateThread(&ThreadProc, "LegoSaveWriter", this);
+	}
+}
+
+LegoSaveWriter::~LegoSaveWriter()
+{
+	if (m_thread) {
+		// The thread drains the queue before it exits
+		SDL_LockMutex(m_lock);
+		m_quit = TRUE;
+		SDL_SignalCondition(m_queued);
+		SDL_UnlockMutex(m_lock);
+
+		SDL_WaitThread(m_thread, NULL);
+	}
+
+	SDL_DestroyCondition(m_idle);
+	SDL_DestroyCondition(m_queued);
+	SDL_DestroyMutex(m_lock);
+}
+
+void LegoSaveWriter::Commit(const char* p_path, LegoMemory* p_image)
+{
+	MxString path(p_path);
+	path.MapPathToFilesystem();
+
+	if (!m_thread) {
+		Write(path.GetData(), p_image);
+		delete p_image;
+		return;
+	}
+
+	SDL_LockMutex(m_lock);
+
+	for (list<Job>::iterator it = m_jobs.begin(); it != m_jobs.end(); it++) {
+		if (it->m_path.Equal(path)) {
+			delete it->m_image;
+			it->m_image = p_image;
+			SDL_UnlockMutex(m_lock);
+			return;
+		}
+	}
+
+	Job job;
+	job.m_path = path;
+	job.m_image = p_image;
+	m_jobs.push_back(job);
+
+	SDL_SignalCondition(m_queued);
+	SDL_UnlockMutex(m_lock);
+}
+
+void LegoSaveWriter::Flush()
+{
+	if (!m_thread) {
+		return;
+	}
+
+	SDL_LockMutex(m_lock);
+
+	while (!m_jobs.empty() || m_busy) {
+		SDL_WaitCondition(m_idle, m_lock);
+	}
+
+	SDL_UnlockMutex(m_lock);
+}
+
+MxResult LegoSaveWriter::Write(const char* p_path, LegoMemory* p_image)
+{
+	MxString temp(p_path);
+	temp += ".tmp";
+
+	SDL_IOStream* file = SDL_IOFromFile(temp.GetData(), "wb");
+	if (!file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not create %s: %s", temp.GetData(), SDL_GetError());
+		return FAILURE;
+	}
+
+	MxBool written = SDL_WriteIO(file, p_image->GetBuffer(), p_image->GetSize()) == p_image->GetSize();
+
+	if (!SDL_CloseIO(file)) {
+		written = FALSE;
+	}
+
+	// Replaces the previous save only once the new one is complete
+	if (!written || !SDL_RenamePath(temp.GetData(), p_path)) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write %s: %s", p_path, SDL_GetError());
+		SDL_RemovePath(temp.GetData());
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+int SDLCALL LegoSaveWriter::ThreadProc(void* p_writer)
+{
+	LegoSaveWriter* writer = (LegoSaveWriter*) p_writer;
+
+	SDL_LockMutex(writer->m_lock);
+
+	for (;;) {
+		if (writer->m_jobs.empty()) {
+			writer->m_busy = FALSE;
+			SDL_BroadcastCondition(writer->m_idle);
+
+			if (writer->m_quit) {
+				break;
+			}
+
+			SDL_WaitCondition(writer->m_queued, writer->m_lock);
+			continue;
+		}
+
+		Job job = writer->m_jobs.front();
+		writer->m_jobs.pop_front();
+		writer->m_busy = TRUE;
+
+		SDL_UnlockMutex(writer->m_lock);
+		Write(job.m_path.GetData(), job.m_image);
+		delete job.m_image;
+		SDL_LockMutex(writer->m_lock);
+	}
+
+	SDL_UnlockMutex(writer->m_lock);
+	return 0;
+}
@@ -5,9 +5,11 @@
 #include "misc/legoimage.h"
 #include "misc/legotexture.h"
 #include "mxdirectx/mxdirect3d.h"
+#include "mxgeometry.h"
+#include "mxmemorystats.h"
 #include "tgl/d3drm/impl.h"
 
-DECOMP_SIZE_ASSERT(LegoTextureInfo, 0x10)
+static LegoU32 g_bytesLoaded = 0;
 
 // FUNCTION: LEGO1 0x10065bf0
 LegoTextureInfo::LegoTextureInfo()
@@ -16,6 +18,8 @@ LegoTextureInfo::LegoTextureInfo()
 	m_surface = NULL;
 	m_palette = NULL;
 	m_texture = NULL;
+	m_cacheSlot = -1;
+	m_surfaceSize = 0;
 }
 
 // FUNCTION: LEGO1 0x10065c00
@@ -40,6 +44,10 @@ LegoTextureInfo::~LegoTextureInfo()
 		m_texture->Release();
 		m_texture = NULL;
 	}
+
+	if (m_surfaceSize) {
+		MxMemoryStats::Remove(MxMemoryStats::e_textures, m_surfaceSize);
+	}
 }
 
 // FUNCTION: LEGO1 0x10065c60
@@ -128,6 +136,7 @@ LegoTextureInfo* LegoTextureInfo::Create(const char* p_name, LegoTexture* p_text
 	}
 
 	textureInfo->m_texture->SetAppData((LPD3DRM_APPDATA) textureInfo);
+	textureInfo->TrackSurface(image->GetWidth(), image->GetHeight());
 	return textureInfo;
 
 done:
@@ -197,6 +206,8 @@ LegoResult LegoTextureInfo::LoadBits(const LegoU8* p_bits)
 			MxU8* surface = (MxU8*) desc.lpSurface;
 			const LegoU8* bits = p_bits;
 
+			g_bytesLoaded += desc.dwWidth * desc.dwHeight;
+
 			if (desc.dwWidth == desc.lPitch) {
 				memcpy(desc.lpSurface, p_bits, desc.dwWidth * desc.dwHeight);
 			}
@@ -216,3 +227,57 @@ LegoResult LegoTextureInfo::LoadBits(const LegoU8* p_bits)
 
 	return FAILURE;
 }
+
+// Copies only p_rect, given in the rows of p_bits, which has the surface's width and height
+LegoResult LegoTextureInfo::LoadBits(const LegoU8* p_bits, const MxRect32& p_rect)
+{
+	if (m_surface != NULL && m_texture != NULL) {
+		DDSURFACEDESC desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.dwSize = sizeof(desc);
+
+		if (m_surface->Lock(NULL, &desc, DDLOCK_SURFACEMEMORYPTR | DDLOCK_WRITEONLY, NULL) == DD_OK) {
+			MxRect32 rect(0, 0, desc.dwWidth - 1, desc.dwHeight - 1);
+			rect &= p_rect;
+
+			if (rect.GetWidth() <= 0 || rect.GetHeight() <= 0) {
+				m_surface->Unlock(desc.lpSurface);
+				return SUCCESS;
+			}
+
+			MxU8* surface = (MxU8*) desc.lpSurface + rect.GetTop() * desc.lPitch + rect.GetLeft();
+			const LegoU8* bits = p_bits + rect.GetTop() * desc.dwWidth + rect.GetLeft();
+
+			for (MxS32 i = 0; i < rect.GetHeight(); i++) {
+				memcpy(surface, bits, rect.GetWidth());
+				surface += desc.lPitch;
+				bits += desc.dwWidth;
+			}
+
+			g_bytesLoaded += rect.GetWidth() * rect.GetHeight();
+			m_surface->Unlock(desc.lpSurface);
+
+#ifdef MINIWIN
+			RECT changed = {rect.GetLeft(), rect.GetTop(), rect.GetRight() + 1, rect.GetBottom() + 1};
+			m_texture->Changed(D3DRMTEXTURE_CHANGEDPIXELS, 1, &changed);
+#else
+			m_texture->Changed(TRUE, FALSE);
+#endif
+			return SUCCESS;
+		}
+	}
+
+	return FAILURE;
+}
+
+// Surfaces are 8-bit
+void LegoTextureInfo::TrackSurface(LegoU32 p_width, LegoU32 p_height)
+{
+	m_surfaceSize = p_width * p_height;
+	MxMemoryStats::Add(MxMemoryStats::e_textures, m_surfaceSize);
+}
+
+LegoU32 LegoTextureInfo::GetBytesLoaded()
+{
+	return g_bytesLoaded;
+}
@@ -10,10 +10,10 @@
 #include "mxmisc.h"
 #include "mxparam.h"
 #include "mxticklemanager.h"
+#include "mxtimer.h"
+#include "mxtransitionhelpers.h"
 #include "mxvideopresenter.h"
 
-#include <SDL3/SDL_timer.h>
-
 DECOMP_SIZE_ASSERT(MxTransitionManager, 0x900)
 
 MxTransitionManager::TransitionType g_transitionManagerConfig = MxTransitionManager::e_mosaic;
@@ -59,11 +59,11 @@ MxResult MxTransitionManager::GetDDrawSurfaceFromVideoManager() // vtable+0x14
 MxResult MxTransitionManager::Tickle()
 {
 	Uint64 time = m_animationSpeed + m_systemTime;
-	if (time > SDL_GetTicks()) {
+	if (time > MxTimer::GetTicks()) {
 		return SUCCESS;
 	}
 
-	m_systemTime = SDL_GetTicks();
+	m_systemTime = MxTimer::GetTicks();
 
 	switch (m_mode) {
 	case e_noAnimation:
@@ -122,7 +122,7 @@ MxResult MxTransitionManager::StartTransition(
 			action->SetFlags(action->GetFlags() | MxDSAction::c_bit10);
 		}
 
-		Uint64 time = SDL_GetTicks();
+		Uint64 time = MxTimer::GetTicks();
 		m_systemTime = time;
 
 		m_animationSpeed = p_speed;
@@ -178,6 +178,29 @@ void MxTransitionManager::NoTransition()
 	EndTransition(TRUE);
 }
 
+// Blits the part of the back buffer a tick changed, along with the wait indicator drawn over it
+void MxTransitionManager::PresentRect(RECT& p_rect)
+{
+	if (!VideoManager()->GetVideoParam().Flags().GetFlipSurfaces()) {
+		return;
+	}
+
+	if (m_copyFlags.m_bit0 && m_waitIndicator != NULL) {
+		MxS32 left = m_waitIndicator->GetLocation().GetX();
+		MxS32 top = m_waitIndicator->GetLocation().GetY();
+
+		p_rect.left = SDL_max(SDL_min(p_rect.left, left), 0);
+		p_rect.top = SDL_max(SDL_min(p_rect.top, top), 0);
+		p_rect.right = SDL_min(SDL_max(p_rect.right, left + m_waitIndicator->GetWidth()), 640);
+		p_rect.bottom = SDL_min(SDL_max(p_rect.bottom, top + m_waitIndicator->GetHeight()), 480);
+	}
+
+	if (p_rect.left < p_rect.right && p_rect.top < p_rect.bottom) {
+		LPDIRECTDRAWSURFACE surf = VideoManager()->GetDisplaySurface()->GetDirectDrawSurface1();
+		surf->BltFast(p_rect.left, p_rect.top, m_ddSurface, &p_rect, DDBLTFAST_WAIT);
+	}
+}
+
 // FUNCTION: LEGO1 0x1004bd10
 void MxTransitionManager::DissolveTransition()
 {
@@ -190,22 +213,11 @@ void MxTransitionManager::DissolveTransition()
 
 	// If we are starting the animation
 	if (m_animationTimer == 0) {
-		// Generate the list of columns in order...
-		MxS32 i;
-		for (i = 0; i < 640; i++) {
-			m_columnOrder[i] = i;
-		}
-
-		// ...then shuffle the list (to ensure that we hit each column once)
-		for (i = 0; i < 640; i++) {
-			MxS32 swap = SDL_rand(640);
-			MxU16 t = m_columnOrder[i];
-			m_columnOrder[i] = m_columnOrder[swap];
-			m_columnOrder[swap] = t;
-		}
+		// Shuffle the list of columns (to ensure that we hit each column once)
+		ShuffleColumns(m_columnOrder, 640);
 
 		// For each scanline, pick a random X offset
-		for (i = 0; i < 480; i++) {
+		for (MxS32 i = 0; i < 480; i++) {
 			m_randomShift[i] = SDL_rand(640);
 		}
 	}
@@ -224,45 +236,31 @@ void MxTransitionManager::DissolveTransition()
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
 
-		for (MxS32 col = 0; col < 640; col++) {
-			// Select 16 columns on each tick
-			if (m_animationTimer * 16 > m_columnOrder[col]) {
-				continue;
-			}
-
-			if (m_animationTimer * 16 + 15 < m_columnOrder[col]) {
-				continue;
-			}
-
-			for (MxS32 row = 0; row < 480; row++) {
-				// Shift the chosen column a different amount at each scanline.
-				// We use the same shift for that scanline each time.
-				// By the end, every pixel gets hit.
-				MxS32 xShift = (m_randomShift[row] + col) % 640;
-
-				// Set the chosen pixel to black
-				if (ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift;
-					*surf = 0;
-				}
-				else if (ddsd.ddpfPixelFormat.dwRGBBitCount == 16) {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift * 2;
-					*(MxU16*) surf = 0;
-				}
-				else {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift * 4;
-					*(MxU32*) surf = 0xFF000000;
-				}
-			}
+		// Select 16 columns on each tick. Each is shifted a different amount at
+		// each scanline, using the same shift for that scanline each time.
+		// By the end, every pixel gets hit.
+		MxU16 columns[16];
+		GetTickColumns(m_columnOrder, m_animationTimer, 16, columns);
+
+		// Set the chosen pixels to black
+		switch (ddsd.ddpfPixelFormat.dwRGBBitCount) {
+		case 8:
+			DissolveRows<MxU8>(&ddsd, m_randomShift, columns, 16, 0);
+			break;
+		case 16:
+			DissolveRows<MxU16>(&ddsd, m_randomShift, columns, 16, 0);
+			break;
+		default:
+			DissolveRows<MxU32>(&ddsd, m_randomShift, columns, 16, 0xFF000000);
+			break;
 		}
 
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
 
-		if (VideoManager()->GetVideoParam().Flags().GetFlipSurfaces()) {
-			LPDIRECTDRAWSURFACE surf = VideoManager()->GetDisplaySurface()->GetDirectDrawSurface1();
-			surf->BltFast(0, 0, m_ddSurface, &g_fullScreenRect, DDBLTFAST_WAIT);
-		}
+		// The shifted columns reach every scanline and nearly every x
+		RECT dirtyRect = g_fullScreenRect;
+		PresentRect(dirtyRect);
 
 		m_animationTimer++;
 	}
@@ -278,23 +276,12 @@ void MxTransitionManager::MosaicTransition()
 	}
 	else {
 		if (m_animationTimer == 0) {
-
 			// Same init/shuffle steps as the dissolve transition, except that
 			// we are using big blocky pixels and only need 64 columns.
-			MxS32 i;
-			for (i = 0; i < 64; i++) {
-				m_columnOrder[i] = i;
-			}
-
-			for (i = 0; i < 64; i++) {
-				MxS32 swap = SDL_rand(64);
-				MxU16 t = m_columnOrder[i];
-				m_columnOrder[i] = m_columnOrder[swap];
-				m_columnOrder[swap] = t;
-			}
+			ShuffleColumns(m_columnOrder, 64);
 
 			// The same is true here. We only need 48 rows.
-			for (i = 0; i < 48; i++) {
+			for (MxS32 i = 0; i < 48; i++) {
 				m_randomShift[i] = SDL_rand(64);
 			}
 		}
@@ -313,81 +300,39 @@ void MxTransitionManager::MosaicTransition()
 		if (res == DD_OK) {
 			SubmitCopyRect(&ddsd);
 
-			for (MxS32 col = 0; col < 64; col++) {
-				// Select 4 columns on each tick
-				if (m_animationTimer * 4 > m_columnOrder[col]) {
-					continue;
-				}
-
-				if (m_animationTimer * 4 + 3 < m_columnOrder[col]) {
-					continue;
-				}
-
-				for (MxS32 row = 0; row < 48; row++) {
-					// To do the mosaic effect, we subdivide the 640x480 surface into
-					// 10x10 pixel blocks. At the chosen block, we sample the top-leftmost
-					// color and set the other 99 pixels to that value.
-
-					// First, get the offset of the 10x10 block that we will sample for this row.
-					MxS32 xShift = 10 * ((m_randomShift[row] + col) % 64);
-
-					// Combine xShift with this value to target the correct location in the buffer.
-					MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
-
-					// Seek to the sample position.
-					MxU8* source = (MxU8*) ddsd.lpSurface + 10 * row * ddsd.lPitch + bytesPerPixel * xShift;
-
-					// Sample byte or word depending on display mode.
-					MxU32 sample;
-					switch (bytesPerPixel) {
-					case 1:
-						sample = *source;
-						break;
-					case 2:
-						sample = *(MxU16*) source;
-						break;
-					default:
-						sample = *(MxU32*) source;
-						break;
-					}
-
-					// For each of the 10 rows in the 10x10 square:
-					for (MxS32 k = 10 * row; k < 10 * row + 10; k++) {
-						void* pos = (MxU8*) ddsd.lpSurface + k * ddsd.lPitch + bytesPerPixel * xShift;
-
-						switch (bytesPerPixel) {
-						case 1: {
-							// Optimization: If the pixel is only one byte, we can use memset
-							memset(pos, sample, 10);
-							break;
-						}
-						case 2: {
-							MxU16* p = (MxU16*) pos;
-							for (MxS32 tt = 0; tt < 10; tt++) {
-								p[tt] = (MxU16) sample;
-							}
-							break;
-						}
-						default: {
-							MxU32* p = (MxU32*) pos;
-							for (MxS32 tt = 0; tt < 10; tt++) {
-								p[tt] = (MxU32) sample;
-							}
-							break;
-						}
-						}
-					}
-				}
+			// Select 4 columns on each tick. To do the mosaic effect, we subdivide
+			// the 640x480 surface into 10x10 pixel blocks. At each chosen block,
+			// we sample the top-leftmost color and set the other 99 pixels to that value.
+			MxU16 columns[4];
+			GetTickColumns(m_columnOrder, m_animationTimer, 4, columns);
+
+			switch (ddsd.ddpfPixelFormat.dwRGBBitCount / 8) {
+			case 1:
+				MosaicBlocks<MxU8>(&ddsd, m_randomShift, columns, 4);
+				break;
+			case 2:
+				MosaicBlocks<MxU16>(&ddsd, m_randomShift, columns, 4);
+				break;
+			default:
+				MosaicBlocks<MxU32>(&ddsd, m_randomShift, columns, 4);
+				break;
 			}
 
 			SetupCopyRect(&ddsd);
 			m_ddSurface->Unlock(ddsd.lpSurface);
 
-			if (VideoManager()->GetVideoParam().Flags().GetFlipSurfaces()) {
-				LPDIRECTDRAWSURFACE surf = VideoManager()->GetDisplaySurface()->GetDirectDrawSurface1();
-				surf->BltFast(0, 0, m_ddSurface, &g_fullScreenRect, DDBLTFAST_WAIT);
+			// Only the columns of blocks that were hit, across all rows
+			RECT dirtyRect = {640, 0, 0, 480};
+			for (MxS32 row = 0; row < 48; row++) {
+				for (MxS32 i = 0; i < 4; i++) {
+					MxS32 xShift = 10 * ((m_randomShift[row] + columns[i]) % 64);
+					dirtyRect.left = SDL_min(dirtyRect.left, xShift);
+					dirtyRect.right = SDL_max(dirtyRect.right, xShift + 10);
+				}
 			}
 
+			PresentRect(dirtyRect);
+
 			m_animationTimer++;
 		}
 	}
@@ -650,13 +595,7 @@ void MxTransitionManager::FakeMosaicTransition()
 
 	if (m_animationTimer == 0) {
 		g_colorOffset = SDL_rand(32);
-		for (MxS32 i = 0; i < 64; i++) {
-			m_columnOrder[i] = i;
-		}
-		for (MxS32 i = 0; i < 64; i++) {
-			MxS32 swap = SDL_rand(64);
-			std::swap(m_columnOrder[i], m_columnOrder[swap]);
-		}
+		ShuffleColumns(m_columnOrder, 64);
 		for (MxS32 i = 0; i < 48; i++) {
 			m_randomShift[i] = SDL_rand(64);
 		}
@@ -685,13 +624,11 @@ void MxTransitionManager::FakeMosaicTransition()
 
 		MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
 
-		for (MxS32 col = 0; col < 64; col++) {
-			if (m_animationTimer * 4 > m_columnOrder[col]) {
-				continue;
-			}
-			if (m_animationTimer * 4 + 3 < m_columnOrder[col]) {
-				continue;
-			}
+		MxU16 columns[4];
+		GetTickColumns(m_columnOrder, m_animationTimer, 4, columns);
+
+		for (MxS32 c = 0; c < 4; c++) {
+			MxS32 col = columns[c];
 
 			for (MxS32 row = 0; row < 48; row++) {
 				MxS32 xShift = 10 * ((m_randomShift[row] + col) % 64);
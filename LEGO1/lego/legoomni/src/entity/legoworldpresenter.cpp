@@ -13,6 +13,7 @@
 #include "legovideomanager.h"
 #include "legoworld.h"
 #include "misc.h"
+#include "misc/legostorage.h"
 #include "modeldb/modeldb.h"
 #include "mxactionnotificationparam.h"
 #include "mxautolock.h"
@@ -161,108 +162,205 @@ void LegoWorldPresenter::StartingTickle()
 	ProgressTickleState(e_streaming);
 }
 
-// FUNCTION: LEGO1 0x10066b40
-MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
+// Contents of WORLD.WDB, loaded once and shared by every subsequent world load.
+// Part and model chunks reference this image in place instead of being copied out.
+static MxU8* g_wdbImage = NULL;
+static LegoU32 g_wdbImageSize = 0;
+static MxBool g_wdbImageFailed = FALSE;
+
+// Model database directory of WORLD.WDB, parsed on first use
+static ModelDbWorld* g_wdbWorlds = NULL;
+static MxS32 g_wdbNumWorlds = 0;
+static LegoU32 g_wdbDirectoryEnd = 0;
+
+static void GetWdbPath(char* p_path, const char* p_root)
 {
-	char wdbPath[512];
-	sprintf(wdbPath, "%s", MxOmni::GetHD());
+	sprintf(p_path, "%s", p_root);
+
+	if (p_path[strlen(p_path) - 1] != '\\' && p_path[strlen(p_path) - 1] != '/') {
+		strcat(p_path, "\\");
+	}
+
+	strcat(p_path, "lego\\data\\world.wdb");
+	MxString::MapPathToFilesystem(p_path);
+}
 
-	if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
-		strcat(wdbPath, "\\");
+// Returns WORLD.WDB as a LegoMemory over the resident image, or as a buffered
+// LegoFile when the image could not be loaded, so that the many small reads of
+// the directory are served from memory either way. The caller deletes it.
+static LegoStorage* OpenWdbFile()
+{
+	if (g_wdbImage != NULL) {
+		return new LegoMemory(g_wdbImage, g_wdbImageSize);
 	}
 
-	strcat(wdbPath, "lego\\data\\world.wdb");
-	MxString::MapPathToFilesystem(wdbPath);
+	char wdbPath[512];
+	GetWdbPath(wdbPath, MxOmni::GetHD());
+
+	LegoFile* wdbFile = new LegoFile;
 
-	SDL_IOStream* wdbFile;
+	if (wdbFile->Open(wdbPath, LegoFile::c_read) != SUCCESS) {
+		GetWdbPath(wdbPath, MxOmni::GetCD());
 
-	if ((wdbFile = SDL_IOFromFile(wdbPath, "rb")) == NULL) {
-		sprintf(wdbPath, "%s", MxOmni::GetCD());
+		if (wdbFile->Open(wdbPath, LegoFile::c_read) != SUCCESS) {
+			delete wdbFile;
+			return NULL;
+		}
+	}
 
-		if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
-			strcat(wdbPath, "\\");
+	if (!g_wdbImageFailed) {
+		size_t size;
+		void* image = SDL_LoadFile(wdbPath, &size);
+
+		if (image != NULL && size <= 0xffffffff) {
+			delete wdbFile;
+			g_wdbImage = (MxU8*) image;
+			g_wdbImageSize = (LegoU32) size;
+			return new LegoMemory(g_wdbImage, g_wdbImageSize);
 		}
 
-		strcat(wdbPath, "lego\\data\\world.wdb");
-		MxString::MapPathToFilesystem(wdbPath);
+		// Not enough memory to keep the file resident; stream from disk instead
+		SDL_free(image);
+		g_wdbImageFailed = TRUE;
+	}
+
+	return wdbFile;
+}
+
+// Returns p_length bytes at the current position of p_wdbFile and advances past them.
+// The data is referenced in place when WORLD.WDB is resident, otherwise it is read
+// into a new buffer that the caller must free if p_owned is set.
+static MxU8* ReadWdbData(LegoStorage* p_wdbFile, MxU32 p_length, MxBool& p_owned)
+{
+	p_owned = FALSE;
+
+	if (g_wdbImage != NULL) {
+		LegoU32 position;
 
-		if ((wdbFile = SDL_IOFromFile(wdbPath, "rb")) == NULL) {
-			return FAILURE;
+		if (p_wdbFile->GetPosition(position) != SUCCESS || p_length > g_wdbImageSize - position) {
+			return NULL;
 		}
+
+		p_wdbFile->SetPosition(position + p_length);
+		return g_wdbImage + position;
+	}
+
+	MxU8* buff = new MxU8[p_length];
+	if (p_wdbFile->Read(buff, p_length) != SUCCESS) {
+		delete[] buff;
+		return NULL;
+	}
+
+	p_owned = TRUE;
+	return buff;
+}
+
+// FUNCTION: LEGO1 0x10066b40
+MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
+{
+	LegoStorage* wdbFile = OpenWdbFile();
+
+	if (wdbFile == NULL) {
+		return FAILURE;
 	}
 
-	ModelDbWorld* worlds = NULL;
-	MxS32 numWorlds, i, j;
+	MxResult result = FAILURE;
+	ModelDbWorld* worlds;
+	MxS32 i, j;
 	MxU32 size;
 	MxU8* buff;
+	MxBool owned;
+	LegoU32 position;
+
+	if (g_wdbWorlds == NULL) {
+		if (ReadModelDbWorlds(wdbFile, g_wdbWorlds, g_wdbNumWorlds) != SUCCESS) {
+			goto done;
+		}
+
+		if (wdbFile->GetPosition(g_wdbDirectoryEnd) != SUCCESS) {
+			goto done;
+		}
+	}
 
-	ReadModelDbWorlds(wdbFile, worlds, numWorlds);
+	worlds = g_wdbWorlds;
 
-	for (i = 0; i < numWorlds; i++) {
+	for (i = 0; i < g_wdbNumWorlds; i++) {
 		if (!SDL_strcasecmp(worlds[i].m_worldName, p_worldName)) {
 			break;
 		}
 	}
 
-	if (i == numWorlds) {
-		return FAILURE;
+	if (i == g_wdbNumWorlds) {
+		goto done;
 	}
 
 	if (g_wdbSkipGlobalPartsOffset == 0) {
-		if (SDL_ReadIO(wdbFile, &size, sizeof(MxU32)) != sizeof(MxU32)) {
-			return FAILURE;
+		if (wdbFile->SetPosition(g_wdbDirectoryEnd) != SUCCESS) {
+			goto done;
+		}
+
+		if (wdbFile->Read(&size, sizeof(MxU32)) != SUCCESS) {
+			goto done;
 		}
 
-		buff = new MxU8[size];
-		if (SDL_ReadIO(wdbFile, buff, size) != size) {
-			return FAILURE;
+		if ((buff = ReadWdbData(wdbFile, size, owned)) == NULL) {
+			goto done;
 		}
 
-		MxDSChunk chunk;
-		chunk.SetLength(size);
-		chunk.SetData(buff);
+		{
+			MxDSChunk chunk;
+			chunk.SetLength(size);
+			chunk.SetData(buff);
 
-		LegoTexturePresenter texturePresenter;
-		if (texturePresenter.Read(chunk) == SUCCESS) {
-			texturePresenter.Store();
+			LegoTexturePresenter texturePresenter;
+			if (texturePresenter.Read(chunk) == SUCCESS) {
+				texturePresenter.Store();
+			}
 		}
 
-		delete[] buff;
+		if (owned) {
+			delete[] buff;
+		}
 
-		if (SDL_ReadIO(wdbFile, &size, sizeof(MxU32)) != sizeof(MxU32)) {
-			return FAILURE;
+		if (wdbFile->Read(&size, sizeof(MxU32)) != SUCCESS) {
+			goto done;
 		}
 
-		buff = new MxU8[size];
-		if (SDL_ReadIO(wdbFile, buff, size) != size) {
-			return FAILURE;
+		if ((buff = ReadWdbData(wdbFile, size, owned)) == NULL) {
+			goto done;
 		}
 
-		chunk.SetLength(size);
-		chunk.SetData(buff);
+		{
+			MxDSChunk chunk;
+			chunk.SetLength(size);
+			chunk.SetData(buff);
 
-		LegoPartPresenter partPresenter;
-		if (partPresenter.Read(chunk) == SUCCESS) {
-			partPresenter.Store();
+			LegoPartPresenter partPresenter;
+			if (partPresenter.Read(chunk) == SUCCESS) {
+				partPresenter.Store();
+			}
 		}
 
-		delete[] buff;
+		if (owned) {
+			delete[] buff;
+		}
 
-		g_wdbSkipGlobalPartsOffset = SDL_TellIO(wdbFile);
-	}
-	else {
-		if (SDL_SeekIO(wdbFile, g_wdbSkipGlobalPartsOffset, SDL_IO_SEEK_SET) != g_wdbSkipGlobalPartsOffset) {
-			return FAILURE;
+		if (wdbFile->GetPosition(position) != SUCCESS) {
+			goto done;
 		}
+
+		g_wdbSkipGlobalPartsOffset = position;
 	}
 
-	ModelDbPartListCursor cursor(worlds[i].m_partList);
-	ModelDbPart* part;
+	{
+		ModelDbPartListCursor cursor(worlds[i].m_partList);
+		ModelDbPart* part;
 
-	while (cursor.Next(part)) {
-		if (GetViewLODListManager()->Lookup(part->m_roiName.GetData()) == NULL &&
-			LoadWorldPart(*part, wdbFile) != SUCCESS) {
-			return FAILURE;
+		while (cursor.Next(part)) {
+			if (GetViewLODListManager()->Lookup(part->m_roiName.GetData()) == NULL &&
+				LoadWorldPart(*part, wdbFile) != SUCCESS) {
+				goto done;
+			}
 		}
 	}
 
@@ -288,15 +386,15 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 		else if (g_legoWorldPresenterQuality <= 1 && !SDL_strncasecmp(worlds[i].m_models[j].m_modelName, "haus", 4)) {
 			if (worlds[i].m_models[j].m_modelName[4] == '3') {
 				if (LoadWorldModel(worlds[i].m_models[j], wdbFile, p_world) != SUCCESS) {
-					return FAILURE;
+					goto done;
 				}
 
 				if (LoadWorldModel(worlds[i].m_models[j - 2], wdbFile, p_world) != SUCCESS) {
-					return FAILURE;
+					goto done;
 				}
 
 				if (LoadWorldModel(worlds[i].m_models[j - 1], wdbFile, p_world) != SUCCESS) {
-					return FAILURE;
+					goto done;
 				}
 			}
 
@@ -304,23 +402,26 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 		}
 
 		if (LoadWorldModel(worlds[i].m_models[j], wdbFile, p_world) != SUCCESS) {
-			return FAILURE;
+			goto done;
 		}
 	}
 
-	FreeModelDbWorlds(worlds, numWorlds);
-	SDL_CloseIO(wdbFile);
-	return SUCCESS;
+	result = SUCCESS;
+
+done:
+	delete wdbFile;
+	return result;
 }
 
 // FUNCTION: LEGO1 0x10067360
-MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_wdbFile)
+MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, LegoStorage* p_wdbFile)
 {
 	MxResult result;
-	MxU8* buff = new MxU8[p_part.m_partDataLength];
+	MxBool owned;
+	MxU8* buff;
 
-	SDL_SeekIO(p_wdbFile, p_part.m_partDataOffset, SDL_IO_SEEK_SET);
-	if (SDL_ReadIO(p_wdbFile, buff, p_part.m_partDataLength) != p_part.m_partDataLength) {
+	if (p_wdbFile->SetPosition(p_part.m_partDataOffset) != SUCCESS ||
+		(buff = ReadWdbData(p_wdbFile, p_part.m_partDataLength, owned)) == NULL) {
 		return FAILURE;
 	}
 
@@ -335,17 +436,21 @@ MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_
 		partPresenter.Store();
 	}
 
-	delete[] buff;
+	if (owned) {
+		delete[] buff;
+	}
+
 	return result;
 }
 
 // FUNCTION: LEGO1 0x100674b0
-MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, SDL_IOStream* p_wdbFile, LegoWorld* p_world)
+MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, LegoStorage* p_wdbFile, LegoWorld* p_world)
 {
-	MxU8* buff = new MxU8[p_model.m_modelDataLength];
+	MxBool owned;
+	MxU8* buff;
 
-	SDL_SeekIO(p_wdbFile, p_model.m_modelDataOffset, SDL_IO_SEEK_SET);
-	if (SDL_ReadIO(p_wdbFile, buff, p_model.m_modelDataLength) != p_model.m_modelDataLength) {
+	if (p_wdbFile->SetPosition(p_model.m_modelDataOffset) != SUCCESS ||
+		(buff = ReadWdbData(p_wdbFile, p_model.m_modelDataLength, owned)) == NULL) {
 		return FAILURE;
 	}
 
@@ -394,7 +499,10 @@ MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, SDL_IOStream*
 
 	modelPresenter.SetAction(&action);
 	modelPresenter.FUN_1007ff70(chunk, createdEntity, p_model.m_visible, p_world);
-	delete[] buff;
+
+	if (owned) {
+		delete[] buff;
+	}
 
 	return SUCCESS;
 }
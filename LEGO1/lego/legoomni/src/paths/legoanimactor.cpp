@@ -7,9 +7,9 @@
 #include "legoworld.h"
 #include "misc.h"
 #include "mxutilities.h"
+#include "roi/legoflatanim.h"
 
 DECOMP_SIZE_ASSERT(LegoAnimActor, 0x174)
-DECOMP_SIZE_ASSERT(LegoAnimActorStruct, 0x20)
 
 // FUNCTION: LEGO1 0x1001bf80
 // FUNCTION: BETA10 0x1003dc10
@@ -19,6 +19,33 @@ LegoAnimActorStruct::LegoAnimActorStruct(float p_unk0x00, LegoAnim* p_AnimTreePt
 	m_AnimTreePtr = p_AnimTreePtr;
 	m_roiMap = p_roiMap;
 	m_numROIs = p_numROIs;
+	m_flatAnim = new LegoFlatAnim(p_AnimTreePtr->GetRoot(), FALSE, p_roiMap);
+}
+
+LegoAnimActorStruct::LegoAnimActorStruct(const LegoAnimActorStruct& p_laas)
+{
+	m_unk0x00 = p_laas.m_unk0x00;
+	m_AnimTreePtr = p_laas.m_AnimTreePtr;
+	m_roiMap = p_laas.m_roiMap;
+	m_numROIs = p_laas.m_numROIs;
+	m_unk0x10 = p_laas.m_unk0x10;
+	m_flatAnim = new LegoFlatAnim(m_AnimTreePtr->GetRoot(), FALSE, m_roiMap);
+}
+
+LegoAnimActorStruct& LegoAnimActorStruct::operator=(const LegoAnimActorStruct& p_laas)
+{
+	if (this != &p_laas) {
+		m_unk0x00 = p_laas.m_unk0x00;
+		m_AnimTreePtr = p_laas.m_AnimTreePtr;
+		m_roiMap = p_laas.m_roiMap;
+		m_numROIs = p_laas.m_numROIs;
+		m_unk0x10 = p_laas.m_unk0x10;
+
+		delete m_flatAnim;
+		m_flatAnim = new LegoFlatAnim(m_AnimTreePtr->GetRoot(), FALSE, m_roiMap);
+	}
+
+	return *this;
 }
 
 // FUNCTION: LEGO1 0x1001c0a0
@@ -27,6 +54,8 @@ LegoAnimActorStruct::~LegoAnimActorStruct()
 	for (MxU16 i = 0; i < m_unk0x10.size(); i++) {
 		delete m_unk0x10[i];
 	}
+
+	delete m_flatAnim;
 }
 
 // FUNCTION: LEGO1 0x1001c130
@@ -117,10 +146,7 @@ MxResult LegoAnimActor::FUN_1001c360(float p_und, Matrix4& p_transform)
 			}
 		}
 		else {
-			// name verified by BETA10 0x1003e407
-			LegoTreeNode* n = m_animMaps[m_curAnim]->m_AnimTreePtr->GetRoot();
-
-			assert(roiMap && n && m_roi && m_boundary);
+			assert(roiMap && m_roi && m_boundary);
 
 			m_roi->SetVisibility(TRUE);
 
@@ -132,9 +158,7 @@ MxResult LegoAnimActor::FUN_1001c360(float p_und, Matrix4& p_transform)
 				}
 			}
 
-			for (MxS32 j = 0; j < n->GetNumChildren(); j++) {
-				LegoROI::FUN_100a8e80(n->GetChild(j), p_transform, p_und, roiMap);
-			}
+			m_animMaps[m_curAnim]->m_flatAnim->ApplyAnimation(p_transform, p_und);
 
 			if (m_cameraFlag) {
 				FUN_10010c30();
@@ -8,6 +8,7 @@
 #include "misc.h"
 #include "mxmisc.h"
 #include "mxtimer.h"
+#include "roi/legoflatanim.h"
 
 DECOMP_SIZE_ASSERT(LegoExtraActor, 0x1dc)
 
@@ -369,12 +370,7 @@ void LegoExtraActor::Animate(float p_time)
 		}
 
 		MxMatrix matrix(m_roi->GetLocal2World());
-		LegoTreeNode* root = laas->m_AnimTreePtr->GetRoot();
-		MxS32 count = root->GetNumChildren();
-
-		for (MxS32 i = 0; i < count; i++) {
-			LegoROI::FUN_100a8e80(root->GetChild(i), matrix, duration2, laas->m_roiMap);
-		}
+		laas->m_flatAnim->ApplyAnimation(matrix, duration2);
 	}
 }
 
@@ -15,6 +15,7 @@
 #include "mxtimer.h"
 #include "mxutilities.h"
 #include "mxvariabletable.h"
+#include "realtime/mathkernel.h"
 
 #include <SDL3/SDL.h>
 #include <mxdebug.h>
@@ -323,12 +324,12 @@ MxS32 LegoPathActor::VTable0x8c(float p_time, Matrix4& p_transform)
 
 			dir = p1;
 			up = *m_boundary->GetUp();
-			right.EqualsCross(up, dir);
+			Vec3Cross(&right[0], &up[0], &dir[0]);
 
-			MxS32 res = right.Unitize();
+			MxS32 res = Vec3Unitize(&right[0]);
 			assert(res == 0);
 
-			dir.EqualsCross(right, up);
+			Vec3Cross(&dir[0], &right[0], &up[0]);
 			pos = p2;
 			return result;
 		}
@@ -663,8 +664,8 @@ MxResult LegoPathActor::VTable0x9c()
 		LERP3(local34, v1, v2, m_unk0xe4);
 
 		m_destEdge->GetFaceNormal(*m_boundary, local78);
-		local48.EqualsCross(*m_boundary->GetUp(), local78);
-		local48.Unitize();
+		Vec3Cross(&local48[0], &(*m_boundary->GetUp())[0], &local78[0]);
+		Vec3Unitize(&local48[0]);
 	}
 
 	Vector3 rightRef(m_unk0xec[0]);
@@ -673,11 +674,11 @@ MxResult LegoPathActor::VTable0x9c()
 
 	upRef = *m_boundary->GetUp();
 
-	rightRef.EqualsCross(upRef, dirRef);
-	rightRef.Unitize();
+	Vec3Cross(&rightRef[0], &upRef[0], &dirRef[0]);
+	Vec3Unitize(&rightRef[0]);
 
-	dirRef.EqualsCross(rightRef, upRef);
-	dirRef.Unitize();
+	Vec3Cross(&dirRef[0], &rightRef[0], &upRef[0]);
+	Vec3Unitize(&dirRef[0]);
 
 	Mx3DPointFloat localc0(m_unk0xec[3]);
 	Mx3DPointFloat local84(m_unk0xec[2]);
@@ -4,8 +4,6 @@
 #include "misc/legocontainer.h"
 #include "mxdsaction.h"
 
-DECOMP_SIZE_ASSERT(LegoFlcTexturePresenter, 0x70)
-
 // FUNCTION: LEGO1 0x1005de80
 LegoFlcTexturePresenter::LegoFlcTexturePresenter()
 {
@@ -43,11 +41,17 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
 	MxU8* data = p_chunk->GetData();
 
-	m_rectCount = *(MxS32*) data;
+	MxS32 rectCount = UnalignedRead<MxS32>(data);
 	data += sizeof(MxS32);
 
 	MxRect32* rects = (MxRect32*) data;
-	data += m_rectCount * sizeof(MxRect32);
+	data += rectCount * sizeof(MxRect32);
+
+	// Every frame decoded since the last PutFrame goes out in the same upload
+	if (rectCount != 0) {
+		UnionFrameRects((MxU8*) rects, rectCount, m_dirtyRect, m_rectCount != 0);
+		m_rectCount += rectCount;
+	}
 
 	MxBool decodedColorMap;
 	DecodeFLCFrame(
@@ -64,7 +68,7 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoFlcTexturePresenter::PutFrame()
 {
 	if (m_texture != NULL && m_rectCount != 0) {
-		m_texture->LoadBits(m_frameBitmap->GetImage());
+		m_texture->LoadBits(m_frameBitmap->GetImage(), m_dirtyRect);
 		m_rectCount = 0;
 	}
 }
@@ -69,6 +69,12 @@ MxResult LegoPartPresenter::Read(MxDSChunk& p_chunk)
 	LegoTexture* texture = NULL;
 	LegoTextureInfo* textureInfo = NULL;
 	LegoS32 hardwareMode = VideoManager()->GetDirect3D()->AssignedDevice()->GetHardwareMode();
+	LegoLODCache::Key cacheKey;
+
+	if (LegoLOD::GetCache() != NULL) {
+		cacheKey.m_sourceSize = p_chunk.GetLength();
+		cacheKey.m_sourceHash = LegoLODCache::Hash(p_chunk.GetData(), p_chunk.GetLength());
+	}
 
 	if (storage.Read(&textureInfoOffset, sizeof(LegoU32)) != SUCCESS) {
 		goto done;
@@ -184,7 +190,15 @@ MxResult LegoPartPresenter::Read(MxDSChunk& p_chunk)
 		for (j = 0; j < numLODs; j++) {
 			LegoLOD* lod = new LegoLOD(VideoManager()->GetRenderer());
 
-			if (lod->Read(VideoManager()->GetRenderer(), TextureContainer(), &storage) != SUCCESS) {
+			cacheKey.m_partName = roiName;
+			cacheKey.m_lodIndex = j;
+
+			if (lod->Read(
+					VideoManager()->GetRenderer(),
+					TextureContainer(),
+					&storage,
+					LegoLOD::GetCache() != NULL ? &cacheKey : NULL
+				) != SUCCESS) {
 				goto done;
 			}
 
@@ -7,8 +7,6 @@
 #include "mxcompositepresenter.h"
 #include "mxdsaction.h"
 
-DECOMP_SIZE_ASSERT(LegoPhonemePresenter, 0x88)
-
 // FUNCTION: LEGO1 0x1004e180
 LegoPhonemePresenter::LegoPhonemePresenter()
 {
@@ -93,11 +91,17 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
 	MxU8* data = p_chunk->GetData();
 
-	m_rectCount = UnalignedRead<MxS32>(data);
+	MxS32 rectCount = UnalignedRead<MxS32>(data);
 	data += sizeof(MxS32);
 
 	MxRect32* rects = (MxRect32*) data;
-	data += m_rectCount * sizeof(MxRect32);
+	data += rectCount * sizeof(MxRect32);
+
+	// Every frame decoded since the last PutFrame goes out in the same upload
+	if (rectCount != 0) {
+		UnionFrameRects((MxU8*) rects, rectCount, m_dirtyRect, m_rectCount != 0);
+		m_rectCount += rectCount;
+	}
 
 	MxBool decodedColorMap;
 	DecodeFLCFrame(
@@ -114,7 +118,7 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 void LegoPhonemePresenter::PutFrame()
 {
 	if (m_textureInfo != NULL && m_rectCount != 0) {
-		m_textureInfo->LoadBits(m_frameBitmap->GetImage());
+		m_textureInfo->LoadBits(m_frameBitmap->GetImage(), m_dirtyRect);
 		m_rectCount = 0;
 	}
 }
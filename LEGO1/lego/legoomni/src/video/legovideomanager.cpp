@@ -11,6 +11,7 @@
 #include "mxgeometry/mxmatrix.h"
 #include "mxmisc.h"
 #include "mxpalette.h"
+#include "mxprofiler.h"
 #include "mxregion.h"
 #include "mxtimer.h"
 #include "mxtransitionmanager.h"
@@ -298,6 +299,7 @@ void LegoVideoManager::ToggleFPS(MxBool p_visible)
 // FUNCTION: LEGO1 0x1007b770
 MxResult LegoVideoManager::Tickle()
 {
+	MxProfileZone zone("LegoVideoManager::Tickle");
 	if (m_unk0x554 && !m_videoParam.Flags().GetFlipSurfaces() &&
 		TransitionManager()->GetTransitionType() == MxTransitionManager::e_idle) {
 		Sleep(30);
@@ -305,6 +307,10 @@ MxResult LegoVideoManager::Tickle()
 
 	m_stopWatch->Stop();
 	m_elapsedSeconds = m_stopWatch->ElapsedSeconds();
+	if (!MxTimer::IsRealClock()) {
+		// Drives how many extras are allowed, so it must follow the game clock to be reproducible
+		m_elapsedSeconds = MxTimer::GetFrameTime() / 1000.0;
+	}
 	m_stopWatch->Reset();
 	m_stopWatch->Start();
 
@@ -2,6 +2,7 @@
 
 #include "mxgeometry/mxmatrix.h"
 #include "mxgeometry/mxquaternion.h"
+#include "realtime/mathkernel.h"
 
 #include <limits.h>
 
@@ -231,11 +232,11 @@ LegoResult LegoAnimScene::FUN_1009f490(LegoFloat p_time, Matrix4& p_matrix)
 	local54 = localcc;
 	local54 -= localb8;
 
-	if (local54.Unitize() == 0) {
-		local5c.EqualsCross(local68, local54);
+	if (Vec3Unitize(&local54[0]) == 0) {
+		Vec3Cross(&local5c[0], &local68[0], &local54[0]);
 
-		if (local5c.Unitize() == 0) {
-			local68.EqualsCross(local54, local5c);
+		if (Vec3Unitize(&local5c[0]) == 0) {
+			Vec3Cross(&local68[0], &local54[0], &local5c[0]);
 
 			localcc = p_matrix[3];
 			localcc += localb0[3];
@@ -271,7 +272,7 @@ LegoResult LegoAnimScene::FUN_1009f490(LegoFloat p_time, Matrix4& p_matrix)
 			}
 
 			local4c = p_matrix;
-			p_matrix.Product(local4c.GetData(), localb0.GetData());
+			Mat4Product(p_matrix[0], local4c[0], localb0[0]);
 			p_matrix[3][0] = localcc[0];
 			p_matrix[3][1] = localcc[1];
 			p_matrix[3][2] = localcc[2];
@@ -728,35 +729,41 @@ void LegoAnimNodeData::SetName(LegoChar* p_name)
 // FUNCTION: BETA10 0x1017f254
 LegoResult LegoAnimNodeData::CreateLocalTransform(LegoFloat p_time, Matrix4& p_matrix)
 {
-	LegoU32 index;
+	LegoAnimKeyCursor cursor;
+	cursor.m_translationIndex = GetTranslationIndex();
+	cursor.m_rotationIndex = GetRotationIndex();
+	cursor.m_scaleIndex = GetScaleIndex();
 
+	CreateLocalTransform(p_time, p_matrix, cursor);
+
+	SetTranslationIndex(cursor.m_translationIndex);
+	SetRotationIndex(cursor.m_rotationIndex);
+	SetScaleIndex(cursor.m_scaleIndex);
+	return SUCCESS;
+}
+
+// Searches from the caller's cursor instead of the shared one
+LegoResult LegoAnimNodeData::CreateLocalTransform(LegoFloat p_time, Matrix4& p_matrix, LegoAnimKeyCursor& p_cursor)
+{
 	if (m_scaleKeys != NULL) {
-		index = GetScaleIndex();
-		GetScale(m_numScaleKeys, m_scaleKeys, p_time, p_matrix, index);
-		SetScaleIndex(index);
+		GetScale(m_numScaleKeys, m_scaleKeys, p_time, p_matrix, p_cursor.m_scaleIndex);
 
 		if (m_rotationKeys != NULL) {
 			MxMatrix a, b;
 			a.SetIdentity();
 
-			index = GetRotationIndex();
-			GetRotation(m_numRotationKeys, m_rotationKeys, p_time, a, index);
-			SetRotationIndex(index);
+			GetRotation(m_numRotationKeys, m_rotationKeys, p_time, a, p_cursor.m_rotationIndex);
 
 			b = p_matrix;
-			p_matrix.Product(b, a);
+			Mat4Product(p_matrix[0], b[0], a[0]);
 		}
 	}
 	else if (m_rotationKeys != NULL) {
-		index = GetRotationIndex();
-		GetRotation(m_numRotationKeys, m_rotationKeys, p_time, p_matrix, index);
-		SetRotationIndex(index);
+		GetRotation(m_numRotationKeys, m_rotationKeys, p_time, p_matrix, p_cursor.m_rotationIndex);
 	}
 
 	if (m_translationKeys != NULL) {
-		index = GetTranslationIndex();
-		GetTranslation(m_numTranslationKeys, m_translationKeys, p_time, p_matrix, index);
-		SetTranslationIndex(index);
+		GetTranslation(m_numTranslationKeys, m_translationKeys, p_time, p_matrix, p_cursor.m_translationIndex);
 	}
 
 	return SUCCESS;
@@ -943,6 +950,17 @@ LegoBool LegoAnimNodeData::GetVisibility(LegoFloat p_time)
 	return result;
 }
 
+LegoBool LegoAnimNodeData::GetVisibility(LegoFloat p_time, LegoAnimKeyCursor& p_cursor)
+{
+	LegoU32 i;
+
+	if (FindKeys(p_time, m_numMorphKeys, m_morphKeys, sizeof(*m_morphKeys), i, p_cursor.m_morphIndex) == 0) {
+		return TRUE;
+	}
+
+	return m_morphKeys[i].IsVisible();
+}
+
 // FUNCTION: LEGO1 0x100a0a00
 LegoU32 LegoAnimNodeData::FindKeys(
 	LegoFloat p_time,
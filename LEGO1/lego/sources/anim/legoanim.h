@@ -149,6 +149,18 @@ class LegoUnknownKey : public LegoAnimKey {
 	LegoFloat m_z; // 0x08
 };
 
+// Positions of the last keys found for one node, see LegoAnimNodeData::FindKeys.
+// LegoAnimNodeData keeps one set of these for everyone playing the animation;
+// callers that evaluate the same animation for several actors keep their own.
+struct LegoAnimKeyCursor {
+	LegoAnimKeyCursor() : m_translationIndex(0), m_rotationIndex(0), m_scaleIndex(0), m_morphIndex(0) {}
+
+	LegoU32 m_translationIndex;
+	LegoU32 m_rotationIndex;
+	LegoU32 m_scaleIndex;
+	LegoU32 m_morphIndex;
+};
+
 // VTABLE: LEGO1 0x100db8c8
 // SIZE 0x34
 class LegoAnimNodeData : public LegoTreeNodeData {
@@ -161,6 +173,8 @@ class LegoAnimNodeData : public LegoTreeNodeData {
 	void SetName(LegoChar* p_name);
 	LegoResult CreateLocalTransform(LegoFloat p_time, Matrix4& p_matrix);
 	LegoBool GetVisibility(LegoFloat p_time);
+	LegoResult CreateLocalTransform(LegoFloat p_time, Matrix4& p_matrix, LegoAnimKeyCursor& p_cursor);
+	LegoBool GetVisibility(LegoFloat p_time, LegoAnimKeyCursor& p_cursor);
 
 	// FUNCTION: BETA10 0x100595d0
 	LegoChar* GetName() { return m_name; }
@@ -3,17 +3,88 @@
 #include "lego/legoomni/include/legovideomanager.h"
 #include "lego/legoomni/include/misc.h"
 #include "mxdirectx/mxdirect3d.h"
+#include "mxstring.h"
 #include "tgl/d3drm/impl.h"
 
 DECOMP_SIZE_ASSERT(LegoContainerInfo<LegoTexture>, 0x10);
 // DECOMP_SIZE_ASSERT(LegoContainer<LegoTexture>, 0x18);
-DECOMP_SIZE_ASSERT(LegoTextureContainer, 0x24);
+
+LegoTextureContainer::LegoTextureContainer()
+{
+	for (LegoU32 i = 0; i < c_numIdleBuckets; i++) {
+		m_idleBuckets[i] = -1;
+	}
+
+	m_hits = 0;
+	m_misses = 0;
+	m_created = 0;
+}
 
 // FUNCTION: LEGO1 0x10099870
 LegoTextureContainer::~LegoTextureContainer()
 {
 }
 
+LegoU32 LegoTextureContainer::GetIdleBucket(LegoU32 p_hash, LegoU32 p_width, LegoU32 p_height)
+{
+	return (p_hash ^ (p_width * 31) ^ (p_height * 17)) & (c_numIdleBuckets - 1);
+}
+
+void LegoTextureContainer::LinkIdle(LegoS32 p_slot)
+{
+	CachedTexture& entry = m_cached[p_slot];
+	LegoS32& head = m_idleBuckets[GetIdleBucket(entry.m_hash, entry.m_width, entry.m_height)];
+
+	entry.m_prevIdle = -1;
+	entry.m_nextIdle = head;
+	if (head != -1) {
+		m_cached[head].m_prevIdle = p_slot;
+	}
+	head = p_slot;
+}
+
+void LegoTextureContainer::UnlinkIdle(LegoS32 p_slot)
+{
+	CachedTexture& entry = m_cached[p_slot];
+
+	if (entry.m_prevIdle != -1) {
+		m_cached[entry.m_prevIdle].m_nextIdle = entry.m_nextIdle;
+	}
+	else {
+		m_idleBuckets[GetIdleBucket(entry.m_hash, entry.m_width, entry.m_height)] = entry.m_nextIdle;
+	}
+
+	if (entry.m_nextIdle != -1) {
+		m_cached[entry.m_nextIdle].m_prevIdle = entry.m_prevIdle;
+	}
+
+	entry.m_prevIdle = -1;
+	entry.m_nextIdle = -1;
+}
+
+void LegoTextureContainer::AddCached(LegoTextureInfo* p_textureInfo, LegoU32 p_hash, LegoU32 p_width, LegoU32 p_height)
+{
+	LegoS32 slot;
+	if (!m_freeSlots.empty()) {
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else {
+		slot = (LegoS32) m_cached.size();
+		m_cached.push_back(CachedTexture());
+	}
+
+	CachedTexture& entry = m_cached[slot];
+	entry.m_textureInfo = p_textureInfo;
+	entry.m_hash = p_hash;
+	entry.m_width = p_width;
+	entry.m_height = p_height;
+	entry.m_inUse = TRUE;
+	entry.m_prevIdle = -1;
+	entry.m_nextIdle = -1;
+	p_textureInfo->m_cacheSlot = slot;
+}
+
 // FUNCTION: LEGO1 0x100998e0
 LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 {
@@ -27,24 +98,27 @@ LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 		height = desc.dwHeight;
 	}
 
-	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
-		if ((*it).second == FALSE && (*it).first->m_texture->AddRef() != 0 && (*it).first->m_texture->Release() == 1) {
-			if (!strcmp((*it).first->m_name, p_textureInfo->m_name)) {
-				LPDIRECTDRAWSURFACE surface = (*it).first->m_surface;
-				memset(&newDesc, 0, sizeof(newDesc));
-				newDesc.dwSize = sizeof(newDesc);
-
-				if (surface->GetSurfaceDesc(&newDesc) == DD_OK) {
-					if (newDesc.dwWidth == width && newDesc.dwHeight == height) {
-						(*it).second = TRUE;
-						(*it).first->m_texture->AddRef();
-						return (*it).first;
-					}
-				}
-			}
+	LegoU32 hash = MxString::Hash(p_textureInfo->m_name);
+	LegoS32 slot = m_idleBuckets[GetIdleBucket(hash, width, height)];
+
+	while (slot != -1) {
+		CachedTexture& entry = m_cached[slot];
+
+		// Only reuse a texture that nothing but the cache holds on to
+		if (entry.m_hash == hash && entry.m_width == width && entry.m_height == height &&
+			!strcmp(entry.m_textureInfo->m_name, p_textureInfo->m_name) &&
+			entry.m_textureInfo->m_texture->AddRef() != 0 && entry.m_textureInfo->m_texture->Release() == 1) {
+			UnlinkIdle(slot);
+			entry.m_inUse = TRUE;
+			entry.m_textureInfo->m_texture->AddRef();
+			m_hits++;
+			return entry.m_textureInfo;
 		}
+
+		slot = entry.m_nextIdle;
 	}
 
+	m_misses++;
 	LegoTextureInfo* textureInfo = new LegoTextureInfo();
 
 	textureInfo->m_palette = p_textureInfo->m_palette;
@@ -85,7 +159,9 @@ LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 			}
 			else {
 				textureInfo->m_texture->SetAppData((LPD3DRM_APPDATA) textureInfo);
-				m_cached.push_back(LegoCachedTexture(textureInfo, TRUE));
+				textureInfo->TrackSurface(newDesc.dwWidth, newDesc.dwHeight);
+				AddCached(textureInfo, hash, newDesc.dwWidth, newDesc.dwHeight);
+				m_created++;
 
 				textureInfo->m_texture->AddRef();
 
@@ -110,21 +186,36 @@ void LegoTextureContainer::EraseCached(LegoTextureInfo* p_textureInfo)
 		return;
 	}
 
-#ifdef COMPAT_MODE
-	LegoCachedTextureList::iterator it;
-	for (it = m_cached.begin(); it != m_cached.end(); it++) {
-#else
-	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
-#endif
-		if ((*it).first == p_textureInfo) {
-			(*it).second = FALSE;
-
-			if (p_textureInfo->m_texture->Release() == TRUE) {
-				delete p_textureInfo;
-				m_cached.erase(it);
-			}
+	LegoS32 slot = p_textureInfo->m_cacheSlot;
+	if (slot < 0 || slot >= (LegoS32) m_cached.size() || m_cached[slot].m_textureInfo != p_textureInfo) {
+		return;
+	}
+
+	CachedTexture& entry = m_cached[slot];
+	if (entry.m_inUse) {
+		entry.m_inUse = FALSE;
+		LinkIdle(slot);
+	}
 
-			return;
+	if (p_textureInfo->m_texture->Release() == TRUE) {
+		UnlinkIdle(slot);
+		delete p_textureInfo;
+		entry.m_textureInfo = NULL;
+		m_freeSlots.push_back(slot);
+	}
+}
+
+void LegoTextureContainer::GetStats(Stats& p_stats)
+{
+	p_stats.m_hits = m_hits;
+	p_stats.m_misses = m_misses;
+	p_stats.m_created = m_created;
+	p_stats.m_cached = m_cached.size() - m_freeSlots.size();
+	p_stats.m_idle = 0;
+
+	for (LegoU32 i = 0; i < m_cached.size(); i++) {
+		if (m_cached[i].m_textureInfo != NULL && !m_cached[i].m_inUse) {
+			p_stats.m_idle++;
 		}
 	}
 }
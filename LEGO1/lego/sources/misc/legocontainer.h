@@ -3,6 +3,7 @@
 
 #include "compat.h"
 #include "decomp.h"
+#include "lego1_export.h"
 #include "legotexture.h"
 #include "legotypes.h"
 #include "mxstl/stlcompat.h"
@@ -110,20 +111,53 @@ class LegoContainer {
 // VTABLE: LEGO1 0x100d86d4
 // class LegoContainer<LegoTextureInfo>
 
-typedef pair<LegoTextureInfo*, BOOL> LegoCachedTexture;
-typedef list<LegoCachedTexture> LegoCachedTextureList;
-
 // VTABLE: LEGO1 0x100d86fc
 // SIZE 0x24
 class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 public:
+	struct Stats {
+		LegoU32 m_hits;    // GetCached calls that reused an idle texture
+		LegoU32 m_misses;  // GetCached calls that had to create one
+		LegoU32 m_created; // of those, the ones that succeeded
+		LegoU32 m_cached;  // textures currently in the cache
+		LegoU32 m_idle;    // of those, the ones not handed out
+	};
+
+	LegoTextureContainer();
 	~LegoTextureContainer() override;
 
 	LegoTextureInfo* GetCached(LegoTextureInfo* p_textureInfo);
 	void EraseCached(LegoTextureInfo* p_textureInfo);
 
+	LEGO1_EXPORT void GetStats(Stats& p_stats);
+
 protected:
-	LegoCachedTextureList m_cached; // 0x18
+	struct CachedTexture {
+		LegoTextureInfo* m_textureInfo; // NULL once the slot is free
+		LegoU32 m_hash;                 // of the name
+		LegoU32 m_width;
+		LegoU32 m_height;
+		LegoBool m_inUse;
+		LegoS32 m_prevIdle; // idle textures in the same bucket
+		LegoS32 m_nextIdle;
+	};
+
+	// Must be a power of two
+	static const LegoU32 c_numIdleBuckets = 256;
+
+	static LegoU32 GetIdleBucket(LegoU32 p_hash, LegoU32 p_width, LegoU32 p_height);
+	void LinkIdle(LegoS32 p_slot);
+	void UnlinkIdle(LegoS32 p_slot);
+	void AddCached(LegoTextureInfo* p_textureInfo, LegoU32 p_hash, LegoU32 p_width, LegoU32 p_height);
+
+	// Originally a list<pair<LegoTextureInfo*, BOOL>> that GetCached and EraseCached searched in full.
+	// Each LegoTextureInfo now knows its slot, and idle textures are chained per name hash and size.
+	vector<CachedTexture> m_cached;
+	vector<LegoS32> m_freeSlots;
+	LegoS32 m_idleBuckets[c_numIdleBuckets];
+	LegoU32 m_hits;
+	LegoU32 m_misses;
+	LegoU32 m_created;
 };
 
 // TEMPLATE: LEGO1 0x10059c50
@@ -169,9 +203,6 @@ class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 // TEMPLATE: LEGO1 0x1005a210
 // _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Erase
 
-// TEMPLATE: LEGO1 0x1005a250
-// list<pair<LegoTextureInfo *,int>,allocator<pair<LegoTextureInfo *,int> > >::~list<pair<LegoTextureInfo *,int>,allocator<pair<LegoTextureInfo *,int> > >
-
 // TEMPLATE: LEGO1 0x1005a2c0
 // map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::~map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >
 
@@ -187,9 +218,6 @@ class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 // SYNTHETIC: LEGO1 0x1005a580
 // LegoTextureContainer::`scalar deleting destructor'
 
-// TEMPLATE: LEGO1 0x1005a5a0
-// List<pair<LegoTextureInfo *,int> >::~List<pair<LegoTextureInfo *,int> >
-
 // TEMPLATE: LEGO1 0x1005b660
 // LegoContainer<LegoTextureInfo>::~LegoContainer<LegoTextureInfo>
 
@@ -2,12 +2,11 @@
 
 #include "decomp.h"
 
+#include <SDL3/SDL_atomic.h>
 #include <memory.h>
 #include <string.h>
 
 DECOMP_SIZE_ASSERT(LegoStorage, 0x08);
-DECOMP_SIZE_ASSERT(LegoMemory, 0x10);
-DECOMP_SIZE_ASSERT(LegoFile, 0x0c);
 
 // FUNCTION: LEGO1 0x10099080
 LegoMemory::LegoMemory(void* p_buffer, LegoU32 p_size) : LegoStorage()
@@ -15,12 +14,33 @@ LegoMemory::LegoMemory(void* p_buffer, LegoU32 p_size) : LegoStorage()
 	m_buffer = (LegoU8*) p_buffer;
 	m_position = 0;
 	m_size = p_size;
+	m_capacity = 0;
+}
+
+LegoMemory::LegoMemory() : LegoStorage()
+{
+	m_mode = c_write;
+	m_buffer = NULL;
+	m_position = 0;
+	m_size = 0;
+	m_capacity = 0;
+}
+
+LegoMemory::~LegoMemory()
+{
+	if (m_capacity) {
+		delete[] m_buffer;
+	}
 }
 
 // FUNCTION: LEGO1 0x10099160
 LegoResult LegoMemory::Read(void* p_buffer, LegoU32 p_size)
 {
-	assert(m_position + p_size <= m_size);
+	// Not in the original: a read past the end fails, as on a file, rather than run off the buffer
+	if (p_size > m_size - m_position) {
+		return FAILURE;
+	}
+
 	memcpy(p_buffer, m_buffer + m_position, p_size);
 	m_position += p_size;
 	return SUCCESS;
@@ -29,24 +49,60 @@ LegoResult LegoMemory::Read(void* p_buffer, LegoU32 p_size)
 // FUNCTION: LEGO1 0x10099190
 LegoResult LegoMemory::Write(const void* p_buffer, LegoU32 p_size)
 {
+	if (m_capacity || !m_buffer) {
+		if (m_position + p_size > m_capacity) {
+			LegoU32 capacity = m_capacity ? m_capacity : 4096;
+			while (capacity < m_position + p_size) {
+				capacity *= 2;
+			}
+
+			LegoU8* buffer = new LegoU8[capacity];
+			if (m_size) {
+				memcpy(buffer, m_buffer, m_size);
+			}
+
+			delete[] m_buffer;
+			m_buffer = buffer;
+			m_capacity = capacity;
+		}
+
+		memcpy(m_buffer + m_position, p_buffer, p_size);
+		m_position += p_size;
+
+		if (m_size < m_position) {
+			m_size = m_position;
+		}
+
+		return SUCCESS;
+	}
+
 	assert(m_position + p_size <= m_size);
 	memcpy(m_buffer + m_position, p_buffer, p_size);
 	m_position += p_size;
 	return SUCCESS;
 }
 
+// Not in the original. Atomic, so that files may be read and written on any thread.
+static SDL_AtomicInt g_numCalls;
+static SDL_AtomicInt g_numIOCalls;
+
 // FUNCTION: LEGO1 0x100991c0
 LegoFile::LegoFile()
 {
 	m_file = NULL;
+	m_buffer = NULL;
+	m_bufferSize = c_defaultBufferSize;
+	m_bufferStart = 0;
+	m_bufferFill = 0;
+	m_bufferPos = 0;
+	m_dirty = FALSE;
 }
 
 // FUNCTION: LEGO1 0x10099250
 LegoFile::~LegoFile()
 {
-	if (m_file) {
-		SDL_CloseIO(m_file);
-	}
+	Close();
+	delete[] m_buffer;
 }
 
 // FUNCTION: LEGO1 0x100992c0
@@ -55,9 +111,58 @@ LegoResult LegoFile::Read(void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (SDL_ReadIO(m_file, p_buffer, p_size) != p_size) {
+
+	SDL_AddAtomicInt(&g_numCalls, 1);
+
+	if (!p_size) {
+		return SUCCESS;
+	}
+
+	if (m_dirty && Sync() != SUCCESS) {
 		return FAILURE;
 	}
+
+	LegoU8* buffer = (LegoU8*) p_buffer;
+	LegoU32 available = m_bufferFill - m_bufferPos;
+
+	if (p_size <= available) {
+		memcpy(buffer, m_buffer + m_bufferPos, p_size);
+		m_bufferPos += p_size;
+		return SUCCESS;
+	}
+
+	if (available) {
+		memcpy(buffer, m_buffer + m_bufferPos, available);
+		buffer += available;
+		p_size -= available;
+	}
+
+	m_bufferStart += m_bufferFill;
+	m_bufferFill = 0;
+	m_bufferPos = 0;
+	SDL_AddAtomicInt(&g_numIOCalls, 1);
+
+	// Reads the buffer can't hold go straight to the caller
+	if (p_size >= m_bufferSize) {
+		LegoU32 read = (LegoU32) SDL_ReadIO(m_file, buffer, p_size);
+		m_bufferStart += read;
+		return read == p_size ? SUCCESS : FAILURE;
+	}
+
+	if (!m_buffer) {
+		m_buffer = new LegoU8[m_bufferSize];
+	}
+
+	m_bufferFill = (LegoU32) SDL_ReadIO(m_file, m_buffer, m_bufferSize);
+
+	if (m_bufferFill < p_size) {
+		memcpy(buffer, m_buffer, m_bufferFill);
+		m_bufferPos = m_bufferFill;
+		return FAILURE;
+	}
+
+	memcpy(buffer, m_buffer, p_size);
+	m_bufferPos = p_size;
 	return SUCCESS;
 }
 
@@ -67,9 +172,34 @@ LegoResult LegoFile::Write(const void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (SDL_WriteIO(m_file, p_buffer, p_size) != p_size) {
-		return FAILURE;
+
+	SDL_AddAtomicInt(&g_numCalls, 1);
+
+	if (!p_size) {
+		return SUCCESS;
+	}
+
+	if ((!m_dirty && m_bufferFill) || m_bufferPos + p_size > m_bufferSize) {
+		if (Sync() != SUCCESS) {
+			return FAILURE;
+		}
 	}
+
+	if (p_size >= m_bufferSize) {
+		SDL_AddAtomicInt(&g_numIOCalls, 1);
+		LegoU32 written = (LegoU32) SDL_WriteIO(m_file, p_buffer, p_size);
+		m_bufferStart += written;
+		return written == p_size ? SUCCESS : FAILURE;
+	}
+
+	if (!m_buffer) {
+		m_buffer = new LegoU8[m_bufferSize];
+	}
+
+	memcpy(m_buffer + m_bufferPos, p_buffer, p_size);
+	m_bufferPos += p_size;
+	m_bufferFill = m_bufferPos;
+	m_dirty = TRUE;
 	return SUCCESS;
 }
 
@@ -79,11 +209,7 @@ LegoResult LegoFile::GetPosition(LegoU32& p_position)
 	if (!m_file) {
 		return FAILURE;
 	}
-	Sint64 position = SDL_TellIO(m_file);
-	if (position == -1) {
-		return FAILURE;
-	}
-	p_position = position;
+	p_position = m_bufferStart + m_bufferPos;
 	return SUCCESS;
 }
 
@@ -93,18 +219,106 @@ LegoResult LegoFile::SetPosition(LegoU32 p_position)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (SDL_SeekIO(m_file, p_position, SDL_IO_SEEK_SET) != p_position) {
+
+	if (!m_dirty && p_position >= m_bufferStart && p_position - m_bufferStart <= m_bufferFill) {
+		m_bufferPos = p_position - m_bufferStart;
+		return SUCCESS;
+	}
+
+	if (m_dirty && Sync() != SUCCESS) {
+		return FAILURE;
+	}
+
+	SDL_AddAtomicInt(&g_numIOCalls, 1);
+	m_bufferFill = 0;
+	m_bufferPos = 0;
+
+	Sint64 position = SDL_SeekIO(m_file, p_position, SDL_IO_SEEK_SET);
+	if (position < 0) {
+		return FAILURE;
+	}
+
+	m_bufferStart = (LegoU32) position;
+	if (m_bufferStart != p_position) {
 		return FAILURE;
 	}
 	return SUCCESS;
 }
 
-// FUNCTION: LEGO1 0x100993a0
-LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
+// Empties the buffer, leaving the file at the position.
+// Writes are passed on, and read-ahead past the position is given back.
+LegoResult LegoFile::Sync()
+{
+	LegoResult result = SUCCESS;
+
+	if (m_dirty) {
+		SDL_AddAtomicInt(&g_numIOCalls, 1);
+		LegoU32 written = (LegoU32) SDL_WriteIO(m_file, m_buffer, m_bufferFill);
+		m_bufferStart += written;
+		m_dirty = FALSE;
+
+		if (written != m_bufferFill) {
+			result = FAILURE;
+		}
+	}
+	else if (m_bufferPos != m_bufferFill) {
+		SDL_AddAtomicInt(&g_numIOCalls, 1);
+		m_bufferStart += m_bufferPos;
+
+		if (SDL_SeekIO(m_file, m_bufferStart, SDL_IO_SEEK_SET) != m_bufferStart) {
+			result = FAILURE;
+		}
+	}
+	else {
+		m_bufferStart += m_bufferFill;
+	}
+
+	m_bufferFill = 0;
+	m_bufferPos = 0;
+	return result;
+}
+
+void LegoFile::Close()
 {
 	if (m_file) {
+		if (m_dirty) {
+			Sync();
+		}
+
 		SDL_CloseIO(m_file);
+		m_file = NULL;
 	}
+
+	m_bufferStart = 0;
+	m_bufferFill = 0;
+	m_bufferPos = 0;
+	m_dirty = FALSE;
+}
+
+LegoResult LegoFile::SetBufferSize(LegoU32 p_bufferSize)
+{
+	LegoResult result = SUCCESS;
+
+	if (m_file) {
+		result = Sync();
+	}
+
+	delete[] m_buffer;
+	m_buffer = NULL;
+	m_bufferSize = p_bufferSize;
+	return result;
+}
+
+void LegoFile::GetStats(Stats& p_stats)
+{
+	p_stats.m_calls = SDL_GetAtomicInt(&g_numCalls);
+	p_stats.m_ioCalls = SDL_GetAtomicInt(&g_numIOCalls);
+}
+
+// FUNCTION: LEGO1 0x100993a0
+LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
+{
+	Close();
 	char mode[4];
 	mode[0] = '\0';
 	if (p_mode & c_read) {
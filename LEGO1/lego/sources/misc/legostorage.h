@@ -1,6 +1,7 @@
 #ifndef __LEGOSTORAGE_H
 #define __LEGOSTORAGE_H
 
+#include "lego1_export.h"
 #include "legotypes.h"
 #include "mxgeometry/mxgeometry3d.h"
 #include "mxstring.h"
@@ -190,10 +191,14 @@ class LegoStorage {
 };
 
 // VTABLE: LEGO1 0x100db710
-// SIZE 0x10
 class LegoMemory : public LegoStorage {
 public:
 	LegoMemory(void* p_buffer, LegoU32 p_size);
+
+	// Not in the original. An image in write mode that owns its buffer and grows it as needed.
+	LegoMemory();
+	~LegoMemory() override;
+
 	LegoResult Read(void* p_buffer, LegoU32 p_size) override;        // vtable+0x04
 	LegoResult Write(const void* p_buffer, LegoU32 p_size) override; // vtable+0x08
 
@@ -207,13 +212,17 @@ class LegoMemory : public LegoStorage {
 	// FUNCTION: LEGO1 0x100994b0
 	LegoResult SetPosition(LegoU32 p_position) override // vtable+0x10
 	{
-		assert(p_position <= m_size);
+		// Not in the original: fails past the end rather than assert
+		if (p_position > m_size) {
+			return FAILURE;
+		}
+
 		m_position = p_position;
 		return SUCCESS;
 	}
 
-	// SYNTHETIC: LEGO1 0x10045a80
-	// LegoMemory::~LegoMemory
+	LegoU8* GetBuffer() { return m_buffer; }
+	LegoU32 GetSize() { return m_size; }
 
 	// SYNTHETIC: LEGO1 0x100990f0
 	// LegoMemory::`scalar deleting destructor'
@@ -222,12 +231,26 @@ class LegoMemory : public LegoStorage {
 	LegoU8* m_buffer;   // 0x04
 	LegoU32 m_position; // 0x08
 	LegoU32 m_size;
+	LegoU32 m_capacity; // Not in the original. Non-zero if the buffer is owned.
 };
 
+// Reads and writes go through a buffer, so that the many small reads of the
+// file formats become a few large ones. The buffer holds either data read ahead
+// of the position or data written but not yet passed on to the file, and seeking
+// within read-ahead data does not touch the file.
 // VTABLE: LEGO1 0x100db730
-// SIZE 0x0c
 class LegoFile : public LegoStorage {
 public:
+	// Not in the original
+	struct Stats {
+		LegoU32 m_calls;   // reads and writes made on files
+		LegoU32 m_ioCalls; // reads, writes and seeks passed on to SDL
+	};
+
+	enum {
+		c_defaultBufferSize = 64 * 1024
+	};
+
 	LegoFile();
 	~LegoFile() override;
 
@@ -237,11 +260,27 @@ class LegoFile : public LegoStorage {
 	LegoResult SetPosition(LegoU32 p_position) override;             // vtable+0x10
 	LegoResult Open(const char* p_name, LegoU32 p_mode);
 
+	// Not in the original. 0 passes every call straight to the file.
+	LegoResult SetBufferSize(LegoU32 p_bufferSize);
+
+	LEGO1_EXPORT static void GetStats(Stats& p_stats);
+
 	// SYNTHETIC: LEGO1 0x10099230
 	// LegoFile::`scalar deleting destructor'
 
 protected:
+	LegoResult Sync();
+	void Close();
+
 	SDL_IOStream* m_file; // 0x08
+
+	// Not in the original
+	LegoU8* m_buffer;
+	LegoU32 m_bufferSize;
+	LegoU32 m_bufferStart; // position in the file of the first byte in the buffer
+	LegoU32 m_bufferFill;  // bytes in the buffer
+	LegoU32 m_bufferPos;   // position in the buffer
+	LegoBool m_dirty;      // the buffer holds writes, not read-ahead
 };
 
 #endif // __LEGOSTORAGE_H
@@ -0,0 +1,62 @@
+#include "legoflatanim.h"
+
+#include "legoroi.h"
+#include "mxgeometry/mxmatrix.h"
+#include "realtime/mathkernel.h"
+
+LegoFlatAnim::LegoFlatAnim(LegoTreeNode* p_root, LegoBool p_includeRoot, LegoROI** p_roiMap)
+{
+	m_roiMap = p_roiMap;
+
+	if (p_includeRoot) {
+		AddNode(p_root, -1);
+	}
+	else {
+		for (LegoU32 i = 0; i < p_root->GetNumChildren(); i++) {
+			AddNode(p_root->GetChild(i), -1);
+		}
+	}
+}
+
+void LegoFlatAnim::AddNode(LegoTreeNode* p_node, LegoS32 p_parent)
+{
+	Node node;
+	node.m_data = (LegoAnimNodeData*) p_node->GetData();
+	node.m_parent = p_parent;
+	node.m_world = NULL;
+
+	LegoS32 index = m_nodes.size();
+	m_nodes.push_back(node);
+
+	for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
+		AddNode(p_node->GetChild(i), index);
+	}
+}
+
+void LegoFlatAnim::Evaluate(const Matrix4& p_matrix, LegoTime p_time, LegoBool p_updateWorldData)
+{
+	MxMatrix local;
+
+	for (std::vector<Node>::iterator it = m_nodes.begin(); it != m_nodes.end(); it++) {
+		Node& node = *it;
+		const float* parent = node.m_parent < 0 ? p_matrix[0] : m_nodes[node.m_parent].m_world;
+
+		local.SetIdentity();
+		node.m_data->CreateLocalTransform((LegoFloat) p_time, local, node.m_cursor);
+
+		LegoROI* roi = m_roiMap[node.m_data->GetROIIndex()];
+		if (roi != NULL) {
+			node.m_world = roi->m_local2world[0];
+			Mat4Product(node.m_world, local[0], parent);
+
+			if (p_updateWorldData) {
+				roi->UpdateWorldData();
+				roi->SetVisibility(node.m_data->GetVisibility((LegoFloat) p_time, node.m_cursor));
+			}
+		}
+		else {
+			node.m_world = node.m_local2world[0];
+			Mat4Product(node.m_world, local[0], parent);
+		}
+	}
+}
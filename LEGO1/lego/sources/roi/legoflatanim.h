@@ -0,0 +1,48 @@
+#ifndef LEGOFLATANIM_H
+#define LEGOFLATANIM_H
+
+#include "anim/legoanim.h"
+#include "misc/legotypes.h"
+
+#include <vector>
+
+class LegoROI;
+class Matrix4;
+
+// A LegoAnim tree flattened into an array and bound to a ROI map.
+// Nodes are stored depth-first, so every parent is evaluated before its
+// children and the whole hierarchy is applied in one linear pass instead of
+// recursing through LegoTreeNode. Key cursors are kept per instance rather than
+// in the shared LegoAnimNodeData, so actors playing the same animation at
+// different times no longer restart each other's key search every frame.
+// ROIs are looked up through the map on every pass, like the recursive version.
+class LegoFlatAnim {
+public:
+	// p_includeRoot is FALSE for callers that animate the root's children only
+	LegoFlatAnim(LegoTreeNode* p_root, LegoBool p_includeRoot, LegoROI** p_roiMap);
+
+	// Same result as LegoROI::FUN_100a8e80 on each top-level node
+	void ApplyAnimation(const Matrix4& p_matrix, LegoTime p_time) { Evaluate(p_matrix, p_time, TRUE); }
+
+	// Same result as LegoROI::FUN_100a8fd0 on each top-level node
+	void ApplyTransform(const Matrix4& p_matrix, LegoTime p_time) { Evaluate(p_matrix, p_time, FALSE); }
+
+	LegoROI** GetROIMap() { return m_roiMap; }
+
+private:
+	struct Node {
+		LegoAnimNodeData* m_data;
+		LegoS32 m_parent; // index into m_nodes, -1 for top-level nodes
+		LegoAnimKeyCursor m_cursor;
+		float* m_world;            // where this node's local2world ended up in the last pass
+		float m_local2world[4][4]; // used when the node has no ROI
+	};
+
+	void AddNode(LegoTreeNode* p_node, LegoS32 p_parent);
+	void Evaluate(const Matrix4& p_matrix, LegoTime p_time, LegoBool p_updateWorldData);
+
+	std::vector<Node> m_nodes;
+	LegoROI** m_roiMap;
+};
+
+#endif // LEGOFLATANIM_H
@@ -4,6 +4,7 @@
 #include "legoroi.h"
 #include "misc/legocontainer.h"
 #include "misc/legostorage.h"
+#include "mxmemorystats.h"
 #include "shape/legomesh.h"
 #include "tgl/d3drm/impl.h"
 
@@ -20,8 +21,33 @@ LPDIRECT3DRMMATERIAL g_unk0x101013d4 = NULL;
 // GLOBAL: LEGO1 0x101013dc
 const char* g_InhPrefix = "inh";
 
+LegoLODCache* g_lodCache = NULL;
+
 inline IDirect3DRM2* GetD3DRM(Tgl::Renderer* pRenderer);
 inline BOOL GetMeshData(IDirect3DRMMesh*& mesh, D3DRMGROUPINDEX& index, Tgl::Mesh* pMesh);
+inline LegoResult SkipData(LegoStorage* p_storage, LegoU32 p_size);
+inline void FreeCacheMeshes(LegoLODCache::Mesh* p_meshes, LegoU32 p_numMeshes, LegoBool p_owned);
+
+// Enables the renderer-ready mesh cache at p_cachePath, or disables it if NULL
+void LegoLOD::configureLegoLOD(const char* p_cachePath)
+{
+	delete g_lodCache;
+	g_lodCache = NULL;
+
+	if (p_cachePath != NULL) {
+		g_lodCache = new LegoLODCache();
+
+		if (g_lodCache->Open(p_cachePath) != SUCCESS) {
+			delete g_lodCache;
+			g_lodCache = NULL;
+		}
+	}
+}
+
+LegoLODCache* LegoLOD::GetCache()
+{
+	return g_lodCache;
+}
 
 // FUNCTION: LEGO1 0x100aa380
 LegoLOD::LegoLOD(Tgl::Renderer* p_renderer) : ViewLOD(p_renderer)
@@ -51,11 +77,17 @@ LegoLOD::~LegoLOD()
 
 	if (m_melems) {
 		delete[] m_melems;
+		MxMemoryStats::Remove(MxMemoryStats::e_lods, sizeof(*m_melems) * m_numMeshes);
 	}
 }
 
 // FUNCTION: LEGO1 0x100aa510
-LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, LegoStorage* p_storage)
+LegoResult LegoLOD::Read(
+	Tgl::Renderer* p_renderer,
+	LegoTextureContainer* p_textureContainer,
+	LegoStorage* p_storage,
+	const LegoLODCache::Key* p_cacheKey
+)
 {
 	float(*normals)[3] = NULL;
 	float(*vertices)[3] = NULL;
@@ -67,6 +99,8 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 	LegoU32(*polyIndices)[3] = NULL;
 	LegoU32(*textureIndices)[3] = NULL;
 	LegoTextureInfo* textureInfo = NULL;
+	LegoLODCache::Mesh* cacheMeshes = NULL;
+	LegoBool fromCache = FALSE;
 
 	LegoU32 i, indexBackwards, indexForwards, tempNumVertsAndNormals;
 	unsigned char paletteEntries[256];
@@ -94,10 +128,19 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 
 	m_melems = new Mesh[m_numMeshes];
 	memset(m_melems, 0, sizeof(*m_melems) * m_numMeshes);
+	MxMemoryStats::Add(MxMemoryStats::e_lods, sizeof(*m_melems) * m_numMeshes);
 
 	indexBackwards = m_numMeshes - 1;
 	indexForwards = 0;
 
+	if (p_cacheKey != NULL && g_lodCache != NULL) {
+		cacheMeshes = new LegoLODCache::Mesh[m_numMeshes];
+		memset(cacheMeshes, 0, sizeof(*cacheMeshes) * m_numMeshes);
+
+		// On a hit the source geometry is skipped and meshes are built from the cache
+		fromCache = g_lodCache->Find(*p_cacheKey, m_numMeshes, cacheMeshes);
+	}
+
 	if (p_storage->Read(&tempNumVertsAndNormals, sizeof(LegoU32)) != SUCCESS) {
 		goto done;
 	}
@@ -109,21 +152,26 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 		goto done;
 	}
 
-	if (numVerts > 0) {
+	if (fromCache) {
+		if (SkipData(p_storage, (numVerts * 3 + numNormals * 3 + numTextureVertices * 2) * sizeof(float)) != SUCCESS) {
+			goto done;
+		}
+	}
+	else if (numVerts > 0) {
 		vertices = new float[numVerts][sizeOfArray(*vertices)];
 		if (p_storage->Read(vertices, numVerts * 3 * sizeof(float)) != SUCCESS) {
 			goto done;
 		}
 	}
 
-	if (numNormals > 0) {
+	if (!fromCache && numNormals > 0) {
 		normals = new float[numNormals][sizeOfArray(*normals)];
 		if (p_storage->Read(normals, numNormals * 3 * sizeof(float)) != SUCCESS) {
 			goto done;
 		}
 	}
 
-	if (numTextureVertices > 0) {
+	if (!fromCache && numTextureVertices > 0) {
 		textureVertices = new float[numTextureVertices][sizeOfArray(*textureVertices)];
 		if (p_storage->Read(textureVertices, numTextureVertices * 2 * sizeof(float)) != SUCCESS) {
 			goto done;
@@ -145,16 +193,31 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			goto done;
 		}
 
-		polyIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*polyIndices)];
-		if (p_storage->Read(polyIndices, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
-			goto done;
+		if (fromCache) {
+			if (SkipData(p_storage, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
+				goto done;
+			}
+		}
+		else {
+			polyIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*polyIndices)];
+			if (p_storage->Read(polyIndices, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
+				goto done;
+			}
 		}
 
 		if (p_storage->Read(&numTextureIndices, sizeof(numTextureIndices)) != SUCCESS) {
 			goto done;
 		}
 
-		if (numTextureIndices > 0) {
+		if (fromCache) {
+			if (numTextureIndices > 0 &&
+				SkipData(p_storage, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
+				goto done;
+			}
+
+			textureIndices = NULL;
+		}
+		else if (numTextureIndices > 0) {
 			textureIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*textureIndices)];
 			if (p_storage->Read(textureIndices, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
 				goto done;
@@ -195,16 +258,61 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 			indexForwards++;
 		}
 
-		m_melems[meshIndex].m_tglMesh = m_meshBuilder->CreateMesh(
-			numPolys & USHRT_MAX,
-			numVertices & USHRT_MAX,
-			vertices,
-			normals,
-			textureVertices,
-			polyIndices,
-			textureIndices,
-			shadingModel
-		);
+		if (fromCache) {
+			if (cacheMeshes[i].m_numFaces != (numPolys & USHRT_MAX) ||
+				cacheMeshes[i].m_numVertices != (numVertices & USHRT_MAX)) {
+				goto done;
+			}
+
+			m_melems[meshIndex].m_tglMesh = m_meshBuilder->CreateMesh(
+				cacheMeshes[i].m_numFaces,
+				cacheMeshes[i].m_numVertices,
+				cacheMeshes[i].m_vertices,
+				cacheMeshes[i].m_faceIndices,
+				shadingModel
+			);
+		}
+		else if (cacheMeshes != NULL) {
+			Tgl::MeshVertex* expandedVertices = new Tgl::MeshVertex[numVertices & USHRT_MAX];
+			LegoU32* expandedFaceIndices = new LegoU32[(numPolys & USHRT_MAX) * 3];
+
+			cacheMeshes[i].m_numFaces = numPolys & USHRT_MAX;
+			cacheMeshes[i].m_numVertices = numVertices & USHRT_MAX;
+			cacheMeshes[i].m_vertices = expandedVertices;
+			cacheMeshes[i].m_faceIndices = expandedFaceIndices;
+
+			Tgl::ExpandMeshData(
+				numPolys & USHRT_MAX,
+				numVertices & USHRT_MAX,
+				vertices,
+				normals,
+				textureVertices,
+				polyIndices,
+				textureIndices,
+				expandedVertices,
+				expandedFaceIndices
+			);
+
+			m_melems[meshIndex].m_tglMesh = m_meshBuilder->CreateMesh(
+				numPolys & USHRT_MAX,
+				numVertices & USHRT_MAX,
+				expandedVertices,
+				expandedFaceIndices,
+				shadingModel
+			);
+		}
+		else {
+			m_melems[meshIndex].m_tglMesh = m_meshBuilder->CreateMesh(
+				numPolys & USHRT_MAX,
+				numVertices & USHRT_MAX,
+				vertices,
+				normals,
+				textureVertices,
+				polyIndices,
+				textureIndices,
+				shadingModel
+			);
+		}
 
 		if (m_melems[meshIndex].m_tglMesh == NULL) {
 			goto done;
@@ -269,6 +377,14 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 
 	m_meshOffset = indexForwards;
 
+	if (cacheMeshes != NULL) {
+		if (!fromCache) {
+			g_lodCache->Add(*p_cacheKey, m_numMeshes, cacheMeshes);
+		}
+
+		FreeCacheMeshes(cacheMeshes, m_numMeshes, !fromCache);
+	}
+
 	if (textureVertices != NULL) {
 		delete[] textureVertices;
 	}
@@ -300,6 +416,9 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 	if (textureIndices != NULL) {
 		delete[] textureIndices;
 	}
+	if (cacheMeshes != NULL) {
+		FreeCacheMeshes(cacheMeshes, m_numMeshes, !fromCache);
+	}
 
 	return FAILURE;
 }
@@ -311,6 +430,7 @@ LegoLOD* LegoLOD::Clone(Tgl::Renderer* p_renderer)
 
 	dupLod->m_meshBuilder = m_meshBuilder->Clone();
 	dupLod->m_melems = new Mesh[m_numMeshes];
+	MxMemoryStats::Add(MxMemoryStats::e_lods, sizeof(*m_melems) * m_numMeshes);
 
 	for (LegoU32 i = 0; i < m_numMeshes; i++) {
 		dupLod->m_melems[i].m_tglMesh = m_melems[i].m_tglMesh->ShallowClone(dupLod->m_meshBuilder);
@@ -408,3 +528,26 @@ inline IDirect3DRM2* GetD3DRM(Tgl::Renderer* pRenderer)
 {
 	return ((TglImpl::RendererImpl*) pRenderer)->ImplementationData();
 }
+
+inline LegoResult SkipData(LegoStorage* p_storage, LegoU32 p_size)
+{
+	LegoU32 position;
+
+	if (p_storage->GetPosition(position) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return p_storage->SetPosition(position + p_size);
+}
+
+inline void FreeCacheMeshes(LegoLODCache::Mesh* p_meshes, LegoU32 p_numMeshes, LegoBool p_owned)
+{
+	if (p_owned) {
+		for (LegoU32 i = 0; i < p_numMeshes; i++) {
+			delete[] p_meshes[i].m_vertices;
+			delete[] p_meshes[i].m_faceIndices;
+		}
+	}
+
+	delete[] p_meshes;
+}
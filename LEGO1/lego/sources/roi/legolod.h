@@ -1,6 +1,8 @@
 #ifndef LEGOLOD_H
 #define LEGOLOD_H
 
+#include "lego1_export.h"
+#include "legolodcache.h"
 #include "misc/legotypes.h"
 #include "viewmanager/viewlod.h"
 
@@ -27,7 +29,12 @@ class LegoLOD : public ViewLOD {
 	// FUNCTION: LEGO1 0x100aae80
 	float VTable0x10() override { return 0.0; } // vtable+0x10
 
-	LegoResult Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_textureContainer, LegoStorage* p_storage);
+	LegoResult Read(
+		Tgl::Renderer* p_renderer,
+		LegoTextureContainer* p_textureContainer,
+		LegoStorage* p_storage,
+		const LegoLODCache::Key* p_cacheKey = NULL
+	);
 	LegoLOD* Clone(Tgl::Renderer* p_renderer);
 	LegoResult SetColor(LegoFloat p_red, LegoFloat p_green, LegoFloat p_blue, LegoFloat p_alpha);
 	LegoResult SetTextureInfo(LegoTextureInfo* p_textureInfo);
@@ -37,6 +44,9 @@ class LegoLOD : public ViewLOD {
 
 	static LegoBool HasInhPrefix(const LegoChar* p_name);
 
+	LEGO1_EXPORT static void configureLegoLOD(const char* p_cachePath);
+	static LegoLODCache* GetCache();
+
 	// SYNTHETIC: LEGO1 0x100aa430
 	// LegoLOD::`scalar deleting destructor'
 
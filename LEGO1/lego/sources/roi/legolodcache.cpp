@@ -0,0 +1,279 @@
+#include "legolodcache.h"
+
+#include "mxmemorystats.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <string.h>
+#include <vector>
+
+#define LOD_CACHE_MAGIC 0x43444f4c  // "LODC"
+#define LOD_RECORD_MAGIC 0x52444f4c // "LODR"
+#define LOD_CACHE_VERSION 2
+
+struct LegoLODCacheHeader {
+	LegoU32 m_magic;
+	LegoU32 m_version;
+	LegoU32 m_vertexSize;
+};
+
+// Each record is followed by the part name, padded to four bytes, and then by
+// m_numMeshes times: numFaces, numVertices, vertices, face indices.
+struct LegoLODCacheRecord {
+	LegoU32 m_magic;
+	LegoU32 m_size; // including this header
+	LegoU32 m_sourceSize;
+	LegoU32 m_sourceHash;
+	LegoU32 m_lodIndex;
+	LegoU32 m_numMeshes;
+	LegoU32 m_nameLength;
+};
+
+inline LegoU32 Align4(LegoU32 p_size)
+{
+	return (p_size + 3) & ~3;
+}
+
+LegoLODCache::LegoLODCache()
+{
+	m_image = NULL;
+	m_imageSize = 0;
+	m_file = NULL;
+}
+
+LegoLODCache::~LegoLODCache()
+{
+	Close();
+}
+
+LegoResult LegoLODCache::Open(const char* p_path)
+{
+	Close();
+
+	size_t size = 0;
+	m_image = (LegoU8*) SDL_LoadFile(p_path, &size);
+
+	if (m_image != NULL) {
+		m_imageSize = size;
+		MxMemoryStats::Add(MxMemoryStats::e_lods, m_imageSize);
+	}
+
+	const LegoLODCacheHeader* header = (const LegoLODCacheHeader*) m_image;
+	Sint64 validEnd = 0;
+
+	if (m_image != NULL && size >= sizeof(LegoLODCacheHeader) && header->m_magic == LOD_CACHE_MAGIC &&
+		header->m_version == LOD_CACHE_VERSION && header->m_vertexSize == sizeof(Tgl::MeshVertex)) {
+		const LegoU8* end = m_image + size;
+		const LegoU8* record = m_image + sizeof(LegoLODCacheHeader);
+		const LegoU8* next;
+
+		while ((next = ParseRecord(record, end)) != NULL) {
+			record = next;
+		}
+
+		validEnd = record - m_image;
+	}
+
+	if (validEnd != 0) {
+		// Append after the last intact record, overwriting any torn write
+		m_file = SDL_IOFromFile(p_path, "r+b");
+
+		if (m_file != NULL && SDL_SeekIO(m_file, validEnd, SDL_IO_SEEK_SET) != validEnd) {
+			SDL_CloseIO(m_file);
+			m_file = NULL;
+		}
+	}
+	else {
+		m_records.clear();
+
+		if (m_image != NULL) {
+			MxMemoryStats::Remove(MxMemoryStats::e_lods, m_imageSize);
+			SDL_free(m_image);
+			m_image = NULL;
+		}
+
+		m_file = SDL_IOFromFile(p_path, "wb");
+
+		if (m_file != NULL) {
+			LegoLODCacheHeader newHeader = {LOD_CACHE_MAGIC, LOD_CACHE_VERSION, sizeof(Tgl::MeshVertex)};
+
+			if (SDL_WriteIO(m_file, &newHeader, sizeof(newHeader)) != sizeof(newHeader)) {
+				SDL_CloseIO(m_file);
+				m_file = NULL;
+			}
+		}
+	}
+
+	return m_image != NULL || m_file != NULL ? SUCCESS : FAILURE;
+}
+
+void LegoLODCache::Close()
+{
+	m_records.clear();
+
+	if (m_file != NULL) {
+		SDL_CloseIO(m_file);
+		m_file = NULL;
+	}
+
+	if (m_image != NULL) {
+		MxMemoryStats::Remove(MxMemoryStats::e_lods, m_imageSize);
+		SDL_free(m_image);
+		m_image = NULL;
+	}
+}
+
+const LegoU8* LegoLODCache::ParseRecord(const LegoU8* p_record, const LegoU8* p_end)
+{
+	const LegoLODCacheRecord* record = (const LegoLODCacheRecord*) p_record;
+
+	if ((size_t) (p_end - p_record) < sizeof(LegoLODCacheRecord) || record->m_magic != LOD_RECORD_MAGIC ||
+		record->m_size < sizeof(LegoLODCacheRecord) || record->m_size > (size_t) (p_end - p_record) ||
+		(record->m_size & 3) != 0) {
+		return NULL;
+	}
+
+	const LegoU8* recordEnd = p_record + record->m_size;
+	const LegoU8* data = p_record + sizeof(LegoLODCacheRecord);
+
+	if (Align4(record->m_nameLength) > (size_t) (recordEnd - data)) {
+		return NULL;
+	}
+
+	data += Align4(record->m_nameLength);
+
+	for (LegoU32 i = 0; i < record->m_numMeshes; i++) {
+		if ((size_t) (recordEnd - data) < 2 * sizeof(LegoU32)) {
+			return NULL;
+		}
+
+		LegoU32 numFaces = ((const LegoU32*) data)[0];
+		LegoU32 numVertices = ((const LegoU32*) data)[1];
+		size_t meshSize = numVertices * sizeof(Tgl::MeshVertex) + (size_t) numFaces * 3 * sizeof(LegoU32);
+
+		data += 2 * sizeof(LegoU32);
+		if (meshSize > (size_t) (recordEnd - data)) {
+			return NULL;
+		}
+
+		data += meshSize;
+	}
+
+	if (data != recordEnd) {
+		return NULL;
+	}
+
+	const LegoChar* name = (const LegoChar*) (p_record + sizeof(LegoLODCacheRecord));
+	m_records[IndexKey(name, record->m_nameLength, record->m_lodIndex, record->m_sourceHash)] = p_record;
+
+	return recordEnd;
+}
+
+LegoBool LegoLODCache::Find(const Key& p_key, LegoU32 p_numMeshes, Mesh* p_meshes)
+{
+	LegoU32 nameLength = strlen(p_key.m_partName);
+	std::map<LegoU32, const LegoU8*>::iterator it =
+		m_records.find(IndexKey(p_key.m_partName, nameLength, p_key.m_lodIndex, p_key.m_sourceHash));
+
+	if (it == m_records.end()) {
+		return FALSE;
+	}
+
+	const LegoLODCacheRecord* record = (const LegoLODCacheRecord*) it->second;
+	const LegoU8* data = it->second + sizeof(LegoLODCacheRecord);
+
+	if (record->m_sourceSize != p_key.m_sourceSize || record->m_sourceHash != p_key.m_sourceHash ||
+		record->m_lodIndex != p_key.m_lodIndex ||
+		record->m_numMeshes != p_numMeshes || record->m_nameLength != nameLength ||
+		memcmp(data, p_key.m_partName, record->m_nameLength)) {
+		return FALSE;
+	}
+
+	data += Align4(record->m_nameLength);
+
+	for (LegoU32 i = 0; i < p_numMeshes; i++) {
+		p_meshes[i].m_numFaces = ((const LegoU32*) data)[0];
+		p_meshes[i].m_numVertices = ((const LegoU32*) data)[1];
+		data += 2 * sizeof(LegoU32);
+
+		p_meshes[i].m_vertices = (const Tgl::MeshVertex*) data;
+		data += p_meshes[i].m_numVertices * sizeof(Tgl::MeshVertex);
+
+		p_meshes[i].m_faceIndices = (const LegoU32*) data;
+		data += p_meshes[i].m_numFaces * 3 * sizeof(LegoU32);
+	}
+
+	return TRUE;
+}
+
+void LegoLODCache::Add(const Key& p_key, LegoU32 p_numMeshes, const Mesh* p_meshes)
+{
+	if (m_file == NULL) {
+		return;
+	}
+
+	LegoU32 nameLength = strlen(p_key.m_partName);
+	LegoU32 size = sizeof(LegoLODCacheRecord) + Align4(nameLength);
+
+	for (LegoU32 i = 0; i < p_numMeshes; i++) {
+		size += 2 * sizeof(LegoU32) + p_meshes[i].m_numVertices * sizeof(Tgl::MeshVertex) +
+				p_meshes[i].m_numFaces * 3 * sizeof(LegoU32);
+	}
+
+	// Assemble the record first so that it reaches the file in a single write
+	std::vector<LegoU8> buffer(size);
+	LegoU8* data = &buffer[0];
+
+	LegoLODCacheRecord* record = (LegoLODCacheRecord*) data;
+	record->m_magic = LOD_RECORD_MAGIC;
+	record->m_size = size;
+	record->m_sourceSize = p_key.m_sourceSize;
+	record->m_sourceHash = p_key.m_sourceHash;
+	record->m_lodIndex = p_key.m_lodIndex;
+	record->m_numMeshes = p_numMeshes;
+	record->m_nameLength = nameLength;
+	data += sizeof(LegoLODCacheRecord);
+
+	memcpy(data, p_key.m_partName, nameLength);
+	data += Align4(nameLength);
+
+	for (LegoU32 i = 0; i < p_numMeshes; i++) {
+		((LegoU32*) data)[0] = p_meshes[i].m_numFaces;
+		((LegoU32*) data)[1] = p_meshes[i].m_numVertices;
+		data += 2 * sizeof(LegoU32);
+
+		memcpy(data, p_meshes[i].m_vertices, p_meshes[i].m_numVertices * sizeof(Tgl::MeshVertex));
+		data += p_meshes[i].m_numVertices * sizeof(Tgl::MeshVertex);
+
+		memcpy(data, p_meshes[i].m_faceIndices, p_meshes[i].m_numFaces * 3 * sizeof(LegoU32));
+		data += p_meshes[i].m_numFaces * 3 * sizeof(LegoU32);
+	}
+
+	if (SDL_WriteIO(m_file, &buffer[0], size) != size) {
+		// Stop adding to a cache that can no longer be written consistently
+		SDL_CloseIO(m_file);
+		m_file = NULL;
+	}
+}
+
+LegoU32 LegoLODCache::IndexKey(
+	const LegoChar* p_name,
+	LegoU32 p_nameLength,
+	LegoU32 p_lodIndex,
+	LegoU32 p_sourceHash
+)
+{
+	return Hash(p_name, p_nameLength) ^ (p_lodIndex * 0x9e3779b1) ^ p_sourceHash;
+}
+
+// FNV-1a
+LegoU32 LegoLODCache::Hash(const void* p_data, LegoU32 p_length)
+{
+	const LegoU8* data = (const LegoU8*) p_data;
+	LegoU32 hash = 2166136261u;
+
+	for (LegoU32 i = 0; i < p_length; i++) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+
+	return hash;
+}
@@ -0,0 +1,52 @@
+#ifndef LEGOLODCACHE_H
+#define LEGOLODCACHE_H
+
+#include "misc/legotypes.h"
+#include "tgl/tgl.h"
+
+#include <SDL3/SDL_iostream.h>
+#include <map>
+
+// On-disk cache of LegoLOD meshes in expanded, renderer-ready form.
+// Entries are appended the first time a LOD is read. On later runs the file
+// is loaded in one go and meshes are created straight from its contents.
+class LegoLODCache {
+public:
+	// Identifies one LOD of a part. m_sourceSize and m_sourceHash describe the data
+	// it was read from, and are stored and compared in full along with the name.
+	struct Key {
+		const LegoChar* m_partName;
+		LegoU32 m_lodIndex;
+		LegoU32 m_sourceSize;
+		LegoU32 m_sourceHash;
+	};
+
+	struct Mesh {
+		LegoU32 m_numFaces;
+		LegoU32 m_numVertices;
+		const Tgl::MeshVertex* m_vertices;
+		const LegoU32* m_faceIndices; // m_numFaces * 3
+	};
+
+	LegoLODCache();
+	~LegoLODCache();
+
+	LegoResult Open(const char* p_path);
+	void Close();
+
+	LegoBool Find(const Key& p_key, LegoU32 p_numMeshes, Mesh* p_meshes);
+	void Add(const Key& p_key, LegoU32 p_numMeshes, const Mesh* p_meshes);
+
+	static LegoU32 Hash(const void* p_data, LegoU32 p_length);
+
+private:
+	static LegoU32 IndexKey(const LegoChar* p_name, LegoU32 p_nameLength, LegoU32 p_lodIndex, LegoU32 p_sourceHash);
+	const LegoU8* ParseRecord(const LegoU8* p_record, const LegoU8* p_end);
+
+	LegoU8* m_image;
+	LegoU32 m_imageSize;
+	SDL_IOStream* m_file;
+	std::map<LegoU32, const LegoU8*> m_records;
+};
+
+#endif // LEGOLODCACHE_H
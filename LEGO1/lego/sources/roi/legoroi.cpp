@@ -5,6 +5,7 @@
 #include "misc/legocontainer.h"
 #include "misc/legostorage.h"
 #include "mxgeometry/mxgeometry4d.h"
+#include "realtime/mathkernel.h"
 #include "realtime/realtime.h"
 #include "shape/legobox.h"
 #include "shape/legosphere.h"
@@ -13,9 +14,6 @@
 #include <string.h>
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(LegoROI, 0x108)
-DECOMP_SIZE_ASSERT(TimeROI, 0x10c)
-
 // SIZE 0x14
 typedef struct {
 	const char* m_name;
@@ -408,7 +406,7 @@ LegoResult LegoROI::ApplyAnimationTransformation(
 
 	if (roi != NULL) {
 		CreateLocalTransform(data, p_time, mat);
-		roi->m_local2world.Product(mat, p_matrix);
+		Mat4Product(roi->m_local2world[0], mat[0], p_matrix[0]);
 		roi->UpdateWorldData();
 
 		LegoBool und = data->GetVisibility(p_time);
@@ -436,7 +434,7 @@ void LegoROI::FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 
 	LegoROI* roi = p_roiMap[data->GetROIIndex()];
 	if (roi != NULL) {
-		roi->m_local2world.Product(mat, p_matrix);
+		Mat4Product(roi->m_local2world[0], mat[0], p_matrix[0]);
 		roi->UpdateWorldData();
 
 		LegoBool und = data->GetVisibility(p_time);
@@ -448,7 +446,7 @@ void LegoROI::FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 	}
 	else {
 		MxMatrix local2world;
-		local2world.Product(mat, p_matrix);
+		Mat4Product(local2world[0], mat[0], p_matrix[0]);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8e80(p_node->GetChild(i), local2world, p_time, p_roiMap);
@@ -467,7 +465,7 @@ void LegoROI::FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 
 	LegoROI* roi = p_roiMap[data->GetROIIndex()];
 	if (roi != NULL) {
-		roi->m_local2world.Product(mat, p_matrix);
+		Mat4Product(roi->m_local2world[0], mat[0], p_matrix[0]);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8fd0(p_node->GetChild(i), roi->m_local2world, p_time, p_roiMap);
@@ -475,7 +473,7 @@ void LegoROI::FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 	}
 	else {
 		MxMatrix local2world;
-		local2world.Product(mat, p_matrix);
+		Mat4Product(local2world[0], mat[0], p_matrix[0]);
 
 		for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
 			FUN_100a8fd0(p_node->GetChild(i), local2world, p_time, p_roiMap);
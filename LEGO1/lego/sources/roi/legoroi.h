@@ -98,6 +98,7 @@ class LegoROI : public ViewROI {
 	LegoEntity* m_entity;    // 0x104
 
 	friend class DebugViewer;
+	friend class LegoFlatAnim;
 };
 
 // VTABLE: LEGO1 0x100dbea8
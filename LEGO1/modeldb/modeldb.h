@@ -2,16 +2,16 @@
 #define MODELDB_H
 
 #include "decomp.h"
+#include "misc/legostorage.h"
 #include "mxlist.h"
 #include "mxstring.h"
 #include "mxtypes.h"
 
-#include <SDL3/SDL_iostream.h>
 #include <SDL3/SDL_stdinc.h>
 
 // SIZE 0x18
 struct ModelDbPart {
-	MxResult Read(SDL_IOStream* p_file);
+	MxResult Read(LegoStorage* p_file);
 
 	MxString m_roiName;          // 0x00
 	undefined4 m_partDataLength; // 0x10
@@ -93,7 +93,7 @@ class ModelDbPartListCursor : public MxListCursor<ModelDbPart*> {
 // SIZE 0x38
 struct ModelDbModel {
 	void Free();
-	MxResult Read(SDL_IOStream* p_file);
+	MxResult Read(LegoStorage* p_file);
 
 	char* m_modelName;       // 0x00
 	MxU32 m_modelDataLength; // 0x04
@@ -114,7 +114,7 @@ struct ModelDbWorld {
 	undefined m_unk0x10[0x08];   // 0x10
 };
 
-MxResult ReadModelDbWorlds(SDL_IOStream* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds);
+MxResult ReadModelDbWorlds(LegoStorage* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds);
 void FreeModelDbWorlds(ModelDbWorld*& p_worlds, MxS32 p_numWorlds);
 
 #endif // MODELDB_H
@@ -2,10 +2,13 @@
 #define MXATOM_H
 
 #include "lego1_export.h"
+#include "mxcriticalsection.h"
 #include "mxstl/stlcompat.h"
 #include "mxstring.h"
 #include "mxtypes.h"
 
+#include <SDL3/SDL_atomic.h>
+
 // Counts the number of existing MxAtomId objects based
 // on the matching char* string. A <map> seems fit for purpose here:
 // We have an MxString as a key and MxU16 as the value.
@@ -15,7 +18,6 @@
 // Also: the increment/decrement methods suggest a custom type was used
 // for the combined key_value_pair, which doesn't seem possible with <map>.
 
-// SIZE 0x14
 class MxAtom {
 public:
 	// always inlined
@@ -23,7 +25,7 @@ class MxAtom {
 	MxAtom(const char* p_str)
 	{
 		m_key = p_str;
-		m_value = 0;
+		SDL_SetAtomicInt(&m_value, 0);
 	}
 
 	void Inc();
@@ -32,25 +34,17 @@ class MxAtom {
 	// FUNCTION: BETA10 0x101236d0
 	MxString& GetKey() { return m_key; }
 
+	// The folded key's hash, which MxAtomSet caches before publishing the atom
+	MxU32 GetHash() const { return m_key.GetHash(); }
+
 	// SYNTHETIC: BETA10 0x10124a50
 	// MxAtom::`scalar deleting destructor'
 
 private:
-	MxString m_key; // 0x00
-	MxU16 m_value;  // 0x10
-};
-
-struct MxAtomCompare {
-	// FUNCTION: LEGO1 0x100ad120
-	// FUNCTION: BETA10 0x10123980
-	int operator()(MxAtom* const& p_val0, MxAtom* const& p_val1) const
-	{
-		return strcmp(p_val0->GetKey().GetData(), p_val1->GetKey().GetData()) > 0;
-	}
+	MxString m_key;        // 0x00
+	SDL_AtomicInt m_value; // 0x10
 };
 
-class MxAtomSet : public set<MxAtom*, MxAtomCompare> {};
-
 enum LookupMode {
 	e_exact = 0,
 	e_lowerCase,
@@ -58,6 +52,40 @@ enum LookupMode {
 	e_lowerCase2,
 };
 
+// Originally a set<MxAtom*> ordered by key.
+// Open-addressed hash table keyed by the case-folded string. Atoms are never removed
+// before the table itself is destroyed, so lookups can probe it without taking a lock.
+// Only insertions are serialized. Tables that are outgrown are kept alive until
+// destruction, since a concurrent lookup may still be probing them.
+class MxAtomSet {
+public:
+	MxAtomSet();
+	~MxAtomSet();
+
+	MxAtom* Find(const char* p_str, LookupMode p_mode);
+	MxAtom* Intern(const char* p_str, LookupMode p_mode);
+
+	MxU32 GetCount() { return SDL_GetAtomicInt(&m_count); }
+
+	static MxU32 Hash(const char* p_str, LookupMode p_mode);
+
+private:
+	struct Table {
+		MxU32 m_mask;
+		void** m_slots;
+		Table* m_retired;
+	};
+
+	Table* CreateTable(MxU32 p_capacity);
+	Table* GetTable() { return (Table*) SDL_GetAtomicPointer(&m_table); }
+	MxAtom* Probe(Table* p_table, const char* p_str, LookupMode p_mode, MxU32 p_hash);
+	void Insert(Table* p_table, MxAtom* p_atom);
+
+	void* m_table;
+	SDL_AtomicInt m_count;
+	MxCriticalSection m_criticalSection;
+};
+
 // SIZE 0x04
 class MxAtomId {
 public:
@@ -111,125 +139,7 @@ class MxAtomId {
 // SYNTHETIC: LEGO1 0x100ad170
 // MxAtom::~MxAtom
 
-// clang-format off
-// TEMPLATE: LEGO1 0x100ad480
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::iterator::_Dec
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100ad780
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Lbound
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100ad4d0
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Insert
-// clang-format on
-
-// clang-format off
-// TEMPLATE: BETA10 0x101237a0
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::const_iterator::operator*
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100af6d0
-// TEMPLATE: BETA10 0x10131170
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::~_Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100af7a0
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::iterator::_Inc
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100af7e0
-// ?erase@?$_Tree@PAVMxAtom@@PAV1@U_Kfn@?$set@PAVMxAtom@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@QAE?AViterator@1@V21@@Z
-
-// TEMPLATE: BETA10 0x10131210
-// ?erase@?$_Tree@PAVMxAtom@@PAV1@U_Kfn@?$set@PAVMxAtom@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@QAE?AViterator@1@V21@0@Z
-// clang-format on
-
-// clang-format off
-// TEMPLATE: BETA10 0x10131460
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::size
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100afc40
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Erase
-// clang-format on
-
-// clang-format off
-// TEMPLATE: LEGO1 0x100afc80
-// TEMPLATE: BETA10 0x10132080
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::~set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >
-// clang-format on
-
-// TEMPLATE: LEGO1 0x100afe40
-// TEMPLATE: BETA10 0x101320e0
-// Set<MxAtom *,MxAtomCompare>::~Set<MxAtom *,MxAtomCompare>
-
-// TEMPLATE: BETA10 0x10132140
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::begin
-
-// clang-format off
-// GLOBAL: LEGO1 0x101013f0
-// GLOBAL: BETA10 0x10201264
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Nil
-// clang-format on
-
-// clang-format off
-// TEMPLATE: BETA10 0x10132170
-// ?begin@?$_Tree@PAVMxAtom@@PAV1@U_Kfn@?$set@PAVMxAtom@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@QAE?AViterator@1@XZ
-// Note: could also be
-// ?begin@?$_Tree@PAVMxAtom@@PAV1@U_Kfn@?$set@PAVMxAtom@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@UMxAtomCompare@@V?$allocator@PAVMxAtom@@@@@@QBE?AVconst_iterator@1@XZ
-// clang-format on
-
-// TEMPLATE: BETA10 0x101321d0
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::size
-
-// TEMPLATE: BETA10 0x101321f0
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::erase
-
-// TEMPLATE: BETA10 0x101237f0
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::end
-
-// TEMPLATE: BETA10 0x101238b0
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::find
-
-// clang-format off
-// TEMPLATE: BETA10 0x101238e0
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::find
-// clang-format on
-
 // SYNTHETIC: BETA10 0x10123bf0
 // MxAtom::~MxAtom
 
-// TEMPLATE: BETA10 0x10123c50
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::insert
-
-// SYNTHETIC: BETA10 0x10130fc0
-// MxAtomSet::MxAtomSet
-
-// TEMPLATE: BETA10 0x10131030
-// Set<MxAtom *,MxAtomCompare>::Set<MxAtom *,MxAtomCompare>
-
-// clang-format off
-// TEMPLATE: BETA10 0x101310a0
-// set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >
-
-// TEMPLATE: BETA10 0x10131120
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >
-
-// TEMPLATE: BETA10 0x10131f30
-// _Tree<MxAtom *,MxAtom *,set<MxAtom *,MxAtomCompare,allocator<MxAtom *> >::_Kfn,MxAtomCompare,allocator<MxAtom *> >::_Init
-// clang-format on
-
-// SYNTHETIC: BETA10 0x101322a0
-// MxAtomSet::`scalar deleting destructor'
-
-// SYNTHETIC: BETA10 0x101322e0
-// MxAtomSet::~MxAtomSet
-
 #endif // MXATOM_H
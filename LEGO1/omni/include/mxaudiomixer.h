@@ -0,0 +1,193 @@
+#ifndef MXAUDIOMIXER_H
+#define MXAUDIOMIXER_H
+
+#include "lego1_export.h"
+#include "mxcriticalsection.h"
+#include "mxprofiler.h"
+#include "mxtypes.h"
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_thread.h>
+#include <miniaudio.h>
+#include <vector>
+
+// Sits between the game and the miniaudio engine owned by MxSoundManager.
+// Sound and listener state is not changed from the game side directly. Instead
+// commands go through a fixed-size single-producer/single-consumer queue that
+// the mixer applies before each block it renders.
+//
+// With an audio device, a dedicated thread renders the engine ahead into a PCM
+// ring, and the device callback only copies out of that ring. Neither the game
+// nor the device callback ever waits on the mixer, and the mixer never takes a
+// lock the game holds. Without a device the mixer is headless: nothing is mixed
+// until Render is called, and commands posted before a Render take effect on
+// its first frame, which makes start and stop timing exact to the sample.
+//
+// Nothing is allocated while mixing: the ring is sized once from the device
+// buffer, and the engine's allocations go through callbacks that report any
+// made from the mixer thread, the device callback or Render. Allocations made
+// elsewhere while mixing are not checked.
+class MxAudioMixer {
+public:
+	struct Stats {
+		MxU32 m_commands;            // applied by the mixer
+		MxU32 m_blocks;              // rendered into the ring
+		MxU32 m_underruns;           // device reads the ring could not satisfy
+		MxU32 m_queueFull;           // posts that had to wait for the mixer
+		MxU32 m_realtimeAllocations; // engine allocations and frees while mixing
+	};
+
+	// Called for each engine allocation or free made while mixing. Debug builds assert by default.
+	typedef void (*AllocationHook)(size_t p_size);
+
+	MxAudioMixer();
+	~MxAudioMixer();
+
+	MxResult Create(ma_engine* p_engine, MxU32 p_ringSizeInFrames, MxBool p_headless);
+	void Destroy();
+
+	// For the engine config, before the engine is initialized
+	const ma_allocation_callbacks& GetAllocationCallbacks() { return m_allocationCallbacks; }
+	void SetAllocationHook(AllocationHook p_hook) { m_allocationHook = p_hook; }
+
+	// Reusable storage for the PCM rings of streaming presenters
+	MxU8* AcquireBuffer(MxU32 p_size);
+	void ReleaseBuffer(MxU8* p_buffer, MxU32 p_size);
+
+	// Game side. Start and SeekToPCMFrame return MA_SUCCESS once the command is queued.
+	ma_result Start(ma_sound* p_sound);
+	void Stop(ma_sound* p_sound);
+	ma_result SeekToPCMFrame(ma_sound* p_sound, ma_uint64 p_frame);
+	void SetVolume(ma_sound* p_sound, float p_volume);
+	void SetPitch(ma_sound* p_sound, float p_pitch);
+	void SetLooping(ma_sound* p_sound, ma_bool32 p_looping);
+	void SetPosition(ma_sound* p_sound, float p_x, float p_y, float p_z);
+	void SetMinDistance(ma_sound* p_sound, float p_distance);
+	void SetMaxDistance(ma_sound* p_sound, float p_distance);
+	void SetRolloff(ma_sound* p_sound, float p_rolloff);
+	void SetDopplerFactor(ma_sound* p_sound, float p_factor);
+	void SetSpatializationEnabled(ma_sound* p_sound, ma_bool32 p_enabled);
+	void SetListenerPosition(float p_x, float p_y, float p_z);
+	void SetListenerDirection(float p_x, float p_y, float p_z);
+	void SetListenerWorldUp(float p_x, float p_y, float p_z);
+	void SetListenerVelocity(float p_x, float p_y, float p_z);
+
+	// Commands posted between these reach the mixer together, so it never
+	// renders a block with only part of them applied. Batches may nest.
+	void BeginBatch();
+	void EndBatch();
+
+	// Answer as if every queued command had already been applied
+	MxBool IsPlaying(ma_sound* p_sound);
+	MxBool AtEnd(ma_sound* p_sound);
+
+	// Waits until no queued command refers to p_sound. Must be called before the sound is uninitialized.
+	void Flush(ma_sound* p_sound);
+
+	// Device callback side
+	void Read(SDL_AudioStream* p_stream, MxU32 p_frames);
+
+	// Headless only. Applies the queued commands, then mixes p_frames into p_out.
+	MxU32 Render(float* p_out, MxU32 p_frames);
+
+	// Headless only. Renders p_milliseconds of audio and drops it, standing in for a device.
+	LEGO1_EXPORT void Pump(MxU32 p_milliseconds);
+
+	MxBool IsHeadless() { return m_thread == NULL; }
+	LEGO1_EXPORT void GetStats(Stats& p_stats);
+
+private:
+	enum {
+		e_start,
+		e_stop,
+		e_seek,
+		e_volume,
+		e_pitch,
+		e_looping,
+		e_position,
+		e_minDistance,
+		e_maxDistance,
+		e_rolloff,
+		e_dopplerFactor,
+		e_spatialization,
+		e_listenerPosition,
+		e_listenerDirection,
+		e_listenerWorldUp,
+		e_listenerVelocity
+	};
+
+	struct FreeBuffer {
+		MxU32 m_size;
+		MxU8* m_buffer;
+	};
+
+	struct Command {
+		MxU32 m_type;
+		ma_sound* m_sound;
+		union {
+			float m_values[3];
+			ma_uint64 m_frame;
+			ma_bool32 m_flag;
+		};
+	};
+
+	// Must be a power of two
+	static const MxU32 c_queueSize = 1024;
+	static const MxU32 c_blockSizeInFrames = 256;
+
+	void Post(const Command& p_command);
+	void PostValues(MxU32 p_type, ma_sound* p_sound, float p_x, float p_y, float p_z);
+	MxBool IsPending(ma_sound* p_sound);
+	void WaitForMixer();
+	void ApplyCommands();
+	void Apply(const Command& p_command);
+	void FillRing();
+
+	void CheckAllocation(size_t p_size);
+
+	static int SDLCALL ThreadProc(void* p_mixer);
+	static void* OnMalloc(size_t p_size, void* p_mixer);
+	static void* OnRealloc(void* p_data, size_t p_size, void* p_mixer);
+	static void OnFree(void* p_data, void* p_mixer);
+
+	ma_engine* m_engine;
+	ma_pcm_rb m_ring;
+	MxBool m_ringInitialized;
+	SDL_Thread* m_thread;
+	SDL_Semaphore* m_wake;
+	SDL_AtomicInt m_quit;
+	MxProfilerReservation m_profilerReservation; // for the mixer thread, which must not allocate
+
+	// Written only by the producer and the consumer respectively. Slots between
+	// m_tail and m_pendingHead are never written while queued, so the game side
+	// can look through them for IsPlaying and AtEnd.
+	Command m_commands[c_queueSize];
+	SDL_AtomicInt m_head;
+	SDL_AtomicInt m_tail;
+
+	// Serializes the game side only; the mixer never enters it
+	MxCriticalSection m_postLock;
+	MxU32 m_pendingHead; // m_head once the current batch is published
+	MxU32 m_batchDepth;
+
+	SDL_AtomicInt m_numCommands;
+	SDL_AtomicInt m_numBlocks;
+	SDL_AtomicInt m_numUnderruns;
+	SDL_AtomicInt m_numQueueFull;
+	SDL_AtomicInt m_numRealtimeAllocations;
+
+	ma_allocation_callbacks m_allocationCallbacks;
+	AllocationHook m_allocationHook;
+
+	std::vector<FreeBuffer> m_freeBuffers;
+	MxCriticalSection m_bufferLock;
+
+	// Pump keeps the frames it renders in step with the milliseconds it is given
+	MxU64 m_pumpedMilliseconds;
+	MxU64 m_pumpedFrames;
+	std::vector<float> m_pumpBuffer;
+};
+
+#endif // MXAUDIOMIXER_H
@@ -9,6 +9,7 @@ class MxDSAction;
 class MxDSStreamingAction;
 class MxStreamChunk;
 class MxDSChunk;
+class MxSharedBuffer;
 
 // VTABLE: LEGO1 0x100dcca0
 // VTABLE: BETA10 0x101c2898
@@ -55,6 +56,7 @@ class MxDSBuffer : public MxCore {
 		MxStreamChunk* p_header
 	);
 	MxU8* SkipToData();
+	void SetSharedBuffer(MxSharedBuffer* p_sharedBuffer);
 	MxU8 ReleaseRef(MxDSChunk*);
 	void AddRef(MxDSChunk* p_chunk);
 	MxResult CalcBytesRemaining(MxU8* p_data);
@@ -83,6 +85,8 @@ class MxDSBuffer : public MxCore {
 	// FUNCTION: BETA10 0x101590d0
 	MxU32 GetBytesRemaining() { return m_bytesRemaining; }
 
+	MxSharedBuffer* GetSharedBuffer() { return m_sharedBuffer; }
+
 	void SetUnknown14(undefined4 p_unk0x14) { m_unk0x14 = p_unk0x14; }
 	void SetUnknown1c(undefined4 p_unk0x1c) { m_unk0x1c = p_unk0x1c; }
 
@@ -107,6 +111,8 @@ class MxDSBuffer : public MxCore {
 	MxU32 m_writeOffset;            // 0x28
 	MxU32 m_bytesRemaining;         // 0x2c
 	MxDSStreamingAction* m_unk0x30; // 0x30
+	MxSharedBuffer* m_sharedBuffer;
+	MxU32 m_heapSize; // allocated by AllocateBuffer, under MxMemoryStats::e_streamBuffers
 };
 
 #endif // MXDSBUFFER_H
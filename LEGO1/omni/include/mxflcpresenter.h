@@ -43,6 +43,8 @@ class MxFlcPresenter : public MxVideoPresenter {
 	// MxFlcPresenter::`scalar deleting destructor'
 
 protected:
+	void UnionFrameRects(MxU8* p_rects, MxS32 p_rectCount, MxRect32& p_bounds, MxBool p_grow) const;
+
 	FLIC_HEADER* m_flcHeader; // 0x64
 };
 
@@ -2,6 +2,7 @@
 #define MXMEDIAPRESENTER_H
 
 #include "decomp.h"
+#include "lego1_export.h"
 #include "mxpresenter.h"
 #include "mxstreamchunklist.h"
 
@@ -53,6 +54,8 @@ class MxMediaPresenter : public MxPresenter {
 	MxStreamChunk* CurrentChunk();
 	MxStreamChunk* NextChunk();
 
+	LEGO1_EXPORT static MxU32 GetLoopBytesShared();
+
 	// SYNTHETIC: LEGO1 0x1000c680
 	// MxMediaPresenter::`scalar deleting destructor'
 
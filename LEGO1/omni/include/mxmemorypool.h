@@ -2,28 +2,87 @@
 #define MXMEMORYPOOL_H
 
 #include "decomp.h"
+#include "mxautolock.h"
 #include "mxbitset.h"
+#include "mxcriticalsection.h"
 #include "mxdebug.h"
+#include "mxmemorystats.h"
 #include "mxtypes.h"
 
+#include <SDL3/SDL_atomic.h>
 #include <assert.h>
 
+struct MxMemoryPoolStats {
+	MxU32 m_blockSize; // in KB
+	MxU32 m_numBlocks;
+	MxU32 m_numSlabs;
+	MxU32 m_used;
+	MxU32 m_highWater;
+	MxU32 m_misses;
+};
+
+// Pool of blocks of BS KB, allocated in slabs of NB blocks.
+// Originally this scanned an MxBitset<NB> for a free block. Free blocks are now kept
+// on a lock-free stack of block indices, so Get and Release are O(1) and may be called
+// from the disk provider thread. The top of the stack is tagged to avoid ABA problems.
+// When the pool runs dry, it may grow by up to p_maxSlabs - 1 additional slabs.
 template <size_t BS, size_t NB>
 class MxMemoryPool {
 public:
-	MxMemoryPool() : m_pool(NULL), m_blockSize(BS) {}
-	~MxMemoryPool() { delete[] m_pool; }
+	MxMemoryPool(MxU32 p_maxSlabs = 1) : m_pool(NULL), m_blockSize(BS), m_maxSlabs(p_maxSlabs)
+	{
+		assert(m_maxSlabs > 0 && m_maxSlabs <= e_maxSlabs);
+
+		for (MxU32 i = 0; i < e_maxSlabs; i++) {
+			m_slabs[i] = NULL;
+		}
+
+		SDL_SetAtomicInt(&m_head, e_none);
+		SDL_SetAtomicInt(&m_numSlabs, 0);
+		SDL_SetAtomicInt(&m_used, 0);
+		SDL_SetAtomicInt(&m_highWater, 0);
+		SDL_SetAtomicInt(&m_misses, 0);
+	}
+
+	~MxMemoryPool()
+	{
+		for (MxU32 i = 0; i < e_maxSlabs; i++) {
+			if (m_slabs[i]) {
+				MxMemoryStats::Remove(MxMemoryStats::e_memoryPools, GetSlabSize());
+			}
+
+			delete[] (MxU8*) m_slabs[i];
+		}
+	}
 
 	MxResult Allocate();
 	MxU8* Get();
 	void Release(MxU8*);
 
-	MxU32 GetPoolSize() const { return m_blockRef.Size(); }
+	MxU32 GetPoolSize() const { return NB; }
+	void GetStats(MxMemoryPoolStats& p_stats);
 
 private:
+	enum {
+		e_maxSlabs = 8,
+		e_none = 0xffff
+	};
+
+	MxU32 GetSlabSize() const { return GetPoolSize() * m_blockSize * 1024; }
+	MxBool Grow();
+	void Push(MxU32 p_index);
+
 	MxU8* m_pool;            // 0x00
 	MxU32 m_blockSize;       // 0x04
-	MxBitset<NB> m_blockRef; // 0x08
+	MxU32 m_maxSlabs;
+	void* m_slabs[e_maxSlabs];
+	SDL_AtomicInt m_numSlabs;
+	SDL_AtomicInt m_next[e_maxSlabs * NB];
+	SDL_AtomicInt m_head; // tag << 16 | index
+	SDL_AtomicInt m_used;
+	SDL_AtomicInt m_highWater;
+	SDL_AtomicInt m_misses;
+	MxCriticalSection m_criticalSection;
 };
 
 template <size_t BS, size_t NB>
@@ -31,32 +90,90 @@ MxResult MxMemoryPool<BS, NB>::Allocate()
 {
 	assert(m_pool == NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
+	assert(GetPoolSize());
 
-	m_pool = new MxU8[GetPoolSize() * m_blockSize * 1024];
+	Grow();
+	m_pool = (MxU8*) m_slabs[0];
 	assert(m_pool);
 
 	return m_pool ? SUCCESS : FAILURE;
 }
 
+// Adds a slab and pushes its blocks onto the free stack. Called with m_criticalSection held.
+template <size_t BS, size_t NB>
+MxBool MxMemoryPool<BS, NB>::Grow()
+{
+	MxU32 slab = SDL_GetAtomicInt(&m_numSlabs);
+
+	if (slab >= m_maxSlabs) {
+		return FALSE;
+	}
+
+	MxU8* data = new MxU8[GetSlabSize()];
+	if (!data) {
+		return FALSE;
+	}
+
+	MxMemoryStats::Add(MxMemoryStats::e_memoryPools, GetSlabSize());
+	SDL_SetAtomicPointer(&m_slabs[slab], data);
+	SDL_SetAtomicInt(&m_numSlabs, slab + 1);
+
+	for (MxS32 i = GetPoolSize() - 1; i >= 0; i--) {
+		Push(slab * GetPoolSize() + i);
+	}
+
+	return TRUE;
+}
+
+template <size_t BS, size_t NB>
+void MxMemoryPool<BS, NB>::Push(MxU32 p_index)
+{
+	MxU32 head;
+
+	do {
+		head = SDL_GetAtomicInt(&m_head);
+		SDL_SetAtomicInt(&m_next[p_index], head & 0xffff);
+	} while (!SDL_CompareAndSwapAtomicInt(&m_head, head, ((head + 0x10000) & 0xffff0000) | p_index));
+}
+
 template <size_t BS, size_t NB>
 MxU8* MxMemoryPool<BS, NB>::Get()
 {
 	assert(m_pool != NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
+	assert(GetPoolSize());
+
+	for (;;) {
+		MxU32 head = SDL_GetAtomicInt(&m_head);
+		MxU32 index = head & 0xffff;
 
-	for (MxU32 i = 0; i < GetPoolSize(); i++) {
-		if (!m_blockRef[i]) {
-			m_blockRef[i].Flip();
+		if (index == e_none) {
+			AUTOLOCK(m_criticalSection);
 
-			MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+			// Another thread may have grown the pool or released a block in the meantime
+			if ((SDL_GetAtomicInt(&m_head) & 0xffff) == e_none && !Grow()) {
+				SDL_AddAtomicInt(&m_misses, 1);
+				return NULL;
+			}
 
-			return &m_pool[i * m_blockSize * 1024];
+			continue;
 		}
-	}
 
-	return NULL;
+		MxU32 next = SDL_GetAtomicInt(&m_next[index]);
+		if (SDL_CompareAndSwapAtomicInt(&m_head, head, ((head + 0x10000) & 0xffff0000) | next)) {
+			MxS32 used = SDL_AddAtomicInt(&m_used, 1) + 1;
+			MxS32 highWater;
+
+			do {
+				highWater = SDL_GetAtomicInt(&m_highWater);
+			} while (used > highWater && !SDL_CompareAndSwapAtomicInt(&m_highWater, highWater, used));
+
+			MxTrace("Get> %d pool: busy %d blocks\n", m_blockSize, used);
+
+			MxU8* slab = (MxU8*) SDL_GetAtomicPointer(&m_slabs[index / GetPoolSize()]);
+			return &slab[(index % GetPoolSize()) * m_blockSize * 1024];
+		}
+	}
 }
 
 template <size_t BS, size_t NB>
@@ -64,18 +181,37 @@ void MxMemoryPool<BS, NB>::Release(MxU8* p_buf)
 {
 	assert(m_pool != NULL);
 	assert(m_blockSize);
-	assert(m_blockRef.Size());
+	assert(GetPoolSize());
+
+	MxU32 numSlabs = SDL_GetAtomicInt(&m_numSlabs);
+
+	for (MxU32 slab = 0; slab < numSlabs; slab++) {
+		MxU8* data = (MxU8*) SDL_GetAtomicPointer(&m_slabs[slab]);
 
-	MxU32 i = (MxU32) (p_buf - m_pool) / (m_blockSize * 1024);
+		if (p_buf >= data && p_buf < data + GetSlabSize()) {
+			MxU32 i = (MxU32) (p_buf - data) / (m_blockSize * 1024);
+			assert(i < GetPoolSize());
 
-	assert(i >= 0 && i < GetPoolSize());
-	assert(m_blockRef[i]);
+			Push(slab * GetPoolSize() + i);
+			SDL_AddAtomicInt(&m_used, -1);
 
-	if (m_blockRef[i]) {
-		m_blockRef[i].Flip();
+			MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, SDL_GetAtomicInt(&m_used));
+			return;
+		}
 	}
 
-	MxTrace("Release> %d pool: busy %d blocks\n", m_blockSize, m_blockRef.Count());
+	assert("Block does not belong to memory pool" == NULL);
+}
+
+template <size_t BS, size_t NB>
+void MxMemoryPool<BS, NB>::GetStats(MxMemoryPoolStats& p_stats)
+{
+	p_stats.m_blockSize = m_blockSize;
+	p_stats.m_numSlabs = SDL_GetAtomicInt(&m_numSlabs);
+	p_stats.m_numBlocks = p_stats.m_numSlabs * GetPoolSize();
+	p_stats.m_used = SDL_GetAtomicInt(&m_used);
+	p_stats.m_highWater = SDL_GetAtomicInt(&m_highWater);
+	p_stats.m_misses = SDL_GetAtomicInt(&m_misses);
 }
 
 // TEMPLATE: BETA10 0x101464a0
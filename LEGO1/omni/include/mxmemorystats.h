@@ -0,0 +1,48 @@
+#ifndef MXMEMORYSTATS_H
+#define MXMEMORYSTATS_H
+
+#include "lego1_export.h"
+#include "mxtypes.h"
+
+// Bytes held by the large owners of game data, each under its own tag, to
+// tell whether a world transition leaks or grows memory. Owners report what
+// they allocate and free; the tags do not overlap.
+//
+// Counting is thread-safe: stream buffers and pools are allocated on the disk
+// provider thread. Update, called once a frame, logs one line with the live
+// bytes and allocation rate of every tag when a log interval is set.
+class MxMemoryStats {
+public:
+	enum Tag {
+		e_streamBuffers, // MxDSBuffer data outside the pools, and files loaded by the RAM stream provider
+		e_memoryPools,   // slabs of the streamer's block pools
+		e_textures,      // texture surfaces
+		e_meshes,        // miniwin mesh vertices and indices
+		e_sounds,        // cached sound data
+		e_lods,          // LegoLOD mesh tables and the LOD cache image
+		e_numTags
+	};
+
+	struct Counters {
+		MxS64 m_live; // bytes
+		MxS64 m_peak; // bytes
+		MxU32 m_allocations;
+		MxU32 m_frees;
+	};
+
+	static void Add(Tag p_tag, MxU32 p_size);
+	static void Remove(Tag p_tag, MxU32 p_size);
+
+	LEGO1_EXPORT static void Get(Tag p_tag, Counters& p_counters);
+	LEGO1_EXPORT static const char* GetName(Tag p_tag);
+
+	// 0 turns logging off
+	LEGO1_EXPORT static void SetLogInterval(MxU32 p_milliseconds);
+	LEGO1_EXPORT static void Update();
+	LEGO1_EXPORT static void Log();
+
+	// Matches MiniwinMemoryCallback, to hand to the miniwin device
+	LEGO1_EXPORT static void MiniwinCallback(int p_delta);
+};
+
+#endif // MXMEMORYSTATS_H
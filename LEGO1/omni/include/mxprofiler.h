@@ -0,0 +1,96 @@
+#ifndef MXPROFILER_H
+#define MXPROFILER_H
+
+#include "lego1_export.h"
+#include "mxtypes.h"
+
+#include <SDL3/SDL_atomic.h>
+
+class MxProfilerReservation;
+
+// Records how long named phases of a frame ("zones") take on every thread, to
+// be viewed as a timeline in chrome://tracing or Perfetto. Zones nest, and the
+// names must be string literals or otherwise live as long as the process.
+//
+// Profiling is off by default, and a zone then costs a single atomic load.
+// Each thread records into its own ring buffer that keeps its most recent
+// events, so recording never blocks on another thread for long and only
+// allocates for the first zone on a thread. Threads that must not allocate at
+// all record into a buffer reserved for them, see MxProfilerReservation.
+// WriteTrace dumps all buffers in the Chrome trace-event JSON format, and can
+// be called at any time or at exit.
+class MxProfiler {
+public:
+	// Must be called from the main thread. Other threads pick up the change on their next zone.
+	LEGO1_EXPORT static void Enable(MxBool p_enable);
+	static MxBool IsEnabled() { return SDL_GetAtomicInt(&g_enabled) != 0; }
+
+	static void Begin(const char* p_name);
+	static void End();
+
+	// Forgets every recorded event
+	LEGO1_EXPORT static void Reset();
+	LEGO1_EXPORT static MxResult WriteTrace(const char* p_path);
+
+	// Matches MiniwinProfileCallback, to hand to the miniwin device
+	LEGO1_EXPORT static bool MiniwinCallback(const char* p_name, bool p_begin);
+
+private:
+	friend class MxProfileZone;
+
+	static void UseReservation(MxProfilerReservation* p_reservation);
+
+	LEGO1_EXPORT static SDL_AtomicInt g_enabled;
+};
+
+// Sets a buffer aside for a thread that must not allocate, such as the audio
+// device's. The buffer is allocated here, or by MxProfiler::Enable while
+// profiling is off, so that zones given the reservation only have to use it.
+// One thread at a time records into it, and it outlives the reservation so
+// that its events still make it into the trace. Must be created and destroyed
+// on the main thread.
+class MxProfilerReservation {
+public:
+	LEGO1_EXPORT MxProfilerReservation();
+	LEGO1_EXPORT ~MxProfilerReservation();
+
+private:
+	friend class MxProfiler;
+
+	void* m_buffer; // set by the main thread, read atomically by the one recording
+	MxProfilerReservation* m_next;
+};
+
+// Times its own scope when profiling is enabled
+class MxProfileZone {
+public:
+	MxProfileZone(const char* p_name)
+	{
+		m_active = MxProfiler::IsEnabled();
+		if (m_active) {
+			MxProfiler::Begin(p_name);
+		}
+	}
+
+	// Records into p_reservation's buffer, so that the zone never allocates
+	MxProfileZone(const char* p_name, MxProfilerReservation* p_reservation)
+	{
+		m_active = MxProfiler::IsEnabled();
+		if (m_active) {
+			MxProfiler::UseReservation(p_reservation);
+			MxProfiler::Begin(p_name);
+		}
+	}
+
+	~MxProfileZone()
+	{
+		if (m_active) {
+			MxProfiler::End();
+		}
+	}
+
+private:
+	MxBool m_active;
+};
+
+#endif // MXPROFILER_H
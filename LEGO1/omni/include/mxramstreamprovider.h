@@ -3,6 +3,8 @@
 
 #include "mxstreamprovider.h"
 
+class MxSharedBuffer;
+
 // VTABLE: LEGO1 0x100dd0d0
 // VTABLE: BETA10 0x101c2ca8
 // SIZE 0x24
@@ -32,6 +34,7 @@ class MxRAMStreamProvider : public MxStreamProvider {
 	MxU32* GetBufferForDWords() override;                               // vtable+0x28
 
 	MxU8* GetBufferOfFileSize() { return m_pBufferOfFileSize; }
+	MxSharedBuffer* GetSharedBuffer() { return m_sharedBuffer; }
 
 protected:
 	MxU32 m_bufferSize;        // 0x10
@@ -39,6 +42,7 @@ class MxRAMStreamProvider : public MxStreamProvider {
 	MxU8* m_pBufferOfFileSize; // 0x18
 	MxU32 m_lengthInDWords;    // 0x1c
 	MxU32* m_bufferForDWords;  // 0x20
+	MxSharedBuffer* m_sharedBuffer;
 };
 
 // SYNTHETIC: LEGO1 0x100d0a30
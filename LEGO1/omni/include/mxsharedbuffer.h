@@ -0,0 +1,53 @@
+#ifndef MXSHAREDBUFFER_H
+#define MXSHAREDBUFFER_H
+
+#include "mxmemorystats.h"
+#include "mxtypes.h"
+
+#include <SDL3/SDL_atomic.h>
+
+// Reference counted block of stream data that is no longer written to once it
+// has been handed out. Chunks parsed from a MxDSBuffer backed by one of these
+// can keep their payload alive after the buffer and its stream are gone.
+class MxSharedBuffer {
+public:
+	MxSharedBuffer(MxU32 p_size, MxMemoryStats::Tag p_tag)
+	{
+		m_data = new MxU8[p_size];
+		m_size = p_size;
+		m_tag = p_tag;
+		SDL_SetAtomicInt(&m_refCount, 1);
+		MxMemoryStats::Add(m_tag, m_size);
+	}
+
+	void AddRef() { SDL_AddAtomicInt(&m_refCount, 1); }
+
+	void Release()
+	{
+		if (SDL_AddAtomicInt(&m_refCount, -1) == 1) {
+			delete this;
+		}
+	}
+
+	MxBool Contains(const MxU8* p_data, MxU32 p_length) const
+	{
+		return p_data >= m_data && p_length <= m_size && p_data - m_data <= (ptrdiff_t) (m_size - p_length);
+	}
+
+	MxU8* GetData() { return m_data; }
+	MxU32 GetSize() const { return m_size; }
+
+private:
+	~MxSharedBuffer()
+	{
+		delete[] m_data;
+		MxMemoryStats::Remove(m_tag, m_size);
+	}
+
+	MxU8* m_data;
+	MxU32 m_size;
+	MxMemoryStats::Tag m_tag;
+	SDL_AtomicInt m_refCount;
+};
+
+#endif // MXSHAREDBUFFER_H
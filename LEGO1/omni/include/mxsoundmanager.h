@@ -4,7 +4,9 @@
 #include "decomp.h"
 #include "mxatom.h"
 #include "mxaudiomanager.h"
+#include "mxaudiomixer.h"
 #include "mxminiaudio.h"
+#include "mxprofiler.h"
 
 #include <SDL3/SDL_audio.h>
 
@@ -23,6 +25,7 @@ class MxSoundManager : public MxAudioManager {
 	virtual void Resume();                                               // vtable+0x38
 
 	ma_engine* GetEngine() { return m_engine; }
+	MxAudioMixer* GetMixer() { return &m_mixer; }
 
 	float GetAttenuation(MxU32 p_volume);
 
@@ -35,8 +38,12 @@ class MxSoundManager : public MxAudioManager {
 	// [library:audio]
 	// Upscaling everything to 44.1KHz, since we have various sample rates throughout the game.
 	// Not sure how DirectSound handles this when different buffers have different rates.
+	// Only used when the rate of the playback device is not known.
 	static const MxU32 g_sampleRate = 44100;
 
+	// Lower bound for how far the mixer thread renders ahead of the device, about 23ms
+	static const MxU32 g_minMixAheadInFrames = 1024;
+
 	static void AudioStreamCallback(
 		void* p_userdata,
 		SDL_AudioStream* p_stream,
@@ -47,6 +54,12 @@ class MxSoundManager : public MxAudioManager {
 	MxMiniaudio<ma_engine> m_engine;
 	SDL_AudioStream* m_stream;
 	undefined m_unk0x38[4];
+
+	// Not in the original: applies sound changes and renders the mix off the game thread
+	MxAudioMixer m_mixer;
+
+	// Not in the original: the profiler buffer of the device callback, which must not allocate
+	MxProfilerReservation m_profilerReservation;
 };
 
 // SYNTHETIC: LEGO1 0x100ae7b0
@@ -5,6 +5,7 @@
 
 class MxDSBuffer;
 class MxDSSubscriberList;
+class MxSharedBuffer;
 
 // VTABLE: LEGO1 0x100dc2a8
 // VTABLE: BETA10 0x101c1d20
@@ -12,7 +13,7 @@ class MxDSSubscriberList;
 class MxStreamChunk : public MxDSChunk {
 public:
 	// FUNCTION: BETA10 0x10134420
-	MxStreamChunk() : m_buffer(NULL) {}
+	MxStreamChunk() : m_buffer(NULL), m_sharedBuffer(NULL) {}
 
 	~MxStreamChunk() override;
 
@@ -31,11 +32,13 @@ class MxStreamChunk : public MxDSChunk {
 	}
 
 	MxDSBuffer* GetBuffer() { return m_buffer; }
+	MxSharedBuffer* GetSharedBuffer() { return m_sharedBuffer; }
 
 	MxResult ReadChunk(MxDSBuffer* p_buffer, MxU8* p_chunkData);
 	MxU32 ReadChunkHeader(MxU8* p_chunkData);
 	MxResult SendChunk(MxDSSubscriberList& p_subscriberList, MxBool p_append, MxS16 p_obj24val);
 	void SetBuffer(MxDSBuffer* p_buffer);
+	MxBool ShareData(MxStreamChunk* p_chunk);
 
 	static MxU16* IntoFlags(MxU8* p_buffer);
 	static MxU32* IntoObjectId(MxU8* p_buffer);
@@ -44,6 +47,7 @@ class MxStreamChunk : public MxDSChunk {
 
 private:
 	MxDSBuffer* m_buffer; // 0x1c
+	MxSharedBuffer* m_sharedBuffer;
 };
 
 // SYNTHETIC: LEGO1 0x100b20a0
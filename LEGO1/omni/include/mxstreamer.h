@@ -16,6 +16,7 @@ class MxDSObject;
 
 typedef MxMemoryPool<64, 22> MxMemoryPool64;
 typedef MxMemoryPool<128, 2> MxMemoryPool128;
+typedef MxMemoryPool<256, 1> MxMemoryPool256;
 
 // VTABLE: LEGO1 0x100dc760
 // VTABLE: BETA10 0x101c23c8
@@ -80,46 +81,53 @@ class MxStreamer : public MxCore {
 	MxResult FUN_100b99b0(MxDSAction* p_action);
 	MxResult DeleteObject(MxDSAction* p_dsAction);
 
+	// Block sizes are served by the smallest pool whose blocks are large enough.
+	// Originally only exactly 0x40 and 0x80 were accepted.
 	// FUNCTION: BETA10 0x10158db0
 	MxU8* GetMemoryBlock(MxU32 p_blockSize)
 	{
-		switch (p_blockSize) {
-		case 0x40:
+		if (p_blockSize <= 0x40) {
 			return m_pool64.Get();
-
-		case 0x80:
+		}
+		else if (p_blockSize <= 0x80) {
 			return m_pool128.Get();
-
-		default:
-			assert("Invalid block size for memory pool" == NULL);
-			break;
+		}
+		else if (p_blockSize <= 0x100) {
+			return m_pool256.Get();
 		}
 
+		assert("Invalid block size for memory pool" == NULL);
 		return NULL;
 	}
 
 	// FUNCTION: BETA10 0x10158570
 	void ReleaseMemoryBlock(MxU8* p_block, MxU32 p_blockSize)
 	{
-		switch (p_blockSize) {
-		case 0x40:
+		if (p_blockSize <= 0x40) {
 			m_pool64.Release(p_block);
-			break;
-
-		case 0x80:
+		}
+		else if (p_blockSize <= 0x80) {
 			m_pool128.Release(p_block);
-			break;
-
-		default:
+		}
+		else if (p_blockSize <= 0x100) {
+			m_pool256.Release(p_block);
+		}
+		else {
 			assert("Invalid block size for memory pool" == NULL);
-			break;
 		}
 	}
 
+	enum {
+		e_numMemoryPools = 3
+	};
+
+	LEGO1_EXPORT void GetMemoryPoolStats(MxMemoryPoolStats p_stats[e_numMemoryPools]);
+
 private:
 	list<MxStreamController*> m_controllers; // 0x08
 	MxMemoryPool64 m_pool64;                 // 0x14
 	MxMemoryPool128 m_pool128;               // 0x20
+	MxMemoryPool256 m_pool256;
 };
 
 // clang-format off
@@ -6,21 +6,30 @@
 
 // VTABLE: LEGO1 0x100dc110
 // VTABLE: BETA10 0x101c1be0
-// SIZE 0x10
 class MxString : public MxCore {
 public:
 	MxString();
 	MxString(const MxString& p_str);
 	LEGO1_EXPORT MxString(const char* p_str);
 	MxString(const char* p_str, MxU16 p_maxlen);
+	MxString(MxString&& p_str) noexcept;
 	LEGO1_EXPORT ~MxString() override;
 
 	void Reverse();
 	void ToUpperCase();
 	void ToLowerCase();
-	void MapPathToFilesystem() { MapPathToFilesystem(m_data); }
+	void MapPathToFilesystem()
+	{
+		MapPathToFilesystem(m_data);
+		m_hash = 0;
+	}
+
+	void Reserve(MxU32 p_length);
+	MxString& Append(const char* p_str, MxU16 p_length);
+	MxU32 GetHash() const;
 
 	LEGO1_EXPORT MxString& operator=(const MxString& p_str);
+	MxString& operator=(MxString&& p_str) noexcept;
 	LEGO1_EXPORT const MxString& operator=(const char* p_str);
 	LEGO1_EXPORT MxString operator+(const MxString& p_str) const;
 	LEGO1_EXPORT MxString operator+(const char* p_str) const;
@@ -28,10 +37,16 @@ class MxString : public MxCore {
 
 	static void CharSwap(char* p_a, char* p_b);
 	LEGO1_EXPORT static void MapPathToFilesystem(char* p_path);
+	static MxU32 Hash(const char* p_str);
+	LEGO1_EXPORT static MxU32 GetHeapAllocations();
 
+	// Callers writing through the returned pointer must not change the length
+	// and invalidate the cached hash with InvalidateHash() afterwards.
 	// FUNCTION: BETA10 0x10017c50
 	char* GetData() const { return m_data; }
 
+	void InvalidateHash() { m_hash = 0; }
+
 	// FUNCTION: BETA10 0x10067630
 	const MxU16 GetLength() const { return m_length; }
 
@@ -46,8 +61,17 @@ class MxString : public MxCore {
 	// MxString::`scalar deleting destructor'
 
 private:
+	// Strings up to this length are stored inline without touching the heap.
+	static const MxU16 c_inlineLength = 23;
+
+	void InitInline();
+	MxBool IsInline() const { return m_data == m_inline; }
+
 	char* m_data;   // 0x08
 	MxU16 m_length; // 0x0c
+	MxU16 m_capacity;
+	mutable MxU32 m_hash;
+	char m_inline[c_inlineLength + 1];
 };
 
 #endif // MXSTRING_H
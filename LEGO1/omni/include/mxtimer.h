@@ -33,6 +33,36 @@ class MxTimer : public MxCore {
 		}
 	}
 
+	// Where the time read by MxTimer and the other game time samplers comes from.
+	// The fixed-step and replay clocks only move on AdvanceClock, once a frame,
+	// so runs with the same input go through the same sequence of times.
+	enum ClockMode {
+		e_realClock,      // SDL_GetTicks
+		e_fixedStepClock, // A fixed step per frame
+		e_replayClock     // The frame times of a recording, see StartRecording
+	};
+
+	// Clocks should be set up before MxOmni is created, as the timer keeps its start time
+	LEGO1_EXPORT static void SetFixedStepClock(MxU32 p_step);
+	LEGO1_EXPORT static MxBool SetReplayClock(const char* p_path);
+	static ClockMode GetClockMode() { return g_clockMode; }
+	static MxBool IsRealClock() { return g_clockMode == e_realClock; }
+
+	// Milliseconds, shared by every time sampler in the game
+	LEGO1_EXPORT static Uint64 GetTicks();
+
+	// Called by the game loop at the start of each frame. Once a replay has
+	// run out, the clock keeps stepping by its last frame time.
+	LEGO1_EXPORT static void AdvanceClock();
+	LEGO1_EXPORT static MxBool IsReplayFinished();
+	static MxU32 GetFrameTime() { return g_frameTime; }
+
+	// Records the time between frames for SetReplayClock. The game loop calls
+	// RecordFrame once it has read the time of a frame it goes on to tickle.
+	LEGO1_EXPORT static void StartRecording(const char* p_path);
+	LEGO1_EXPORT void RecordFrame();
+	LEGO1_EXPORT static MxBool StopRecording();
+
 	// SYNTHETIC: LEGO1 0x100ae0d0
 	// SYNTHETIC: BETA10 0x1012bf80
 	// MxTimer::`scalar deleting destructor'
@@ -43,6 +73,10 @@ class MxTimer : public MxCore {
 
 	static MxLong g_lastTimeCalculated;
 	static MxLong g_lastTimeTimerStarted;
+
+	// Not in the original
+	LEGO1_EXPORT static ClockMode g_clockMode;
+	LEGO1_EXPORT static MxU32 g_frameTime;
 };
 
 // SYNTHETIC: BETA10 0x1012bfc0
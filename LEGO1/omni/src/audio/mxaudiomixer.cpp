@@ -0,0 +1,625 @@
+#include "mxaudiomixer.h"
+
+#include "mxautolock.h"
+#include "mxprofiler.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include <assert.h>
+
+// Set while the current thread is mixing, see RealtimeScope. Only allocations
+// made through the engine's allocation callbacks are checked against it.
+// Anything else that runs while mixing goes unnoticed, such as
+// SDL_PutAudioStreamData in Read, which may grow the stream's queue. Profiler
+// zones on the mixing threads record into reserved buffers and do not allocate.
+static thread_local MxBool g_realtime = FALSE;
+
+class RealtimeScope {
+public:
+	RealtimeScope() { g_realtime = TRUE; }
+	~RealtimeScope() { g_realtime = FALSE; }
+};
+
+#ifndef NDEBUG
+static void AssertNoAllocation(size_t p_size)
+{
+	assert(!"Audio engine allocated memory while mixing");
+}
+#endif
+
+MxAudioMixer::MxAudioMixer()
+{
+	m_engine = NULL;
+	SDL_zero(m_ring);
+	m_ringInitialized = FALSE;
+	m_thread = NULL;
+	m_wake = NULL;
+	SDL_SetAtomicInt(&m_quit, 0);
+	SDL_SetAtomicInt(&m_head, 0);
+	SDL_SetAtomicInt(&m_tail, 0);
+	m_pendingHead = 0;
+	m_batchDepth = 0;
+	SDL_SetAtomicInt(&m_numCommands, 0);
+	SDL_SetAtomicInt(&m_numBlocks, 0);
+	SDL_SetAtomicInt(&m_numUnderruns, 0);
+	SDL_SetAtomicInt(&m_numQueueFull, 0);
+	SDL_SetAtomicInt(&m_numRealtimeAllocations, 0);
+	m_pumpedMilliseconds = 0;
+	m_pumpedFrames = 0;
+
+	m_allocationCallbacks.pUserData = this;
+	m_allocationCallbacks.onMalloc = &OnMalloc;
+	m_allocationCallbacks.onRealloc = &OnRealloc;
+	m_allocationCallbacks.onFree = &OnFree;
+
+#ifndef NDEBUG
+	m_allocationHook = &AssertNoAllocation;
+#else
+	m_allocationHook = NULL;
+#endif
+}
+
+MxAudioMixer::~MxAudioMixer()
+{
+	Destroy();
+
+	// Pooled buffers do not depend on the engine and are kept until here
+	for (size_t i = 0; i < m_freeBuffers.size(); i++) {
+		delete[] m_freeBuffers[i].m_buffer;
+	}
+}
+
+MxResult MxAudioMixer::Create(ma_engine* p_engine, MxU32 p_ringSizeInFrames, MxBool p_headless)
+{
+	AUTOLOCK(m_postLock);
+
+	m_engine = p_engine;
+
+	if (p_headless) {
+		return SUCCESS;
+	}
+
+	// Whole blocks only, so that a block never has to wrap around the end of the ring
+	MxU32 ringSizeInFrames = (p_ringSizeInFrames + c_blockSizeInFrames - 1) / c_blockSizeInFrames * c_blockSizeInFrames;
+
+	if (ma_pcm_rb_init(ma_format_f32, ma_engine_get_channels(m_engine), ringSizeInFrames, NULL, NULL, &m_ring) !=
+		MA_SUCCESS) {
+		goto fail;
+	}
+
+	m_ringInitialized = TRUE;
+	SDL_SetAtomicInt(&m_quit, 0);
+
+	if (!(m_wake = SDL_CreateSemaphore(0))) {
+		goto fail;
+	}
+
+	if (!(m_thread = SDL_CreateThread(&ThreadProc, "MxAudioMixer", this))) {
+		goto fail;
+	}
+
+	return SUCCESS;
+
+fail:
+	Destroy();
+	return FAILURE;
+}
+
+void MxAudioMixer::Destroy()
+{
+	AUTOLOCK(m_postLock);
+
+	if (m_thread) {
+		SDL_SetAtomicInt(&m_quit, 1);
+		SDL_SignalSemaphore(m_wake);
+		SDL_WaitThread(m_thread, NULL);
+		m_thread = NULL;
+	}
+
+	if (m_wake) {
+		SDL_DestroySemaphore(m_wake);
+		m_wake = NULL;
+	}
+
+	if (m_ringInitialized) {
+		ma_pcm_rb_uninit(&m_ring);
+		m_ringInitialized = FALSE;
+	}
+
+	// Whatever is still queued refers to sounds of an engine that is about to go away
+	SDL_SetAtomicInt(&m_head, 0);
+	SDL_SetAtomicInt(&m_tail, 0);
+	m_pendingHead = 0;
+	m_engine = NULL;
+}
+
+MxU8* MxAudioMixer::AcquireBuffer(MxU32 p_size)
+{
+	AUTOLOCK(m_bufferLock);
+
+	// Only a handful of formats are in use, so buffers of the same size come back often
+	for (size_t i = 0; i < m_freeBuffers.size(); i++) {
+		if (m_freeBuffers[i].m_size == p_size) {
+			MxU8* buffer = m_freeBuffers[i].m_buffer;
+			m_freeBuffers[i] = m_freeBuffers.back();
+			m_freeBuffers.pop_back();
+			return buffer;
+		}
+	}
+
+	return new MxU8[p_size];
+}
+
+void MxAudioMixer::ReleaseBuffer(MxU8* p_buffer, MxU32 p_size)
+{
+	AUTOLOCK(m_bufferLock);
+
+	FreeBuffer freeBuffer = {p_size, p_buffer};
+	m_freeBuffers.push_back(freeBuffer);
+}
+
+ma_result MxAudioMixer::Start(ma_sound* p_sound)
+{
+	if (!p_sound) {
+		return MA_INVALID_ARGS;
+	}
+
+	Command command;
+	command.m_type = e_start;
+	command.m_sound = p_sound;
+	Post(command);
+	return MA_SUCCESS;
+}
+
+void MxAudioMixer::Stop(ma_sound* p_sound)
+{
+	Command command;
+	command.m_type = e_stop;
+	command.m_sound = p_sound;
+	Post(command);
+}
+
+ma_result MxAudioMixer::SeekToPCMFrame(ma_sound* p_sound, ma_uint64 p_frame)
+{
+	if (!p_sound) {
+		return MA_INVALID_ARGS;
+	}
+
+	Command command;
+	command.m_type = e_seek;
+	command.m_sound = p_sound;
+	command.m_frame = p_frame;
+	Post(command);
+	return MA_SUCCESS;
+}
+
+void MxAudioMixer::SetVolume(ma_sound* p_sound, float p_volume)
+{
+	PostValues(e_volume, p_sound, p_volume, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetPitch(ma_sound* p_sound, float p_pitch)
+{
+	PostValues(e_pitch, p_sound, p_pitch, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetLooping(ma_sound* p_sound, ma_bool32 p_looping)
+{
+	Command command;
+	command.m_type = e_looping;
+	command.m_sound = p_sound;
+	command.m_flag = p_looping;
+	Post(command);
+}
+
+void MxAudioMixer::SetPosition(ma_sound* p_sound, float p_x, float p_y, float p_z)
+{
+	PostValues(e_position, p_sound, p_x, p_y, p_z);
+}
+
+void MxAudioMixer::SetMinDistance(ma_sound* p_sound, float p_distance)
+{
+	PostValues(e_minDistance, p_sound, p_distance, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetMaxDistance(ma_sound* p_sound, float p_distance)
+{
+	PostValues(e_maxDistance, p_sound, p_distance, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetRolloff(ma_sound* p_sound, float p_rolloff)
+{
+	PostValues(e_rolloff, p_sound, p_rolloff, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetDopplerFactor(ma_sound* p_sound, float p_factor)
+{
+	PostValues(e_dopplerFactor, p_sound, p_factor, 0.0f, 0.0f);
+}
+
+void MxAudioMixer::SetSpatializationEnabled(ma_sound* p_sound, ma_bool32 p_enabled)
+{
+	Command command;
+	command.m_type = e_spatialization;
+	command.m_sound = p_sound;
+	command.m_flag = p_enabled;
+	Post(command);
+}
+
+void MxAudioMixer::SetListenerPosition(float p_x, float p_y, float p_z)
+{
+	PostValues(e_listenerPosition, NULL, p_x, p_y, p_z);
+}
+
+void MxAudioMixer::SetListenerDirection(float p_x, float p_y, float p_z)
+{
+	PostValues(e_listenerDirection, NULL, p_x, p_y, p_z);
+}
+
+void MxAudioMixer::SetListenerWorldUp(float p_x, float p_y, float p_z)
+{
+	PostValues(e_listenerWorldUp, NULL, p_x, p_y, p_z);
+}
+
+void MxAudioMixer::SetListenerVelocity(float p_x, float p_y, float p_z)
+{
+	PostValues(e_listenerVelocity, NULL, p_x, p_y, p_z);
+}
+
+void MxAudioMixer::BeginBatch()
+{
+	AUTOLOCK(m_postLock);
+	m_batchDepth++;
+}
+
+void MxAudioMixer::EndBatch()
+{
+	AUTOLOCK(m_postLock);
+
+	assert(m_batchDepth > 0);
+	if (--m_batchDepth == 0) {
+		SDL_SetAtomicInt(&m_head, m_pendingHead);
+	}
+}
+
+MxBool MxAudioMixer::IsPlaying(ma_sound* p_sound)
+{
+	AUTOLOCK(m_postLock);
+
+	MxU32 tail = SDL_GetAtomicInt(&m_tail);
+
+	for (MxU32 i = m_pendingHead; i != tail; i--) {
+		const Command& command = m_commands[(i - 1) & (c_queueSize - 1)];
+
+		if (command.m_sound == p_sound) {
+			if (command.m_type == e_start) {
+				return TRUE;
+			}
+
+			if (command.m_type == e_stop) {
+				return FALSE;
+			}
+		}
+	}
+
+	return ma_sound_is_playing(p_sound);
+}
+
+MxBool MxAudioMixer::AtEnd(ma_sound* p_sound)
+{
+	AUTOLOCK(m_postLock);
+
+	MxU32 tail = SDL_GetAtomicInt(&m_tail);
+
+	for (MxU32 i = m_pendingHead; i != tail; i--) {
+		const Command& command = m_commands[(i - 1) & (c_queueSize - 1)];
+
+		// Starting a sound that is at its end rewinds it
+		if (command.m_sound == p_sound && (command.m_type == e_start || command.m_type == e_seek)) {
+			return FALSE;
+		}
+	}
+
+	return ma_sound_at_end(p_sound);
+}
+
+void MxAudioMixer::Flush(ma_sound* p_sound)
+{
+	AUTOLOCK(m_postLock);
+
+	if (IsPending(p_sound)) {
+		WaitForMixer();
+	}
+}
+
+void MxAudioMixer::Read(SDL_AudioStream* p_stream, MxU32 p_frames)
+{
+	RealtimeScope realtime;
+	ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(m_ring.format, m_ring.channels);
+
+	while (p_frames > 0) {
+		ma_uint32 frames = p_frames;
+		void* data;
+
+		if (ma_pcm_rb_acquire_read(&m_ring, &frames, &data) != MA_SUCCESS || frames == 0) {
+			break;
+		}
+
+		SDL_PutAudioStreamData(p_stream, data, frames * bytesPerFrame);
+		ma_pcm_rb_commit_read(&m_ring, frames);
+		p_frames -= frames;
+	}
+
+	// SDL plays silence for whatever could not be provided
+	if (p_frames > 0) {
+		SDL_AddAtomicInt(&m_numUnderruns, 1);
+	}
+
+	SDL_SignalSemaphore(m_wake);
+}
+
+MxU32 MxAudioMixer::Render(float* p_out, MxU32 p_frames)
+{
+	assert(IsHeadless());
+
+	RealtimeScope realtime;
+	ApplyCommands();
+
+	ma_uint64 framesRead = 0;
+	if (ma_engine_read_pcm_frames(m_engine, p_out, p_frames, &framesRead) != MA_SUCCESS) {
+		framesRead = 0;
+	}
+
+	if (framesRead < p_frames) {
+		ma_uint32 channels = ma_engine_get_channels(m_engine);
+		ma_silence_pcm_frames(p_out + framesRead * channels, p_frames - framesRead, ma_format_f32, channels);
+	}
+
+	return p_frames;
+}
+
+void MxAudioMixer::Pump(MxU32 p_milliseconds)
+{
+	m_pumpedMilliseconds += p_milliseconds;
+	MxU64 frames = m_pumpedMilliseconds * ma_engine_get_sample_rate(m_engine) / 1000 - m_pumpedFrames;
+	m_pumpedFrames += frames;
+
+	if (m_pumpBuffer.empty()) {
+		m_pumpBuffer.resize(c_blockSizeInFrames * ma_engine_get_channels(m_engine));
+	}
+
+	while (frames) {
+		MxU32 block = (MxU32) SDL_min(frames, (MxU64) c_blockSizeInFrames);
+		Render(m_pumpBuffer.data(), block);
+		frames -= block;
+	}
+}
+
+void MxAudioMixer::GetStats(Stats& p_stats)
+{
+	p_stats.m_commands = SDL_GetAtomicInt(&m_numCommands);
+	p_stats.m_blocks = SDL_GetAtomicInt(&m_numBlocks);
+	p_stats.m_underruns = SDL_GetAtomicInt(&m_numUnderruns);
+	p_stats.m_queueFull = SDL_GetAtomicInt(&m_numQueueFull);
+	p_stats.m_realtimeAllocations = SDL_GetAtomicInt(&m_numRealtimeAllocations);
+}
+
+void MxAudioMixer::Post(const Command& p_command)
+{
+	AUTOLOCK(m_postLock);
+
+	if (!m_engine) {
+		return;
+	}
+
+	if (m_pendingHead - (MxU32) SDL_GetAtomicInt(&m_tail) == c_queueSize) {
+		SDL_AddAtomicInt(&m_numQueueFull, 1);
+		WaitForMixer();
+	}
+
+	m_commands[m_pendingHead & (c_queueSize - 1)] = p_command;
+	m_pendingHead++;
+
+	if (m_batchDepth == 0) {
+		SDL_SetAtomicInt(&m_head, m_pendingHead);
+	}
+}
+
+void MxAudioMixer::PostValues(MxU32 p_type, ma_sound* p_sound, float p_x, float p_y, float p_z)
+{
+	Command command;
+	command.m_type = p_type;
+	command.m_sound = p_sound;
+	command.m_values[0] = p_x;
+	command.m_values[1] = p_y;
+	command.m_values[2] = p_z;
+	Post(command);
+}
+
+MxBool MxAudioMixer::IsPending(ma_sound* p_sound)
+{
+	for (MxU32 i = SDL_GetAtomicInt(&m_tail); i != m_pendingHead; i++) {
+		if (m_commands[i & (c_queueSize - 1)].m_sound == p_sound) {
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+// Called with m_postLock held
+void MxAudioMixer::WaitForMixer()
+{
+	// Includes whatever an open batch has not published yet
+	SDL_SetAtomicInt(&m_head, m_pendingHead);
+
+	if (IsHeadless()) {
+		// Nobody else consumes the queue
+		ApplyCommands();
+		return;
+	}
+
+	while ((MxU32) SDL_GetAtomicInt(&m_tail) != m_pendingHead) {
+		SDL_SignalSemaphore(m_wake);
+		SDL_Delay(1);
+	}
+}
+
+void MxAudioMixer::ApplyCommands()
+{
+	MxU32 tail = SDL_GetAtomicInt(&m_tail);
+	MxU32 head = SDL_GetAtomicInt(&m_head);
+
+	if (tail == head) {
+		return;
+	}
+
+	SDL_AddAtomicInt(&m_numCommands, head - tail);
+
+	for (; tail != head; tail++) {
+		Apply(m_commands[tail & (c_queueSize - 1)]);
+	}
+
+	SDL_SetAtomicInt(&m_tail, tail);
+}
+
+void MxAudioMixer::Apply(const Command& p_command)
+{
+	const float* values = p_command.m_values;
+
+	switch (p_command.m_type) {
+	case e_start:
+		ma_sound_start(p_command.m_sound);
+		break;
+	case e_stop:
+		ma_sound_stop(p_command.m_sound);
+		break;
+	case e_seek:
+		ma_sound_seek_to_pcm_frame(p_command.m_sound, p_command.m_frame);
+		break;
+	case e_volume:
+		ma_sound_set_volume(p_command.m_sound, values[0]);
+		break;
+	case e_pitch:
+		ma_sound_set_pitch(p_command.m_sound, values[0]);
+		break;
+	case e_looping:
+		ma_sound_set_looping(p_command.m_sound, p_command.m_flag);
+		break;
+	case e_position:
+		ma_sound_set_position(p_command.m_sound, values[0], values[1], values[2]);
+		break;
+	case e_minDistance:
+		ma_sound_set_min_distance(p_command.m_sound, values[0]);
+		break;
+	case e_maxDistance:
+		ma_sound_set_max_distance(p_command.m_sound, values[0]);
+		break;
+	case e_rolloff:
+		ma_sound_set_rolloff(p_command.m_sound, values[0]);
+		break;
+	case e_dopplerFactor:
+		ma_sound_set_doppler_factor(p_command.m_sound, values[0]);
+		break;
+	case e_spatialization:
+		ma_sound_set_spatialization_enabled(p_command.m_sound, p_command.m_flag);
+		break;
+	case e_listenerPosition:
+		ma_engine_listener_set_position(m_engine, 0, values[0], values[1], values[2]);
+		break;
+	case e_listenerDirection:
+		ma_engine_listener_set_direction(m_engine, 0, values[0], values[1], values[2]);
+		break;
+	case e_listenerWorldUp:
+		ma_engine_listener_set_world_up(m_engine, 0, values[0], values[1], values[2]);
+		break;
+	case e_listenerVelocity:
+		ma_engine_listener_set_velocity(m_engine, 0, values[0], values[1], values[2]);
+		break;
+	}
+}
+
+void MxAudioMixer::FillRing()
+{
+	MxProfileZone zone("MxAudioMixer::FillRing", &m_profilerReservation);
+	RealtimeScope realtime;
+
+	for (;;) {
+		ApplyCommands();
+
+		ma_uint32 frames = ma_pcm_rb_available_write(&m_ring);
+		if (frames < c_blockSizeInFrames) {
+			break;
+		}
+
+		frames = c_blockSizeInFrames;
+		void* data;
+
+		if (ma_pcm_rb_acquire_write(&m_ring, &frames, &data) != MA_SUCCESS) {
+			break;
+		}
+
+		ma_uint64 framesRead = 0;
+		if (ma_engine_read_pcm_frames(m_engine, data, frames, &framesRead) != MA_SUCCESS) {
+			framesRead = 0;
+		}
+
+		if (framesRead < frames) {
+			ma_silence_pcm_frames(
+				ma_offset_pcm_frames_ptr(data, framesRead, m_ring.format, m_ring.channels),
+				frames - framesRead,
+				m_ring.format,
+				m_ring.channels
+			);
+		}
+
+		ma_pcm_rb_commit_write(&m_ring, frames);
+		SDL_AddAtomicInt(&m_numBlocks, 1);
+	}
+}
+
+int SDLCALL MxAudioMixer::ThreadProc(void* p_mixer)
+{
+	MxAudioMixer* mixer = (MxAudioMixer*) p_mixer;
+
+	while (!SDL_GetAtomicInt(&mixer->m_quit)) {
+		mixer->FillRing();
+
+		// Woken by the device callback after each read, and by the game when it waits
+		SDL_WaitSemaphoreTimeout(mixer->m_wake, 10);
+	}
+
+	return 0;
+}
+
+void MxAudioMixer::CheckAllocation(size_t p_size)
+{
+	if (g_realtime) {
+		SDL_AddAtomicInt(&m_numRealtimeAllocations, 1);
+
+		if (m_allocationHook) {
+			m_allocationHook(p_size);
+		}
+	}
+}
+
+void* MxAudioMixer::OnMalloc(size_t p_size, void* p_mixer)
+{
+	((MxAudioMixer*) p_mixer)->CheckAllocation(p_size);
+	return SDL_malloc(p_size);
+}
+
+void* MxAudioMixer::OnRealloc(void* p_data, size_t p_size, void* p_mixer)
+{
+	((MxAudioMixer*) p_mixer)->CheckAllocation(p_size);
+	return SDL_realloc(p_data, p_size);
+}
+
+void MxAudioMixer::OnFree(void* p_data, void* p_mixer)
+{
+	if (p_data) {
+		((MxAudioMixer*) p_mixer)->CheckAllocation(0);
+	}
+
+	SDL_free(p_data);
+}
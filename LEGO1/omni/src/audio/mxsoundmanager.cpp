@@ -5,14 +5,13 @@
 #include "mxmisc.h"
 #include "mxomni.h"
 #include "mxpresenter.h"
+#include "mxprofiler.h"
 #include "mxticklemanager.h"
 #include "mxticklethread.h"
 #include "mxwavepresenter.h"
 
 #include <SDL3/SDL_log.h>
 
-DECOMP_SIZE_ASSERT(MxSoundManager, 0x3c);
-
 // GLOBAL LEGO1 0x10101420
 MxS32 g_volumeAttenuation[100] = {-6643, -5643, -5058, -4643, -4321, -4058, -3836, -3643, -3473, -3321, -3184, -3058,
 								  -2943, -2836, -2736, -2643, -2556, -2473, -2395, -2321, -2251, -2184, -2120, -2058,
@@ -60,6 +59,7 @@ void MxSoundManager::Destroy(MxBool p_fromDestructor)
 		SDL_DestroyAudioStream(m_stream);
 	}
 
+	m_mixer.Destroy();
 	m_engine.Destroy(ma_engine_uninit);
 
 	Init();
@@ -89,6 +89,13 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 	engineConfig.noDevice = MA_TRUE;
 	engineConfig.channels = MxOmni::IsSound3D() ? 2 : 1;
 	engineConfig.sampleRate = g_sampleRate;
+	engineConfig.allocationCallbacks = m_mixer.GetAllocationCallbacks();
+
+	// Mix at the rate of the device, when known, so that the stream does not have to resample on the audio thread
+	SDL_AudioSpec deviceSpec;
+	if (SDL_GetAudioDeviceFormat(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &deviceSpec, NULL) && deviceSpec.freq > 0) {
+		engineConfig.sampleRate = deviceSpec.freq;
+	}
 
 	if (m_engine.Init(ma_engine_init, &engineConfig) != MA_SUCCESS) {
 		goto done;
@@ -102,6 +109,14 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 
 	if ((m_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, &AudioStreamCallback, this)) !=
 		NULL) {
+		int deviceFrames = 0;
+		SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(m_stream), &deviceSpec, &deviceFrames);
+
+		// Mix ahead by two device buffers, so the callback always finds a full one
+		if (m_mixer.Create(m_engine, SDL_max(2 * deviceFrames, (int) g_minMixAheadInFrames), FALSE) != SUCCESS) {
+			goto done;
+		}
+
 		SDL_ResumeAudioDevice(SDL_GetAudioStreamDevice(m_stream));
 	}
 	else {
@@ -110,6 +125,11 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 			"Failed to open default audio device for playback: %s",
 			SDL_GetError()
 		);
+
+		// Headless: the mix is only rendered on request
+		if (m_mixer.Create(m_engine, 0, TRUE) != SUCCESS) {
+			goto done;
+		}
 	}
 
 	if (p_createThread) {
@@ -143,17 +163,12 @@ void MxSoundManager::AudioStreamCallback(
 	int p_totalAmount
 )
 {
-	static vector<MxU8> g_buffer;
-	g_buffer.reserve(p_additionalAmount);
-
 	MxSoundManager* manager = (MxSoundManager*) p_userdata;
+	MxProfileZone zone("MxSoundManager::AudioStreamCallback", &manager->m_profilerReservation);
 	ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(ma_format_f32, ma_engine_get_channels(manager->m_engine));
-	ma_uint32 bufferSizeInFrames = (ma_uint32) p_additionalAmount / bytesPerFrame;
-	ma_uint64 framesRead;
 
-	if (ma_engine_read_pcm_frames(manager->m_engine, g_buffer.data(), bufferSizeInFrames, &framesRead) == MA_SUCCESS) {
-		SDL_PutAudioStreamData(manager->m_stream, g_buffer.data(), framesRead * bytesPerFrame);
-	}
+	// Only copies what the mixer thread has already rendered
+	manager->m_mixer.Read(p_stream, (MxU32) p_additionalAmount / bytesPerFrame);
 }
 
 // FUNCTION: LEGO1 0x100aeab0
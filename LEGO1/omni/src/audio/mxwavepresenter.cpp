@@ -40,8 +40,25 @@ MxResult MxWavePresenter::AddToManager()
 // FUNCTION: LEGO1 0x100b1b10
 void MxWavePresenter::Destroy(MxBool p_fromDestructor)
 {
+	if (m_sound && MSoundManager()) {
+		MSoundManager()->GetMixer()->Flush(m_sound);
+	}
+
 	m_sound.Destroy(ma_sound_uninit);
-	m_rb.Destroy(ma_pcm_rb_uninit);
+
+	if (m_rb) {
+		// The ring's storage comes from the mixer, see StartingTickle
+		MxU8* rbData = (MxU8*) m_rb->rb.pBuffer;
+		MxU32 rbSize = m_rb->rb.subbufferSizeInBytes;
+		m_rb.Destroy(ma_pcm_rb_uninit);
+
+		if (MSoundManager()) {
+			MSoundManager()->GetMixer()->ReleaseBuffer(rbData, rbSize);
+		}
+		else {
+			delete[] rbData;
+		}
+	}
 	m_ab.m_buffer.Destroy(ma_audio_buffer_uninit);
 	delete[] m_ab.m_data;
 
@@ -150,14 +167,15 @@ void MxWavePresenter::StartingTickle()
 			}
 		}
 		else {
-			if (m_rb.Init(
-					ma_pcm_rb_init,
-					format,
-					channels,
-					ma_calculate_buffer_size_in_frames_from_milliseconds(g_rbSizeInMilliseconds, sampleRate),
-					nullptr,
-					nullptr
-				) != MA_SUCCESS) {
+			// Reuse the storage of an earlier presenter with the same format rather than allocating two seconds
+			// of audio on every start
+			ma_uint32 rbSizeInFrames =
+				ma_calculate_buffer_size_in_frames_from_milliseconds(g_rbSizeInMilliseconds, sampleRate);
+			MxU32 rbSize = rbSizeInFrames * ma_get_bytes_per_frame(format, channels);
+			MxU8* rbData = MSoundManager()->GetMixer()->AcquireBuffer(rbSize);
+
+			if (m_rb.Init(ma_pcm_rb_init, format, channels, rbSizeInFrames, rbData, nullptr) != MA_SUCCESS) {
+				MSoundManager()->GetMixer()->ReleaseBuffer(rbData, rbSize);
 				goto done;
 			}
 
@@ -178,8 +196,11 @@ void MxWavePresenter::StartingTickle()
 		// There is an issue with certain spatialized sounds causing an audio glitch.
 		// To temporarily resolve this, we can disable the Doppler effect.
 		// More info: https://github.com/mackron/miniaudio/issues/885
-		ma_sound_set_doppler_factor(m_sound, 0.0f);
-		ma_sound_set_looping(m_sound, m_action->IsLooping() ? m_action->GetLoopCount() > 1 : MA_TRUE);
+		MSoundManager()->GetMixer()->SetDopplerFactor(m_sound, 0.0f);
+		MSoundManager()->GetMixer()->SetLooping(
+			m_sound,
+			m_action->IsLooping() ? m_action->GetLoopCount() > 1 : MA_TRUE
+		);
 
 		SetVolume(((MxDSSound*) m_action)->GetVolume());
 		ProgressTickleState(e_streaming);
@@ -251,7 +272,7 @@ MxResult MxWavePresenter::PutData()
 			}
 
 			if (!m_started) {
-				if (ma_sound_start(m_sound) == MA_SUCCESS) {
+				if (MSoundManager()->GetMixer()->Start(m_sound) == MA_SUCCESS) {
 					m_started = TRUE;
 				}
 			}
@@ -261,10 +282,10 @@ MxResult MxWavePresenter::PutData()
 				break;
 			}
 
-			assert(!ma_sound_is_playing(m_sound));
-			ma_sound_seek_to_pcm_frame(m_sound, 0);
+			assert(!MSoundManager()->GetMixer()->IsPlaying(m_sound));
+			MSoundManager()->GetMixer()->SeekToPCMFrame(m_sound, 0);
 
-			if (ma_sound_start(m_sound) == MA_SUCCESS) {
+			if (MSoundManager()->GetMixer()->Start(m_sound) == MA_SUCCESS) {
 				m_started = TRUE;
 			}
 		}
@@ -281,7 +302,7 @@ void MxWavePresenter::EndAction()
 		MxMediaPresenter::EndAction();
 
 		if (m_sound) {
-			ma_sound_stop(m_sound);
+			MSoundManager()->GetMixer()->Stop(m_sound);
 		}
 	}
 }
@@ -295,7 +316,7 @@ void MxWavePresenter::SetVolume(MxS32 p_volume)
 	if (m_sound) {
 		MxS32 volume = p_volume * MxOmni::GetInstance()->GetSoundManager()->GetVolume() / 100;
 		float attenuation = MxOmni::GetInstance()->GetSoundManager()->GetAttenuation(volume);
-		ma_sound_set_volume(m_sound, attenuation);
+		MxOmni::GetInstance()->GetSoundManager()->GetMixer()->SetVolume(m_sound, attenuation);
 	}
 
 	m_criticalSection.Leave();
@@ -311,7 +332,7 @@ void MxWavePresenter::Enable(MxBool p_enable)
 			m_started = FALSE;
 		}
 		else if (m_sound) {
-			ma_sound_stop(m_sound);
+			MSoundManager()->GetMixer()->Stop(m_sound);
 		}
 	}
 }
@@ -344,7 +365,7 @@ void MxWavePresenter::Pause()
 {
 	if (!m_paused && m_started) {
 		if (m_sound) {
-			ma_sound_stop(m_sound);
+			MSoundManager()->GetMixer()->Stop(m_sound);
 		}
 		m_paused = TRUE;
 	}
@@ -358,11 +379,11 @@ void MxWavePresenter::Resume()
 			switch (m_currentTickleState) {
 			case e_streaming:
 			case e_repeating:
-				ma_sound_start(m_sound);
+				MSoundManager()->GetMixer()->Start(m_sound);
 				break;
 			case e_done:
-				if (!ma_sound_at_end(m_sound)) {
-					ma_sound_start(m_sound);
+				if (!MSoundManager()->GetMixer()->AtEnd(m_sound)) {
+					MSoundManager()->GetMixer()->Start(m_sound);
 				}
 			}
 		}
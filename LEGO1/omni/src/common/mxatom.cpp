@@ -1,14 +1,30 @@
 #include "mxatom.h"
 
 #include "decomp.h"
+#include "mxautolock.h"
 #include "mxmisc.h"
 #include "mxomni.h"
 
+#include <SDL3/SDL_stdinc.h>
 #include <assert.h>
 
 DECOMP_SIZE_ASSERT(MxAtomId, 0x04);
-DECOMP_SIZE_ASSERT(MxAtom, 0x14);
-DECOMP_SIZE_ASSERT(MxAtomSet, 0x10);
+
+// Must be a power of two
+#define ATOM_TABLE_INITIAL_CAPACITY 1024
+
+inline char FoldChar(char p_c, LookupMode p_mode)
+{
+	switch (p_mode) {
+	case e_upperCase:
+		return SDL_toupper((unsigned char) p_c);
+	case e_lowerCase:
+	case e_lowerCase2:
+		return SDL_tolower((unsigned char) p_c);
+	default:
+		return p_c;
+	}
+}
 
 // FUNCTION: LEGO1 0x100acf90
 // FUNCTION: BETA10 0x1012308b
@@ -50,18 +66,9 @@ void MxAtomId::Destroy()
 		return;
 	}
 
-#ifdef COMPAT_MODE
-	MxAtomSet::iterator it;
-	{
-		MxAtom idAtom(m_internal);
-		it = AtomSet()->find(&idAtom);
-	}
-#else
-	MxAtomSet::iterator it = AtomSet()->find(&MxAtom(m_internal));
-#endif
-	assert(it != AtomSet()->end());
+	MxAtom* atom = AtomSet()->Find(m_internal, e_exact);
+	assert(atom);
 
-	MxAtom* atom = (MxAtom*) (*it);
 	atom->Dec();
 }
 
@@ -87,34 +94,7 @@ MxAtomId& MxAtomId::operator=(const MxAtomId& p_atomId)
 // FUNCTION: BETA10 0x10123378
 MxAtom* MxAtomId::GetAtom(const char* p_str, LookupMode p_mode)
 {
-	MxAtomId unused;
-	MxAtom* atom = new MxAtom(p_str);
-	assert(atom);
-
-	switch (p_mode) {
-	case e_exact:
-		break;
-	case e_upperCase:
-		atom->GetKey().ToUpperCase();
-		break;
-	case e_lowerCase:
-	case e_lowerCase2:
-		atom->GetKey().ToLowerCase();
-		break;
-	}
-
-	MxAtomSet::iterator it = AtomSet()->find(atom);
-	if (it != AtomSet()->end()) {
-		// Atom already in the set. Delete temp value and return it.
-		delete atom;
-		atom = *it;
-	}
-	else {
-		// Atom is not in the set. Add it.
-		AtomSet()->insert(atom);
-	}
-
-	return atom;
+	return AtomSet()->Intern(p_str, p_mode);
 }
 
 // FUNCTION: LEGO1 0x100ad7e0
@@ -130,14 +110,163 @@ void MxAtomId::Clear()
 // FUNCTION: BETA10 0x101235d5
 void MxAtom::Inc()
 {
-	m_value++;
+	// Atoms are shared between the main and the streaming threads
+	SDL_AddAtomicInt(&m_value, 1);
 }
 
 // FUNCTION: LEGO1 0x100ad800
 // FUNCTION: BETA10 0x1012364a
 void MxAtom::Dec()
 {
-	if (m_value) {
-		m_value--;
+	int value;
+
+	do {
+		if (!(value = SDL_GetAtomicInt(&m_value))) {
+			return;
+		}
+	} while (!SDL_CompareAndSwapAtomicInt(&m_value, value, value - 1));
+}
+
+MxAtomSet::MxAtomSet()
+{
+	m_table = CreateTable(ATOM_TABLE_INITIAL_CAPACITY);
+	SDL_SetAtomicInt(&m_count, 0);
+}
+
+MxAtomSet::~MxAtomSet()
+{
+	Table* table = GetTable();
+
+	for (MxU32 i = 0; i <= table->m_mask; i++) {
+		delete (MxAtom*) table->m_slots[i];
+	}
+
+	while (table) {
+		Table* retired = table->m_retired;
+		delete[] table->m_slots;
+		delete table;
+		table = retired;
+	}
+}
+
+// FNV-1a over the case-folded string, matches MxString::Hash for the folded key
+MxU32 MxAtomSet::Hash(const char* p_str, LookupMode p_mode)
+{
+	MxU32 hash = 2166136261u;
+
+	while (*p_str) {
+		hash ^= (MxU8) FoldChar(*p_str++, p_mode);
+		hash *= 16777619u;
+	}
+
+	return hash ? hash : 1;
+}
+
+MxAtomSet::Table* MxAtomSet::CreateTable(MxU32 p_capacity)
+{
+	Table* table = new Table;
+	table->m_mask = p_capacity - 1;
+	table->m_slots = new void*[p_capacity];
+	table->m_retired = NULL;
+	memset(table->m_slots, 0, p_capacity * sizeof(void*));
+	return table;
+}
+
+MxAtom* MxAtomSet::Probe(Table* p_table, const char* p_str, LookupMode p_mode, MxU32 p_hash)
+{
+	for (MxU32 i = p_hash & p_table->m_mask;; i = (i + 1) & p_table->m_mask) {
+		MxAtom* atom = (MxAtom*) SDL_GetAtomicPointer(&p_table->m_slots[i]);
+
+		if (!atom) {
+			return NULL;
+		}
+
+		if (atom->GetHash() == p_hash) {
+			const char* key = atom->GetKey().GetData();
+			const char* str = p_str;
+
+			while (*key && *key == FoldChar(*str, p_mode)) {
+				key++;
+				str++;
+			}
+
+			if (!*key && !*str) {
+				return atom;
+			}
+		}
+	}
+}
+
+void MxAtomSet::Insert(Table* p_table, MxAtom* p_atom)
+{
+	MxU32 i = p_atom->GetHash() & p_table->m_mask;
+
+	while (p_table->m_slots[i]) {
+		i = (i + 1) & p_table->m_mask;
+	}
+
+	// Publish the fully constructed atom to concurrent lookups
+	SDL_SetAtomicPointer(&p_table->m_slots[i], p_atom);
+}
+
+MxAtom* MxAtomSet::Find(const char* p_str, LookupMode p_mode)
+{
+	return Probe(GetTable(), p_str, p_mode, Hash(p_str, p_mode));
+}
+
+MxAtom* MxAtomSet::Intern(const char* p_str, LookupMode p_mode)
+{
+	MxU32 hash = Hash(p_str, p_mode);
+	MxAtom* atom = Probe(GetTable(), p_str, p_mode, hash);
+
+	if (atom) {
+		return atom;
 	}
+
+	AUTOLOCK(m_criticalSection);
+
+	// Another thread may have added the atom while we were waiting
+	Table* table = GetTable();
+	if ((atom = Probe(table, p_str, p_mode, hash))) {
+		return atom;
+	}
+
+	atom = new MxAtom(p_str);
+	assert(atom);
+
+	switch (p_mode) {
+	case e_exact:
+		break;
+	case e_upperCase:
+		atom->GetKey().ToUpperCase();
+		break;
+	case e_lowerCase:
+	case e_lowerCase2:
+		atom->GetKey().ToLowerCase();
+		break;
+	}
+
+	// Lock-free probes must only ever read the key's cached hash
+	atom->GetKey().GetHash();
+	assert(atom->GetHash() == hash);
+
+	MxU32 count = SDL_GetAtomicInt(&m_count) + 1;
+	if (count * 2 > table->m_mask + 1) {
+		// Keep the load factor below one half so that probe sequences stay short
+		Table* grown = CreateTable((table->m_mask + 1) * 2);
+
+		for (MxU32 i = 0; i <= table->m_mask; i++) {
+			if (table->m_slots[i]) {
+				Insert(grown, (MxAtom*) table->m_slots[i]);
+			}
+		}
+
+		grown->m_retired = table;
+		SDL_SetAtomicPointer(&m_table, grown);
+		table = grown;
+	}
+
+	Insert(table, atom);
+	SDL_SetAtomicInt(&m_count, count);
+	return atom;
 }
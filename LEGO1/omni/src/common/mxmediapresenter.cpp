@@ -9,10 +9,15 @@
 #include "mxstreamchunk.h"
 #include "mxtimer.h"
 
+#include <SDL3/SDL_atomic.h>
+
 DECOMP_SIZE_ASSERT(MxMediaPresenter, 0x50);
 DECOMP_SIZE_ASSERT(MxStreamChunkList, 0x18);
 DECOMP_SIZE_ASSERT(MxStreamChunkListCursor, 0x10);
 
+// Payload bytes that LoopChunk did not have to copy
+static SDL_AtomicInt g_loopBytesShared;
+
 // FUNCTION: LEGO1 0x100b54e0
 void MxMediaPresenter::Init()
 {
@@ -45,7 +50,9 @@ void MxMediaPresenter::Destroy(MxBool p_fromDestructor)
 			MxStreamChunk* chunk;
 
 			while (cursor.Next(chunk)) {
-				chunk->Release();
+				if (!chunk->GetSharedBuffer()) {
+					chunk->Release();
+				}
 			}
 
 			delete m_loopingChunks;
@@ -233,16 +240,27 @@ void MxMediaPresenter::DoneTickle()
 void MxMediaPresenter::LoopChunk(MxStreamChunk* p_chunk)
 {
 	MxStreamChunk* chunk = new MxStreamChunk;
-
-	MxU32 length = p_chunk->GetLength();
-	chunk->SetLength(length);
-	chunk->SetData(new MxU8[length]);
 	chunk->SetTime(p_chunk->GetTime());
 
-	memcpy(chunk->GetData(), p_chunk->GetData(), chunk->GetLength());
+	if (chunk->ShareData(p_chunk)) {
+		SDL_AddAtomicInt(&g_loopBytesShared, chunk->GetLength());
+	}
+	else {
+		MxU32 length = p_chunk->GetLength();
+		chunk->SetLength(length);
+		chunk->SetData(new MxU8[length]);
+
+		memcpy(chunk->GetData(), p_chunk->GetData(), chunk->GetLength());
+	}
+
 	m_loopingChunks->Append(chunk);
 }
 
+MxU32 MxMediaPresenter::GetLoopBytesShared()
+{
+	return SDL_GetAtomicInt(&g_loopBytesShared);
+}
+
 // FUNCTION: LEGO1 0x100b6030
 // FUNCTION: BETA10 0x10136814
 void MxMediaPresenter::Enable(MxBool p_enable)
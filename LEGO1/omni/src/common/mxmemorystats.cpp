@@ -0,0 +1,118 @@
+#include "mxmemorystats.h"
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+#include <stdio.h>
+
+namespace
+{
+struct TagState {
+	SDL_SpinLock m_lock;
+	MxMemoryStats::Counters m_counters;
+	MxU32 m_loggedAllocations; // m_allocations as of the last log line
+};
+
+TagState g_tags[MxMemoryStats::e_numTags];
+MxU32 g_logInterval = 0;
+Uint64 g_lastLogTime = 0;
+
+const char* g_tagNames[MxMemoryStats::e_numTags] =
+	{"stream buffers", "memory pools", "textures", "meshes", "sounds", "lods"};
+} // namespace
+
+void MxMemoryStats::Add(Tag p_tag, MxU32 p_size)
+{
+	TagState& state = g_tags[p_tag];
+
+	SDL_LockSpinlock(&state.m_lock);
+	state.m_counters.m_live += p_size;
+	state.m_counters.m_allocations++;
+
+	if (state.m_counters.m_live > state.m_counters.m_peak) {
+		state.m_counters.m_peak = state.m_counters.m_live;
+	}
+
+	SDL_UnlockSpinlock(&state.m_lock);
+}
+
+void MxMemoryStats::Remove(Tag p_tag, MxU32 p_size)
+{
+	TagState& state = g_tags[p_tag];
+
+	SDL_LockSpinlock(&state.m_lock);
+	state.m_counters.m_live -= p_size;
+	state.m_counters.m_frees++;
+	SDL_UnlockSpinlock(&state.m_lock);
+}
+
+void MxMemoryStats::Get(Tag p_tag, Counters& p_counters)
+{
+	TagState& state = g_tags[p_tag];
+
+	SDL_LockSpinlock(&state.m_lock);
+	p_counters = state.m_counters;
+	SDL_UnlockSpinlock(&state.m_lock);
+}
+
+const char* MxMemoryStats::GetName(Tag p_tag)
+{
+	return g_tagNames[p_tag];
+}
+
+void MxMemoryStats::SetLogInterval(MxU32 p_milliseconds)
+{
+	g_logInterval = p_milliseconds;
+	g_lastLogTime = SDL_GetTicks();
+}
+
+void MxMemoryStats::Update()
+{
+	if (g_logInterval && SDL_GetTicks() - g_lastLogTime >= g_logInterval) {
+		Log();
+	}
+}
+
+// Logs live KB per tag, with the allocations per second since the last line in parentheses
+void MxMemoryStats::Log()
+{
+	Uint64 now = SDL_GetTicks();
+	Uint64 elapsed = now - g_lastLogTime;
+	char line[256];
+	MxS32 length = 0;
+
+	for (MxS32 i = 0; i < e_numTags; i++) {
+		Counters counters;
+		Get((Tag) i, counters);
+
+		MxU32 allocations = counters.m_allocations - g_tags[i].m_loggedAllocations;
+		g_tags[i].m_loggedAllocations = counters.m_allocations;
+
+		length += SDL_snprintf(
+			line + length,
+			sizeof(line) - length,
+			"%s%s %lld KB (%u/s)",
+			i ? ", " : "",
+			g_tagNames[i],
+			(long long) (counters.m_live / 1024),
+			elapsed ? (MxU32) (allocations * 1000 / elapsed) : 0
+		);
+
+		if (length >= (MxS32) sizeof(line)) {
+			break;
+		}
+	}
+
+	g_lastLogTime = now;
+	SDL_Log("Memory: %s", line);
+}
+
+void MxMemoryStats::MiniwinCallback(int p_delta)
+{
+	if (p_delta >= 0) {
+		Add(e_meshes, p_delta);
+	}
+	else {
+		Remove(e_meshes, -p_delta);
+	}
+}
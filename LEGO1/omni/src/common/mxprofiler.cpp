@@ -0,0 +1,248 @@
+#include "mxprofiler.h"
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_thread.h>
+#include <SDL3/SDL_timer.h>
+
+SDL_AtomicInt MxProfiler::g_enabled = {0};
+
+namespace
+{
+// Must be a power of two
+const MxU32 c_ringSize = 16384;
+const MxU32 c_maxDepth = 32;
+
+struct Event {
+	const char* m_name;
+	Uint64 m_start;
+	Uint64 m_duration;
+};
+
+struct ThreadBuffer {
+	SDL_ThreadID m_threadId;
+
+	// Taken by the owning thread to record and by WriteTrace and Reset to copy or
+	// clear the events, so the owner never waits for long
+	SDL_SpinLock m_lock;
+
+	// Zones begun and not yet ended. Deeper ones are still timed, just not recorded.
+	const char* m_openNames[c_maxDepth];
+	Uint64 m_openStarts[c_maxDepth];
+	MxU32 m_depth;
+
+	Event m_events[c_ringSize];
+	MxU32 m_next;
+	MxU32 m_count;
+
+	ThreadBuffer* m_nextBuffer;
+};
+
+// Not SDL_GetTLS, which allocates on a thread's first use
+thread_local ThreadBuffer* g_threadBuffer = NULL;
+
+// Buffers are only ever added at the head, so the list can be walked from a
+// head read under the lock without holding it
+SDL_SpinLock g_buffersLock = 0;
+ThreadBuffer* g_buffers = NULL;
+
+// Only touched by the main thread
+MxProfilerReservation* g_reservations = NULL;
+
+// Buffers stay around after their thread exits, so that its events still make it into the trace
+ThreadBuffer* CreateBuffer()
+{
+	ThreadBuffer* buffer = new ThreadBuffer;
+	buffer->m_threadId = SDL_GetCurrentThreadID();
+	buffer->m_lock = 0;
+	buffer->m_depth = 0;
+	buffer->m_next = 0;
+	buffer->m_count = 0;
+
+	SDL_LockSpinlock(&g_buffersLock);
+	buffer->m_nextBuffer = g_buffers;
+	g_buffers = buffer;
+	SDL_UnlockSpinlock(&g_buffersLock);
+
+	return buffer;
+}
+
+ThreadBuffer* GetThreadBuffer()
+{
+	if (!g_threadBuffer) {
+		g_threadBuffer = CreateBuffer();
+	}
+
+	return g_threadBuffer;
+}
+
+ThreadBuffer* GetBuffers()
+{
+	SDL_LockSpinlock(&g_buffersLock);
+	ThreadBuffer* buffers = g_buffers;
+	SDL_UnlockSpinlock(&g_buffersLock);
+	return buffers;
+}
+} // namespace
+
+MxProfilerReservation::MxProfilerReservation()
+{
+	m_buffer = MxProfiler::IsEnabled() ? CreateBuffer() : NULL;
+	m_next = g_reservations;
+	g_reservations = this;
+}
+
+MxProfilerReservation::~MxProfilerReservation()
+{
+	MxProfilerReservation** link = &g_reservations;
+
+	while (*link != this) {
+		link = &(*link)->m_next;
+	}
+
+	*link = m_next;
+}
+
+void MxProfiler::Enable(MxBool p_enable)
+{
+	// Reserved buffers are in place before any zone can see profiling enabled
+	if (p_enable) {
+		for (MxProfilerReservation* reservation = g_reservations; reservation; reservation = reservation->m_next) {
+			if (!SDL_GetAtomicPointer(&reservation->m_buffer)) {
+				SDL_SetAtomicPointer(&reservation->m_buffer, CreateBuffer());
+			}
+		}
+	}
+
+	SDL_SetAtomicInt(&g_enabled, p_enable);
+}
+
+// Only called once the zone has seen profiling enabled, so the buffer is there
+void MxProfiler::UseReservation(MxProfilerReservation* p_reservation)
+{
+	ThreadBuffer* buffer = (ThreadBuffer*) SDL_GetAtomicPointer(&p_reservation->m_buffer);
+	g_threadBuffer = buffer;
+
+	// The thread the events are shown on
+	SDL_ThreadID threadId = SDL_GetCurrentThreadID();
+	if (buffer->m_threadId != threadId) {
+		SDL_LockSpinlock(&buffer->m_lock);
+		buffer->m_threadId = threadId;
+		SDL_UnlockSpinlock(&buffer->m_lock);
+	}
+}
+
+void MxProfiler::Begin(const char* p_name)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	if (buffer->m_depth < c_maxDepth) {
+		buffer->m_openNames[buffer->m_depth] = p_name;
+		buffer->m_openStarts[buffer->m_depth] = SDL_GetPerformanceCounter();
+	}
+
+	buffer->m_depth++;
+}
+
+void MxProfiler::End()
+{
+	Uint64 end = SDL_GetPerformanceCounter();
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	// Profiling was enabled inside this zone
+	if (!buffer->m_depth) {
+		return;
+	}
+
+	buffer->m_depth--;
+
+	if (buffer->m_depth < c_maxDepth) {
+		SDL_LockSpinlock(&buffer->m_lock);
+
+		Event& event = buffer->m_events[buffer->m_next];
+		event.m_name = buffer->m_openNames[buffer->m_depth];
+		event.m_start = buffer->m_openStarts[buffer->m_depth];
+		event.m_duration = end - event.m_start;
+
+		buffer->m_next = (buffer->m_next + 1) & (c_ringSize - 1);
+		if (buffer->m_count < c_ringSize) {
+			buffer->m_count++;
+		}
+
+		SDL_UnlockSpinlock(&buffer->m_lock);
+	}
+}
+
+bool MxProfiler::MiniwinCallback(const char* p_name, bool p_begin)
+{
+	if (!p_begin) {
+		End();
+		return false;
+	}
+
+	if (!IsEnabled()) {
+		return false;
+	}
+
+	Begin(p_name);
+	return true;
+}
+
+void MxProfiler::Reset()
+{
+	for (ThreadBuffer* buffer = GetBuffers(); buffer; buffer = buffer->m_nextBuffer) {
+		SDL_LockSpinlock(&buffer->m_lock);
+		buffer->m_count = 0;
+		SDL_UnlockSpinlock(&buffer->m_lock);
+	}
+}
+
+MxResult MxProfiler::WriteTrace(const char* p_path)
+{
+	SDL_IOStream* file = SDL_IOFromFile(p_path, "w");
+	if (!file) {
+		return FAILURE;
+	}
+
+	// Timestamps are in microseconds
+	double scale = 1000000.0 / SDL_GetPerformanceFrequency();
+	MxBool first = TRUE;
+
+	// Each buffer is copied under its lock and written out after, so that a
+	// slow file never holds up the thread recording into it
+	Event* events = new Event[c_ringSize];
+
+	SDL_IOprintf(file, "{\"traceEvents\":[\n");
+
+	for (ThreadBuffer* buffer = GetBuffers(); buffer; buffer = buffer->m_nextBuffer) {
+		SDL_LockSpinlock(&buffer->m_lock);
+
+		SDL_ThreadID threadId = buffer->m_threadId;
+		MxU32 count = buffer->m_count;
+		MxU32 index = (buffer->m_next - count) & (c_ringSize - 1);
+
+		for (MxU32 i = 0; i < count; i++) {
+			events[i] = buffer->m_events[(index + i) & (c_ringSize - 1)];
+		}
+
+		SDL_UnlockSpinlock(&buffer->m_lock);
+
+		for (MxU32 i = 0; i < count; i++) {
+			SDL_IOprintf(
+				file,
+				"%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+				first ? "" : ",\n",
+				events[i].m_name,
+				(unsigned long long) threadId,
+				events[i].m_start * scale,
+				events[i].m_duration * scale
+			);
+			first = FALSE;
+		}
+	}
+
+	delete[] events;
+	SDL_IOprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	return SDL_CloseIO(file) ? SUCCESS : FAILURE;
+}
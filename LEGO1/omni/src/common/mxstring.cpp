@@ -3,77 +3,148 @@
 #include "decomp.h"
 #include "mxomni.h"
 
+#include <SDL3/SDL_atomic.h>
 #include <SDL3/SDL_log.h>
 #include <SDL3/SDL_platform_defines.h>
 #include <SDL3/SDL_stdinc.h>
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
+#include <utility>
 
-DECOMP_SIZE_ASSERT(MxString, 0x10)
+// Number of times any MxString had to fall back to a heap buffer
+static SDL_AtomicInt g_heapAllocations;
 
 // FUNCTION: LEGO1 0x100ae200
 // FUNCTION: BETA10 0x1012c110
 MxString::MxString()
 {
-	// Set string to one char in length and set that char to null terminator
-	this->m_data = new char[1];
-	this->m_data[0] = 0;
-	this->m_length = 0;
+	InitInline();
 }
 
 // FUNCTION: LEGO1 0x100ae2a0
 // FUNCTION: BETA10 0x1012c1a1
 MxString::MxString(const MxString& p_str)
 {
-	this->m_length = p_str.m_length;
-	this->m_data = new char[this->m_length + 1];
-	strcpy(this->m_data, p_str.m_data);
+	InitInline();
+	Append(p_str.m_data, p_str.m_length);
+	this->m_hash = p_str.m_hash;
 }
 
 // FUNCTION: LEGO1 0x100ae350
 // FUNCTION: BETA10 0x1012c24f
 MxString::MxString(const char* p_str)
 {
+	InitInline();
+
 	if (p_str) {
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
-	}
-	else {
-		this->m_data = new char[1];
-		this->m_data[0] = 0;
-		this->m_length = 0;
+		Append(p_str, strlen(p_str));
 	}
 }
 
 // FUNCTION: BETA10 0x1012c330
 MxString::MxString(const char* p_str, MxU16 p_maxlen)
 {
+	InitInline();
+
 	if (p_str) {
-		if (strlen(p_str) <= p_maxlen) {
-			this->m_length = strlen(p_str);
+		// Basically strncpy
+		size_t length = strlen(p_str);
+		Append(p_str, length <= p_maxlen ? length : p_maxlen);
+	}
+}
+
+MxString::MxString(MxString&& p_str) noexcept
+{
+	InitInline();
+	*this = std::move(p_str);
+}
+
+// FUNCTION: LEGO1 0x100ae420
+// FUNCTION: BETA10 0x1012c45b
+MxString::~MxString()
+{
+	if (!IsInline()) {
+		delete[] this->m_data;
+	}
+}
+
+void MxString::InitInline()
+{
+	this->m_data = this->m_inline;
+	this->m_data[0] = '\0';
+	this->m_length = 0;
+	this->m_capacity = c_inlineLength;
+	this->m_hash = 0;
+}
+
+// Longer lengths are clamped to what MxString can hold; Append checks for overflow
+void MxString::Reserve(MxU32 p_length)
+{
+	if (p_length > 0xffff) {
+		p_length = 0xffff;
+	}
+
+	if (p_length > this->m_capacity) {
+		char* data = new char[p_length + 1];
+		memcpy(data, this->m_data, this->m_length + 1);
+
+		if (!IsInline()) {
+			delete[] this->m_data;
 		}
-		else {
-			this->m_length = p_maxlen;
+
+		this->m_data = data;
+		this->m_capacity = p_length;
+		SDL_AddAtomicInt(&g_heapAllocations, 1);
+	}
+}
+
+MxString& MxString::Append(const char* p_str, MxU16 p_length)
+{
+	MxU32 newlen = this->m_length + p_length;
+	assert(newlen <= 0xffff);
+
+	if (newlen > this->m_capacity) {
+		// Grow geometrically so that repeated appends stay amortized O(1)
+		MxU32 capacity = this->m_capacity * 2;
+		if (capacity < newlen) {
+			capacity = newlen;
+		}
+		if (capacity > 0xffff) {
+			capacity = 0xffff;
 		}
 
-		// Basically strncpy
-		this->m_data = new char[this->m_length + 1];
-		memcpy(this->m_data, p_str, this->m_length);
-		this->m_data[this->m_length] = '\0';
+		// p_str may point into our own buffer, so only release it after copying
+		char* data = new char[capacity + 1];
+		memcpy(data, this->m_data, this->m_length);
+		memcpy(data + this->m_length, p_str, p_length);
+
+		if (!IsInline()) {
+			delete[] this->m_data;
+		}
+
+		this->m_data = data;
+		this->m_capacity = capacity;
+		SDL_AddAtomicInt(&g_heapAllocations, 1);
 	}
 	else {
-		this->m_data = new char[1];
-		this->m_data[0] = 0;
-		this->m_length = 0;
+		memmove(this->m_data + this->m_length, p_str, p_length);
 	}
+
+	this->m_length = newlen;
+	this->m_data[newlen] = '\0';
+	this->m_hash = 0;
+	return *this;
 }
 
-// FUNCTION: LEGO1 0x100ae420
-// FUNCTION: BETA10 0x1012c45b
-MxString::~MxString()
+// FNV-1a over the string contents, cached until the next modification.
+MxU32 MxString::GetHash() const
 {
-	delete[] this->m_data;
+	if (this->m_hash == 0) {
+		this->m_hash = Hash(this->m_data);
+	}
+
+	return this->m_hash;
 }
 
 // FUNCTION: BETA10 0x1012c4de
@@ -87,6 +158,8 @@ void MxString::Reverse()
 		start++;
 		end--;
 	}
+
+	this->m_hash = 0;
 }
 
 // FUNCTION: LEGO1 0x100ae490
@@ -94,6 +167,7 @@ void MxString::Reverse()
 void MxString::ToUpperCase()
 {
 	SDL_strupr(this->m_data);
+	this->m_hash = 0;
 }
 
 // FUNCTION: LEGO1 0x100ae4a0
@@ -101,6 +175,7 @@ void MxString::ToUpperCase()
 void MxString::ToLowerCase()
 {
 	SDL_strlwr(this->m_data);
+	this->m_hash = 0;
 }
 
 // FUNCTION: LEGO1 0x100ae4b0
@@ -108,10 +183,34 @@ void MxString::ToLowerCase()
 MxString& MxString::operator=(const MxString& p_str)
 {
 	if (this->m_data != p_str.m_data) {
-		delete[] this->m_data;
-		this->m_length = p_str.m_length;
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str.m_data);
+		this->m_length = 0;
+		Append(p_str.m_data, p_str.m_length);
+		this->m_hash = p_str.m_hash;
+	}
+
+	return *this;
+}
+
+MxString& MxString::operator=(MxString&& p_str) noexcept
+{
+	if (this != &p_str) {
+		this->m_hash = p_str.m_hash;
+
+		if (p_str.IsInline()) {
+			// Our capacity is never smaller than the inline buffer
+			memcpy(this->m_data, p_str.m_data, p_str.m_length + 1);
+			this->m_length = p_str.m_length;
+		}
+		else {
+			if (!IsInline()) {
+				delete[] this->m_data;
+			}
+
+			this->m_data = p_str.m_data;
+			this->m_length = p_str.m_length;
+			this->m_capacity = p_str.m_capacity;
+			p_str.InitInline();
+		}
 	}
 
 	return *this;
@@ -122,10 +221,19 @@ MxString& MxString::operator=(const MxString& p_str)
 const MxString& MxString::operator=(const char* p_str)
 {
 	if (this->m_data != p_str) {
-		delete[] this->m_data;
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
+		MxU16 length = strlen(p_str);
+
+		if (length <= this->m_capacity) {
+			// p_str may overlap with our own buffer
+			memmove(this->m_data, p_str, length);
+			this->m_length = length;
+			this->m_data[length] = '\0';
+			this->m_hash = 0;
+		}
+		else {
+			this->m_length = 0;
+			Append(p_str, length);
+		}
 	}
 
 	return *this;
@@ -135,15 +243,10 @@ const MxString& MxString::operator=(const char* p_str)
 MxString MxString::operator+(const MxString& p_str) const
 {
 	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = p_str.m_length + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
-
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str.m_data);
-
-	return MxString(tmp);
+	tmp.Reserve((MxU32) this->m_length + p_str.m_length);
+	tmp.Append(this->m_data, this->m_length);
+	tmp.Append(p_str.m_data, p_str.m_length);
+	return tmp;
 }
 
 // Return type is intentionally just MxString, not MxString&.
@@ -152,34 +255,20 @@ MxString MxString::operator+(const MxString& p_str) const
 // FUNCTION: BETA10 0x1012c78d
 MxString MxString::operator+(const char* p_str) const
 {
-	// MxString constructor allocates 1 byte for m_data, so free that first
-	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = strlen(p_str) + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
+	MxU16 length = strlen(p_str);
 
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str);
-
-	return MxString(tmp);
+	MxString tmp;
+	tmp.Reserve((MxU32) this->m_length + length);
+	tmp.Append(this->m_data, this->m_length);
+	tmp.Append(p_str, length);
+	return tmp;
 }
 
 // FUNCTION: LEGO1 0x100ae690
 // FUNCTION: BETA10 0x1012c92f
 MxString& MxString::operator+=(const char* p_str)
 {
-	int newlen = this->m_length + strlen(p_str);
-
-	char* tmp = new char[newlen + 1];
-	strcpy(tmp, this->m_data);
-	strcpy(tmp + this->m_length, p_str);
-
-	delete[] this->m_data;
-	this->m_data = tmp;
-	this->m_length = newlen;
-
-	return *this;
+	return Append(p_str, strlen(p_str));
 }
 
 // FUNCTION: BETA10 0x1012ca10
@@ -190,6 +279,25 @@ void MxString::CharSwap(char* p_a, char* p_b)
 	*p_b = t;
 }
 
+// FNV-1a
+MxU32 MxString::Hash(const char* p_str)
+{
+	MxU32 hash = 2166136261u;
+
+	while (*p_str) {
+		hash ^= (MxU8) *p_str++;
+		hash *= 16777619u;
+	}
+
+	// Zero marks a hash that has not been computed yet
+	return hash ? hash : 1;
+}
+
+MxU32 MxString::GetHeapAllocations()
+{
+	return SDL_GetAtomicInt(&g_heapAllocations);
+}
+
 void MxString::MapPathToFilesystem(char* p_path)
 {
 	// [library:filesystem]
@@ -2,6 +2,7 @@
 
 #include "decomp.h"
 #include "mxmisc.h"
+#include "mxprofiler.h"
 #include "mxtimer.h"
 #include "mxtypes.h"
 
@@ -35,6 +36,7 @@ MxTickleManager::~MxTickleManager()
 // FUNCTION: BETA10 0x1013eb1f
 MxResult MxTickleManager::Tickle()
 {
+	MxProfileZone zone("MxTickleManager::Tickle");
 	MxTime time = Timer()->GetTime();
 	MxTickleClientPtrList::iterator it;
 
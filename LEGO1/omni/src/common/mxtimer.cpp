@@ -1,6 +1,10 @@
 #include "mxtimer.h"
 
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_log.h>
 #include <SDL3/SDL_timer.h>
+#include <vector>
 
 // GLOBAL: LEGO1 0x10101414
 // GLOBAL: BETA10 0x10201f84
@@ -9,12 +13,38 @@ MxLong MxTimer::g_lastTimeCalculated = 0;
 // GLOBAL: LEGO1 0x10101418
 MxLong MxTimer::g_lastTimeTimerStarted = 0;
 
+MxTimer::ClockMode MxTimer::g_clockMode = MxTimer::e_realClock;
+MxU32 MxTimer::g_frameTime = 0;
+
+namespace
+{
+// Milliseconds of a virtual clock. It is read from other threads, and SDL has no 64-bit atomics.
+Uint64 g_clockTicks = 0;
+SDL_SpinLock g_clockLock = 0;
+
+MxU32 g_fixedStep = 0;
+
+std::vector<MxU32> g_replay;
+size_t g_replayPosition = 0;
+
+const char* g_recordingPath = NULL;
+std::vector<MxU32> g_recording;
+Uint64 g_lastRecordedTicks = 0;
+
+void SetClockTicks(Uint64 p_ticks)
+{
+	SDL_LockSpinlock(&g_clockLock);
+	g_clockTicks = p_ticks;
+	SDL_UnlockSpinlock(&g_clockLock);
+}
+} // namespace
+
 // FUNCTION: LEGO1 0x100ae060
 // FUNCTION: BETA10 0x1012bea0
 MxTimer::MxTimer()
 {
 	m_isRunning = FALSE;
-	m_startTime = SDL_GetTicks();
+	m_startTime = GetTicks();
 	InitLastTimeCalculated();
 }
 
@@ -22,7 +52,7 @@ MxTimer::MxTimer()
 // FUNCTION: BETA10 0x1012bf23
 MxLong MxTimer::GetRealTime()
 {
-	MxTimer::g_lastTimeCalculated = SDL_GetTicks();
+	MxTimer::g_lastTimeCalculated = GetTicks();
 	return MxTimer::g_lastTimeCalculated - m_startTime;
 }
 
@@ -42,3 +72,120 @@ void MxTimer::Stop()
 	// this feels very stupid but it's what the assembly does
 	m_startTime = m_startTime + startTime - 5;
 }
+
+Uint64 MxTimer::GetTicks()
+{
+	if (g_clockMode == e_realClock) {
+		return SDL_GetTicks();
+	}
+
+	SDL_LockSpinlock(&g_clockLock);
+	Uint64 ticks = g_clockTicks;
+	SDL_UnlockSpinlock(&g_clockLock);
+	return ticks;
+}
+
+void MxTimer::SetFixedStepClock(MxU32 p_step)
+{
+	// Virtual clocks start at zero, so absolute times repeat between runs as well
+	SetClockTicks(0);
+	g_clockMode = e_fixedStepClock;
+	g_fixedStep = p_step;
+}
+
+MxBool MxTimer::SetReplayClock(const char* p_path)
+{
+	size_t size;
+	char* text = (char*) SDL_LoadFile(p_path, &size);
+
+	if (!text) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load clock recording %s: %s", p_path, SDL_GetError());
+		return FALSE;
+	}
+
+	g_replay.clear();
+	for (char *next = text, *end; *next; next = end) {
+		unsigned long frameTime = SDL_strtoul(next, &end, 10);
+
+		if (end == next) {
+			break;
+		}
+
+		g_replay.push_back(frameTime);
+	}
+
+	SDL_free(text);
+
+	if (g_replay.empty()) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Clock recording %s has no frames", p_path);
+		return FALSE;
+	}
+
+	SetClockTicks(0);
+	g_clockMode = e_replayClock;
+	g_replayPosition = 0;
+	return TRUE;
+}
+
+void MxTimer::AdvanceClock()
+{
+	switch (g_clockMode) {
+	case e_realClock:
+		return;
+	case e_fixedStepClock:
+		g_frameTime = g_fixedStep;
+		break;
+	case e_replayClock:
+		if (g_replayPosition < g_replay.size()) {
+			g_frameTime = g_replay[g_replayPosition++];
+		}
+		break;
+	}
+
+	SetClockTicks(GetTicks() + g_frameTime);
+}
+
+MxBool MxTimer::IsReplayFinished()
+{
+	return g_clockMode == e_replayClock && g_replayPosition >= g_replay.size();
+}
+
+void MxTimer::StartRecording(const char* p_path)
+{
+	g_recordingPath = p_path;
+	g_recording.clear();
+}
+
+void MxTimer::RecordFrame()
+{
+	if (g_recordingPath) {
+		// The time the frame was paced against, as sampled by GetRealTime. The first frame
+		// is measured from the start of the timer, which is where a replay clock starts.
+		Uint64 ticks = (Uint64) g_lastTimeCalculated;
+		Uint64 lastTicks = g_recording.empty() ? m_startTime : g_lastRecordedTicks;
+		g_recording.push_back((MxU32) (ticks - lastTicks));
+		g_lastRecordedTicks = ticks;
+	}
+}
+
+MxBool MxTimer::StopRecording()
+{
+	if (!g_recordingPath) {
+		return TRUE;
+	}
+
+	SDL_IOStream* file = SDL_IOFromFile(g_recordingPath, "w");
+	g_recordingPath = NULL;
+
+	if (!file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write clock recording: %s", SDL_GetError());
+		return FALSE;
+	}
+
+	for (MxU32 frameTime : g_recording) {
+		SDL_IOprintf(file, "%u\n", frameTime);
+	}
+
+	g_recording.clear();
+	return SDL_CloseIO(file);
+}
@@ -11,14 +11,10 @@ MxS8 MxVariableTable::Compare(MxVariable* p_var0, MxVariable* p_var1)
 // FUNCTION: BETA10 0x1012a4a0
 MxU32 MxVariableTable::Hash(MxVariable* p_var)
 {
-	const char* str = p_var->GetKey()->GetData();
-	MxU32 value = 0;
-
-	for (MxS32 i = 0; str[i]; i++) {
-		value += str[i];
-	}
-
-	return value;
+	// Originally the sum of the key's characters, which put keys like "ACTOR_01"
+	// and "ACTOR_10" in the same slot. The key's cached hash spreads them out
+	// and is computed once per variable.
+	return p_var->GetKey()->GetHash();
 }
 
 // FUNCTION: LEGO1 0x100b73a0
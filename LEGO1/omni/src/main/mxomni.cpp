@@ -207,17 +207,8 @@ void MxOmni::Destroy()
 	delete m_notificationManager;
 	delete m_tickleManager;
 
-	if (m_atomSet) {
-		while (m_atomSet->size() != 0) {
-			// Pop each node and delete its value
-			MxAtomSet::iterator begin = m_atomSet->begin();
-			MxAtom* value = *begin;
-			m_atomSet->erase(begin);
-			delete value;
-		}
-
-		delete m_atomSet;
-	}
+	// MxAtomSet deletes its atoms
+	delete m_atomSet;
 
 	Init();
 }
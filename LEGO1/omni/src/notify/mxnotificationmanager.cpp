@@ -6,6 +6,7 @@
 #include "mxmisc.h"
 #include "mxnotificationparam.h"
 #include "mxparam.h"
+#include "mxprofiler.h"
 #include "mxticklemanager.h"
 #include "mxtypes.h"
 
@@ -89,6 +90,7 @@ MxResult MxNotificationManager::Send(MxCore* p_listener, const MxNotificationPar
 // FUNCTION: LEGO1 0x100ac800
 MxResult MxNotificationManager::Tickle()
 {
+	MxProfileZone zone("MxNotificationManager::Tickle");
 	m_sendList = new MxNotificationPtrList();
 	if (m_sendList == NULL) {
 		return FAILURE;
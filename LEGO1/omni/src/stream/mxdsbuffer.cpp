@@ -3,16 +3,16 @@
 #include "mxdiskstreamcontroller.h"
 #include "mxdschunk.h"
 #include "mxdsstreamingaction.h"
+#include "mxmemorystats.h"
 #include "mxmisc.h"
 #include "mxomni.h"
+#include "mxsharedbuffer.h"
 #include "mxstreamchunk.h"
 #include "mxstreamcontroller.h"
 #include "mxstreamer.h"
 #include "mxstreamprovider.h"
 #include "mxutilities.h"
 
-DECOMP_SIZE_ASSERT(MxDSBuffer, 0x34);
-
 // FUNCTION: LEGO1 0x100c6470
 // FUNCTION: BETA10 0x10156f00
 MxDSBuffer::MxDSBuffer()
@@ -28,6 +28,8 @@ MxDSBuffer::MxDSBuffer()
 	m_bytesRemaining = 0;
 	m_mode = e_preallocated;
 	m_unk0x30 = 0;
+	m_sharedBuffer = NULL;
+	m_heapSize = 0;
 }
 
 // FUNCTION: LEGO1 0x100c6530
@@ -41,6 +43,10 @@ MxDSBuffer::~MxDSBuffer()
 		case e_allocate:
 		case e_unknown:
 			delete[] m_pBuffer;
+
+			if (m_heapSize) {
+				MxMemoryStats::Remove(MxMemoryStats::e_streamBuffers, m_heapSize);
+			}
 			break;
 
 		case e_chunk:
@@ -52,6 +58,10 @@ MxDSBuffer::~MxDSBuffer()
 		}
 	}
 
+	if (m_sharedBuffer != NULL) {
+		m_sharedBuffer->Release();
+	}
+
 	m_unk0x14 = 0;
 	m_unk0x1c = 0;
 }
@@ -66,6 +76,11 @@ MxResult MxDSBuffer::AllocateBuffer(MxU32 p_bufferSize, Type p_mode)
 	case e_allocate:
 		m_pBuffer = new MxU8[p_bufferSize];
 		assert(m_pBuffer); // m_firstRiffChunk?
+
+		if (m_pBuffer) {
+			m_heapSize = p_bufferSize;
+			MxMemoryStats::Add(MxMemoryStats::e_streamBuffers, m_heapSize);
+		}
 		break;
 
 	case e_chunk:
@@ -98,6 +113,20 @@ MxResult MxDSBuffer::SetBufferPointer(MxU8* p_buffer, MxU32 p_size)
 	return SUCCESS;
 }
 
+// Ties this buffer to the shared block its preallocated data lives in
+void MxDSBuffer::SetSharedBuffer(MxSharedBuffer* p_sharedBuffer)
+{
+	if (p_sharedBuffer != NULL) {
+		p_sharedBuffer->AddRef();
+	}
+
+	if (m_sharedBuffer != NULL) {
+		m_sharedBuffer->Release();
+	}
+
+	m_sharedBuffer = p_sharedBuffer;
+}
+
 // FUNCTION: LEGO1 0x100c67b0
 // FUNCTION: BETA10 0x10157295
 MxResult MxDSBuffer::FUN_100c67b0(
@@ -4,8 +4,6 @@
 #include "mxdsstreamingaction.h"
 #include "mxramstreamprovider.h"
 
-DECOMP_SIZE_ASSERT(MxRAMStreamController, 0x98);
-
 // FUNCTION: LEGO1 0x100c6110
 MxResult MxRAMStreamController::Open(const char* p_filename)
 {
@@ -28,6 +26,7 @@ MxResult MxRAMStreamController::Open(const char* p_filename)
 			((MxRAMStreamProvider*) m_provider)->GetBufferOfFileSize(),
 			((MxRAMStreamProvider*) m_provider)->GetFileSize()
 		);
+		m_buffer.SetSharedBuffer(((MxRAMStreamProvider*) m_provider)->GetSharedBuffer());
 		return SUCCESS;
 	}
 
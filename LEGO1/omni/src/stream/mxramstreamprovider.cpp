@@ -4,11 +4,11 @@
 #include "mxdsbuffer.h"
 #include "mxdsfile.h"
 #include "mxomni.h"
+#include "mxsharedbuffer.h"
 #include "mxstreamcontroller.h"
 #include "mxutilities.h"
 
 DECOMP_SIZE_ASSERT(MxStreamProvider, 0x10)
-DECOMP_SIZE_ASSERT(MxRAMStreamProvider, 0x24)
 
 // FUNCTION: LEGO1 0x100d0730
 MxRAMStreamProvider::MxRAMStreamProvider()
@@ -18,6 +18,7 @@ MxRAMStreamProvider::MxRAMStreamProvider()
 	m_pBufferOfFileSize = NULL;
 	m_lengthInDWords = 0;
 	m_bufferForDWords = NULL;
+	m_sharedBuffer = NULL;
 }
 
 // FUNCTION: LEGO1 0x100d0930
@@ -50,7 +51,11 @@ MxRAMStreamProvider::~MxRAMStreamProvider()
 	m_bufferSize = 0;
 	m_fileSize = 0;
 
-	delete[] m_pBufferOfFileSize;
+	// Chunks looped by presenters may still hold on to the file contents
+	if (m_sharedBuffer != NULL) {
+		m_sharedBuffer->Release();
+		m_sharedBuffer = NULL;
+	}
 	m_pBufferOfFileSize = NULL;
 
 	m_lengthInDWords = 0;
@@ -82,7 +87,8 @@ MxResult MxRAMStreamProvider::SetResourceToGet(MxStreamController* p_resource)
 		m_fileSize = m_pFile->CalcFileSize();
 		if (m_fileSize != 0) {
 			m_bufferSize = m_pFile->GetBufferSize();
-			m_pBufferOfFileSize = new MxU8[m_fileSize];
+			m_sharedBuffer = new MxSharedBuffer(m_fileSize, MxMemoryStats::e_streamBuffers);
+			m_pBufferOfFileSize = m_sharedBuffer->GetData();
 			if (m_pBufferOfFileSize != NULL &&
 				m_pFile->Read((unsigned char*) m_pBufferOfFileSize, m_fileSize) == SUCCESS) {
 				m_lengthInDWords = m_pFile->GetLengthInDWords();
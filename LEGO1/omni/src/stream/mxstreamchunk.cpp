@@ -2,6 +2,7 @@
 
 #include "mxdsbuffer.h"
 #include "mxdssubscriber.h"
+#include "mxsharedbuffer.h"
 #include "mxutilities.h"
 
 // FUNCTION: LEGO1 0x100c2fe0
@@ -10,6 +11,10 @@ MxStreamChunk::~MxStreamChunk()
 	if (m_buffer) {
 		m_buffer->ReleaseRef(this);
 	}
+
+	if (m_sharedBuffer) {
+		m_sharedBuffer->Release();
+	}
 }
 
 // FUNCTION: LEGO1 0x100c3050
@@ -82,6 +87,33 @@ void MxStreamChunk::SetBuffer(MxDSBuffer* p_buffer)
 	m_buffer = p_buffer;
 }
 
+// Points this chunk at the payload of p_chunk instead of copying it. Only possible
+// if that payload lives in a shared buffer, which this chunk then keeps alive.
+MxBool MxStreamChunk::ShareData(MxStreamChunk* p_chunk)
+{
+	MxDSBuffer* buffer = p_chunk->GetBuffer();
+	MxSharedBuffer* sharedBuffer = p_chunk->GetSharedBuffer();
+
+	if (!sharedBuffer && buffer) {
+		sharedBuffer = buffer->GetSharedBuffer();
+	}
+
+	if (!sharedBuffer || !sharedBuffer->Contains(p_chunk->GetData(), p_chunk->GetLength())) {
+		return FALSE;
+	}
+
+	sharedBuffer->AddRef();
+
+	if (m_sharedBuffer) {
+		m_sharedBuffer->Release();
+	}
+
+	m_sharedBuffer = sharedBuffer;
+	m_data = p_chunk->GetData();
+	m_length = p_chunk->GetLength();
+	return TRUE;
+}
+
 // FUNCTION: LEGO1 0x100c3180
 // FUNCTION: BETA10 0x101515f1
 MxU16* MxStreamChunk::IntoFlags(MxU8* p_buffer)
@@ -18,7 +18,7 @@ DECOMP_SIZE_ASSERT(MxBitset<2>, 0x04);
 
 // FUNCTION: LEGO1 0x100b8f00
 // FUNCTION: BETA10 0x10145150
-MxStreamer::MxStreamer()
+MxStreamer::MxStreamer() : m_pool64(4), m_pool128(8), m_pool256(4)
 {
 	NotificationManager()->Register(this);
 }
@@ -27,13 +27,20 @@ MxStreamer::MxStreamer()
 // FUNCTION: BETA10 0x10145220
 MxResult MxStreamer::Create()
 {
-	if (m_pool64.Allocate() || m_pool128.Allocate()) {
+	if (m_pool64.Allocate() || m_pool128.Allocate() || m_pool256.Allocate()) {
 		return FAILURE;
 	}
 
 	return SUCCESS;
 }
 
+void MxStreamer::GetMemoryPoolStats(MxMemoryPoolStats p_stats[e_numMemoryPools])
+{
+	m_pool64.GetStats(p_stats[0]);
+	m_pool128.GetStats(p_stats[1]);
+	m_pool256.GetStats(p_stats[2]);
+}
+
 // FUNCTION: LEGO1 0x100b91d0
 // FUNCTION: BETA10 0x10145268
 MxStreamer::~MxStreamer()
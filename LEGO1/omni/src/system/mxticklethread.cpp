@@ -34,6 +34,11 @@ MxResult MxTickleThread::Run()
 			lastTickled = currentTime;
 		}
 
+		// A virtual clock only moves when the game loop advances it, so it is polled instead
+		if (!MxTimer::IsRealClock() && timeRemainingMS > 1) {
+			timeRemainingMS = 1;
+		}
+
 		Sleep(timeRemainingMS);
 	}
 
@@ -76,6 +76,27 @@ void MxFlcPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	}
 }
 
+// Grows p_bounds by a frame's changed rectangles, or sets it outright when p_grow is FALSE.
+// The result is in the rows of m_frameBitmap, which is stored bottom-up.
+void MxFlcPresenter::UnionFrameRects(MxU8* p_rects, MxS32 p_rectCount, MxRect32& p_bounds, MxBool p_grow) const
+{
+	for (MxS32 i = 0; i < p_rectCount; i++) {
+		MxRect32 rect = UnalignedRead<MxRect32>(p_rects);
+		p_rects += sizeof(MxRect32);
+
+		MxS32 top = m_flcHeader->height - 1 - rect.GetBottom();
+		rect.SetBottom(m_flcHeader->height - 1 - rect.GetTop());
+		rect.SetTop(top);
+
+		if (p_grow || i != 0) {
+			p_bounds |= rect;
+		}
+		else {
+			p_bounds = rect;
+		}
+	}
+}
+
 // FUNCTION: LEGO1 0x100b3620
 void MxFlcPresenter::RealizePalette()
 {
@@ -2,16 +2,10 @@
 
 #include <limits.h>
 
-DECOMP_SIZE_ASSERT(MxRegion, 0x1c)
-DECOMP_SIZE_ASSERT(MxSpan, 0x0c)
-DECOMP_SIZE_ASSERT(MxSegment, 0x08)
-DECOMP_SIZE_ASSERT(MxRegionCursor, 0x18)
-
 // FUNCTION: LEGO1 0x100c31c0
 // FUNCTION: BETA10 0x10148f00
 MxRegion::MxRegion()
 {
-	m_spanList = new MxSpanList;
 	m_boundingRect = MxRect32(INT_MAX, INT_MAX, -1, -1);
 }
 
@@ -19,14 +13,14 @@ MxRegion::MxRegion()
 // FUNCTION: BETA10 0x10148fe8
 MxRegion::~MxRegion()
 {
-	delete m_spanList;
 }
 
 // FUNCTION: LEGO1 0x100c3700
 // FUNCTION: BETA10 0x1014907a
 void MxRegion::Reset()
 {
-	m_spanList->DeleteAll();
+	m_bands.clear();
+	m_segments.clear();
 	m_boundingRect = MxRect32(INT_MAX, INT_MAX, -1, -1);
 }
 
@@ -34,52 +28,23 @@ void MxRegion::Reset()
 // FUNCTION: BETA10 0x101490bd
 void MxRegion::AddRect(MxRect32& p_rect)
 {
-	MxRect32 rect(p_rect);
-	MxRect32 newRect;
-	MxSpanListCursor cursor(m_spanList);
-	MxSpan* span;
-
-	while (!rect.Empty() && cursor.Next(span)) {
-		if (span->GetMin() >= rect.GetBottom()) {
-			MxSpan* newSpan = new MxSpan(rect);
-			cursor.Prepend(newSpan);
-			rect.SetTop(rect.GetBottom());
+	if (!p_rect.Empty()) {
+		Band band = {p_rect.GetTop(), p_rect.GetBottom(), 0, 1};
+		Segment segment = {p_rect.GetLeft(), p_rect.GetRight()};
+
+		if (m_bands.empty() || m_bands.back().m_max <= band.m_min) {
+			// Below everything so far, as when invalidating top to bottom
+			m_resultBands.swap(m_bands);
+			m_resultSegments.swap(m_segments);
+			AppendBand(band.m_min, band.m_max, &segment, 1, NULL, 0, e_union);
+			m_resultBands.swap(m_bands);
+			m_resultSegments.swap(m_segments);
 		}
-		else if (rect.GetTop() < span->GetMax()) {
-			if (rect.GetTop() < span->GetMin()) {
-				newRect = rect;
-				newRect.SetBottom(span->GetMin());
-				MxSpan* newSpan = new MxSpan(newRect);
-				cursor.Prepend(newSpan);
-				rect.SetTop(span->GetMin());
-			}
-			else if (span->GetMin() < rect.GetTop()) {
-				MxSpan* newSpan = span->Clone();
-				newSpan->SetMax(rect.GetTop());
-				span->SetMin(rect.GetTop());
-				cursor.Prepend(newSpan);
-			}
-
-			if (rect.GetBottom() < span->GetMax()) {
-				MxSpan* newSpan = span->Clone();
-				newSpan->SetMax(rect.GetBottom());
-				span->SetMin(rect.GetBottom());
-				newSpan->AddSegment(rect.GetLeft(), rect.GetRight());
-				cursor.Prepend(newSpan);
-				rect.SetTop(rect.GetBottom());
-			}
-			else {
-				span->AddSegment(rect.GetLeft(), rect.GetRight());
-				rect.SetTop(span->GetMax());
-			}
+		else {
+			Combine(&band, 1, &segment, e_union);
 		}
 	}
 
-	if (!rect.Empty()) {
-		MxSpan* newSpan = new MxSpan(rect);
-		m_spanList->Append(newSpan);
-	}
-
 	m_boundingRect |= p_rect;
 }
 
@@ -91,61 +56,244 @@ MxBool MxRegion::Intersects(MxRect32& p_rect)
 		return FALSE;
 	}
 
-	MxSpanListCursor cursor(m_spanList);
-	MxSpan* span;
+	for (MxU32 i = 0; i < m_bands.size(); i++) {
+		const Band& band = m_bands[i];
 
-	while (cursor.Next(span)) {
-		if (span->GetMin() >= p_rect.GetBottom()) {
+		if (band.m_min >= p_rect.GetBottom()) {
 			return FALSE;
 		}
 
-		if (span->GetMax() > p_rect.GetTop() && span->IntersectsH(p_rect)) {
-			return TRUE;
+		if (band.m_max > p_rect.GetTop()) {
+			for (MxU32 j = 0; j < band.m_numSegments; j++) {
+				const Segment& segment = m_segments[band.m_firstSegment + j];
+
+				if (p_rect.GetRight() <= segment.m_min) {
+					break;
+				}
+
+				if (segment.m_max > p_rect.GetLeft()) {
+					return TRUE;
+				}
+			}
 		}
 	}
 
 	return FALSE;
 }
 
+void MxRegion::Union(const MxRegion& p_region)
+{
+	if (&p_region != this && !p_region.m_bands.empty()) {
+		Combine(&p_region.m_bands[0], (MxU32) p_region.m_bands.size(), &p_region.m_segments[0], e_union);
+	}
+
+	m_boundingRect |= p_region.m_boundingRect;
+}
+
+void MxRegion::Intersect(const MxRect32& p_rect)
+{
+	if (p_rect.Empty()) {
+		Reset();
+		return;
+	}
+
+	Band band = {p_rect.GetTop(), p_rect.GetBottom(), 0, 1};
+	Segment segment = {p_rect.GetLeft(), p_rect.GetRight()};
+
+	Combine(&band, 1, &segment, e_intersect);
+	UpdateBoundingRect();
+}
+
+void MxRegion::Intersect(const MxRegion& p_region)
+{
+	if (&p_region == this) {
+		return;
+	}
+
+	if (p_region.m_bands.empty()) {
+		Reset();
+		return;
+	}
+
+	Combine(&p_region.m_bands[0], (MxU32) p_region.m_bands.size(), &p_region.m_segments[0], e_intersect);
+	UpdateBoundingRect();
+}
+
+// Replaces the region with the union or intersection of itself and the bands given.
+// Both sides are walked top to bottom once, cutting them into strips where
+// neither side starts or ends a band, and each strip's intervals are merged.
+void MxRegion::Combine(const Band* p_bands, MxU32 p_numBands, const Segment* p_segments, Operation p_op)
+{
+	m_resultBands.clear();
+	m_resultSegments.clear();
+
+	MxU32 numBands = (MxU32) m_bands.size();
+	const Band* bands = numBands ? &m_bands[0] : NULL;
+	const Segment* segments = numBands ? &m_segments[0] : NULL;
+	MxU32 a = 0;
+	MxU32 b = 0;
+	MxS32 y = INT_MIN;
+
+	while (a < numBands || b < p_numBands) {
+		const Band* bandA = a < numBands ? &bands[a] : NULL;
+		const Band* bandB = b < p_numBands ? &p_bands[b] : NULL;
+
+		if (p_op == e_intersect && (!bandA || !bandB)) {
+			break;
+		}
+
+		MxS32 topA = bandA ? Max(bandA->m_min, y) : INT_MAX;
+		MxS32 topB = bandB ? Max(bandB->m_min, y) : INT_MAX;
+		MxS32 top = Min(topA, topB);
+		MxBool inA = bandA && topA == top;
+		MxBool inB = bandB && topB == top;
+
+		// The strip ends where a band it is in ends or where the other band begins
+		MxS32 bottom = Min(inA ? bandA->m_max : topA, inB ? bandB->m_max : topB);
+
+		AppendBand(
+			top,
+			bottom,
+			inA ? &segments[bandA->m_firstSegment] : NULL,
+			inA ? bandA->m_numSegments : 0,
+			inB ? &p_segments[bandB->m_firstSegment] : NULL,
+			inB ? bandB->m_numSegments : 0,
+			p_op
+		);
+
+		y = bottom;
+
+		if (bandA && bandA->m_max <= y) {
+			a++;
+		}
+
+		if (bandB && bandB->m_max <= y) {
+			b++;
+		}
+	}
+
+	m_bands.swap(m_resultBands);
+	m_segments.swap(m_resultSegments);
+}
+
+// Appends the band [p_min, p_max) with the union or intersection of two sorted runs of intervals
+void MxRegion::AppendBand(
+	MxS32 p_min,
+	MxS32 p_max,
+	const Segment* p_a,
+	MxU32 p_numA,
+	const Segment* p_b,
+	MxU32 p_numB,
+	Operation p_op
+)
+{
+	MxU32 first = (MxU32) m_resultSegments.size();
+	MxU32 a = 0;
+	MxU32 b = 0;
+
+	if (p_op == e_union) {
+		while (a < p_numA || b < p_numB) {
+			Segment segment;
+
+			if (b >= p_numB || (a < p_numA && p_a[a].m_min <= p_b[b].m_min)) {
+				segment = p_a[a++];
+			}
+			else {
+				segment = p_b[b++];
+			}
+
+			if (m_resultSegments.size() > first && m_resultSegments.back().m_max >= segment.m_min) {
+				m_resultSegments.back().m_max = Max(m_resultSegments.back().m_max, segment.m_max);
+			}
+			else {
+				m_resultSegments.push_back(segment);
+			}
+		}
+	}
+	else {
+		while (a < p_numA && b < p_numB) {
+			Segment segment = {Max(p_a[a].m_min, p_b[b].m_min), Min(p_a[a].m_max, p_b[b].m_max)};
+
+			if (segment.m_min < segment.m_max) {
+				m_resultSegments.push_back(segment);
+			}
+
+			if (p_a[a].m_max < p_b[b].m_max) {
+				a++;
+			}
+			else {
+				b++;
+			}
+		}
+	}
+
+	MxU32 numSegments = (MxU32) m_resultSegments.size() - first;
+	if (!numSegments) {
+		return;
+	}
+
+	if (!m_resultBands.empty()) {
+		Band& prev = m_resultBands.back();
+
+		if (prev.m_max == p_min && prev.m_numSegments == numSegments) {
+			const Segment* above = &m_resultSegments[prev.m_firstSegment];
+			const Segment* below = &m_resultSegments[first];
+
+			MxU32 i = 0;
+			while (i < numSegments && above[i].m_min == below[i].m_min && above[i].m_max == below[i].m_max) {
+				i++;
+			}
+
+			if (i == numSegments) {
+				prev.m_max = p_max;
+				m_resultSegments.resize(first);
+				return;
+			}
+		}
+	}
+
+	Band band = {p_min, p_max, first, numSegments};
+	m_resultBands.push_back(band);
+}
+
+void MxRegion::UpdateBoundingRect()
+{
+	m_boundingRect = MxRect32(INT_MAX, INT_MAX, -1, -1);
+
+	if (!m_bands.empty()) {
+		m_boundingRect.SetTop(m_bands.front().m_min);
+		m_boundingRect.SetBottom(m_bands.back().m_max);
+
+		for (MxU32 i = 0; i < m_bands.size(); i++) {
+			const Band& band = m_bands[i];
+			m_boundingRect.SetLeft(Min(m_boundingRect.GetLeft(), m_segments[band.m_firstSegment].m_min));
+			m_boundingRect.SetRight(
+				Max(m_boundingRect.GetRight(), m_segments[band.m_firstSegment + band.m_numSegments - 1].m_max)
+			);
+		}
+	}
+}
+
 // FUNCTION: LEGO1 0x100c3f70
 // FUNCTION: BETA10 0x10149663
 MxRegionCursor::MxRegionCursor(MxRegion* p_region)
 {
 	m_region = p_region;
 	m_rect = NULL;
-	m_spanListCursor = new MxSpanListCursor(m_region->m_spanList);
-	m_segListCursor = NULL;
+	m_band = -1;
+	m_segment = -1;
 }
 
 // FUNCTION: LEGO1 0x100c40b0
 MxRegionCursor::~MxRegionCursor()
 {
-	if (m_rect) {
-		delete m_rect;
-	}
-
-	if (m_spanListCursor) {
-		delete m_spanListCursor;
-	}
-
-	if (m_segListCursor) {
-		delete m_segListCursor;
-	}
 }
 
 // FUNCTION: LEGO1 0x100c4140
 MxRect32* MxRegionCursor::Head()
 {
-	m_spanListCursor->Head();
-
-	MxSpan* span;
-	if (m_spanListCursor->Current(span)) {
-		CreateSegmentListCursor(span->m_segList);
-
-		MxSegment* segment;
-		m_segListCursor->First(segment);
-
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+	if (!m_region->m_bands.empty()) {
+		SetRect(0, m_region->m_bands[0].m_firstSegment);
 	}
 	else {
 		Reset();
@@ -157,16 +305,10 @@ MxRect32* MxRegionCursor::Head()
 // FUNCTION: LEGO1 0x100c41d0
 MxRect32* MxRegionCursor::Tail()
 {
-	m_spanListCursor->Tail();
-
-	MxSpan* span;
-	if (m_spanListCursor->Current(span)) {
-		CreateSegmentListCursor(span->m_segList);
-
-		MxSegment* segment;
-		m_segListCursor->Last(segment);
-
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+	if (!m_region->m_bands.empty()) {
+		MxS32 band = (MxS32) m_region->m_bands.size() - 1;
+		const MxRegion::Band& last = m_region->m_bands[band];
+		SetRect(band, last.m_firstSegment + last.m_numSegments - 1);
 	}
 	else {
 		Reset();
@@ -178,21 +320,17 @@ MxRect32* MxRegionCursor::Tail()
 // FUNCTION: LEGO1 0x100c4260
 MxRect32* MxRegionCursor::Next()
 {
-	MxSegment* segment;
-	MxSpan* span;
+	if (m_band >= 0) {
+		const MxRegion::Band& band = m_region->m_bands[m_band];
 
-	if (m_segListCursor && m_segListCursor->Next(segment)) {
-		m_spanListCursor->Current(span);
-
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
-		return m_rect;
+		if ((MxU32) m_segment + 1 < band.m_firstSegment + band.m_numSegments) {
+			SetRect(m_band, m_segment + 1);
+			return m_rect;
+		}
 	}
 
-	if (m_spanListCursor->Next(span)) {
-		CreateSegmentListCursor(span->m_segList);
-		m_segListCursor->First(segment);
-
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+	if ((MxU32) (m_band + 1) < m_region->m_bands.size()) {
+		SetRect(m_band + 1, m_region->m_bands[m_band + 1].m_firstSegment);
 		return m_rect;
 	}
 
@@ -203,21 +341,17 @@ MxRect32* MxRegionCursor::Next()
 // FUNCTION: LEGO1 0x100c4360
 MxRect32* MxRegionCursor::Prev()
 {
-	MxSegment* segment;
-	MxSpan* span;
-
-	if (m_segListCursor && m_segListCursor->Prev(segment)) {
-		m_spanListCursor->Current(span);
-
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+	if (m_band >= 0 && (MxU32) m_segment > m_region->m_bands[m_band].m_firstSegment) {
+		SetRect(m_band, m_segment - 1);
 		return m_rect;
 	}
 
-	if (m_spanListCursor->Prev(span)) {
-		CreateSegmentListCursor(span->m_segList);
-		m_segListCursor->Last(segment);
+	// A reset cursor steps back onto the last band
+	MxS32 band = m_band >= 0 ? m_band - 1 : (MxS32) m_region->m_bands.size() - 1;
 
-		SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+	if (band >= 0) {
+		const MxRegion::Band& prev = m_region->m_bands[band];
+		SetRect(band, prev.m_firstSegment + prev.m_numSegments - 1);
 		return m_rect;
 	}
 
@@ -228,7 +362,7 @@ MxRect32* MxRegionCursor::Prev()
 // FUNCTION: LEGO1 0x100c4460
 MxRect32* MxRegionCursor::Head(MxRect32& p_rect)
 {
-	m_spanListCursor->Reset();
+	Reset();
 	NextSpan(p_rect);
 	return m_rect;
 }
@@ -236,7 +370,7 @@ MxRect32* MxRegionCursor::Head(MxRect32& p_rect)
 // FUNCTION: LEGO1 0x100c4480
 MxRect32* MxRegionCursor::Tail(MxRect32& p_rect)
 {
-	m_spanListCursor->Reset();
+	Reset();
 	PrevSpan(p_rect);
 	return m_rect;
 }
@@ -244,113 +378,96 @@ MxRect32* MxRegionCursor::Tail(MxRect32& p_rect)
 // FUNCTION: LEGO1 0x100c44a0
 MxRect32* MxRegionCursor::Next(MxRect32& p_rect)
 {
-	MxSegment* segment;
-
-	if (m_segListCursor && m_segListCursor->Next(segment)) {
-		MxSpan* span;
+	if (m_band >= 0) {
+		const MxRegion::Band& band = m_region->m_bands[m_band];
 
-		m_spanListCursor->Current(span);
+		if ((MxU32) m_segment + 1 < band.m_firstSegment + band.m_numSegments) {
+			const MxRegion::Segment& segment = m_region->m_segments[m_segment + 1];
 
-		if (span->IntersectsV(p_rect) && segment->IntersectsH(p_rect)) {
-			SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
-			*m_rect &= p_rect;
-		}
-		else {
-			NextSpan(p_rect);
+			if (p_rect.GetBottom() > band.m_min && p_rect.GetTop() < band.m_max && p_rect.GetRight() > segment.m_min &&
+				p_rect.GetLeft() < segment.m_max) {
+				SetRect(m_band, m_segment + 1);
+				*m_rect &= p_rect;
+				return m_rect;
+			}
 		}
 	}
-	else {
-		NextSpan(p_rect);
-	}
 
+	NextSpan(p_rect);
 	return m_rect;
 }
 
 // FUNCTION: LEGO1 0x100c4590
 MxRect32* MxRegionCursor::Prev(MxRect32& p_rect)
 {
-	MxSegment* segment;
+	if (m_band >= 0) {
+		const MxRegion::Band& band = m_region->m_bands[m_band];
 
-	if (m_segListCursor && m_segListCursor->Prev(segment)) {
-		MxSpan* span;
+		if ((MxU32) m_segment > band.m_firstSegment) {
+			const MxRegion::Segment& segment = m_region->m_segments[m_segment - 1];
 
-		m_spanListCursor->Current(span);
-
-		if (span->IntersectsV(p_rect) && segment->IntersectsH(p_rect)) {
-			SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
-			*m_rect &= p_rect;
-		}
-		else {
-			PrevSpan(p_rect);
+			if (p_rect.GetBottom() > band.m_min && p_rect.GetTop() < band.m_max && p_rect.GetRight() > segment.m_min &&
+				p_rect.GetLeft() < segment.m_max) {
+				SetRect(m_band, m_segment - 1);
+				*m_rect &= p_rect;
+				return m_rect;
+			}
 		}
 	}
-	else {
-		PrevSpan(p_rect);
-	}
 
+	PrevSpan(p_rect);
 	return m_rect;
 }
 
 // FUNCTION: LEGO1 0x100c4680
 void MxRegionCursor::Reset()
 {
-	if (m_rect) {
-		delete m_rect;
-		m_rect = NULL;
-	}
-
-	m_spanListCursor->Reset();
-
-	if (m_segListCursor) {
-		delete m_segListCursor;
-		m_segListCursor = NULL;
-	}
-}
-
-// FUNCTION: LEGO1 0x100c46c0
-void MxRegionCursor::CreateSegmentListCursor(MxSegmentList* p_segList)
-{
-	if (m_segListCursor) {
-		delete m_segListCursor;
-	}
-
-	m_segListCursor = new MxSegmentListCursor(p_segList);
+	m_rect = NULL;
+	m_band = -1;
+	m_segment = -1;
 }
 
 // FUNCTION: LEGO1 0x100c4980
 void MxRegionCursor::SetRect(MxS32 p_left, MxS32 p_top, MxS32 p_right, MxS32 p_bottom)
 {
-	if (!m_rect) {
-		m_rect = new MxRect32;
-	}
-
+	m_rect = &m_current;
 	m_rect->SetLeft(p_left);
 	m_rect->SetTop(p_top);
 	m_rect->SetRight(p_right);
 	m_rect->SetBottom(p_bottom);
 }
 
+// Moves the cursor onto the given interval and sets the rect to it
+void MxRegionCursor::SetRect(MxS32 p_band, MxS32 p_segment)
+{
+	const MxRegion::Band& band = m_region->m_bands[p_band];
+	const MxRegion::Segment& segment = m_region->m_segments[p_segment];
+
+	m_band = p_band;
+	m_segment = p_segment;
+	SetRect(segment.m_min, band.m_min, segment.m_max, band.m_max);
+}
+
 // FUNCTION: LEGO1 0x100c4a20
 void MxRegionCursor::NextSpan(MxRect32& p_rect)
 {
-	MxSpan* span;
-	while (m_spanListCursor->Next(span)) {
-		if (p_rect.GetBottom() <= span->GetMin()) {
-			Reset();
-			return;
+	for (MxS32 i = m_band + 1; (MxU32) i < m_region->m_bands.size(); i++) {
+		const MxRegion::Band& band = m_region->m_bands[i];
+
+		if (p_rect.GetBottom() <= band.m_min) {
+			break;
 		}
 
-		if (p_rect.GetTop() < span->GetMax()) {
-			CreateSegmentListCursor(span->m_segList);
+		if (p_rect.GetTop() < band.m_max) {
+			for (MxU32 j = band.m_firstSegment; j < band.m_firstSegment + band.m_numSegments; j++) {
+				const MxRegion::Segment& segment = m_region->m_segments[j];
 
-			MxSegment* segment;
-			while (m_segListCursor->Next(segment)) {
-				if (p_rect.GetRight() <= segment->GetMin()) {
+				if (p_rect.GetRight() <= segment.m_min) {
 					break;
 				}
 
-				if (p_rect.GetLeft() < segment->GetMax()) {
-					SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+				if (p_rect.GetLeft() < segment.m_max) {
+					SetRect(i, j);
 					*m_rect &= p_rect;
 					return;
 				}
@@ -364,24 +481,25 @@ void MxRegionCursor::NextSpan(MxRect32& p_rect)
 // FUNCTION: LEGO1 0x100c4b50
 void MxRegionCursor::PrevSpan(MxRect32& p_rect)
 {
-	MxSpan* span;
-	while (m_spanListCursor->Prev(span)) {
-		if (span->GetMax() <= p_rect.GetTop()) {
-			Reset();
-			return;
+	MxS32 i = m_band >= 0 ? m_band - 1 : (MxS32) m_region->m_bands.size() - 1;
+
+	for (; i >= 0; i--) {
+		const MxRegion::Band& band = m_region->m_bands[i];
+
+		if (band.m_max <= p_rect.GetTop()) {
+			break;
 		}
 
-		if (span->GetMin() < p_rect.GetBottom()) {
-			CreateSegmentListCursor(span->m_segList);
+		if (band.m_min < p_rect.GetBottom()) {
+			for (MxS32 j = band.m_firstSegment + band.m_numSegments - 1; j >= (MxS32) band.m_firstSegment; j--) {
+				const MxRegion::Segment& segment = m_region->m_segments[j];
 
-			MxSegment* segment;
-			while (m_segListCursor->Prev(segment)) {
-				if (segment->GetMax() <= p_rect.GetLeft()) {
+				if (segment.m_max <= p_rect.GetLeft()) {
 					break;
 				}
 
-				if (segment->GetMin() < p_rect.GetRight()) {
-					SetRect(segment->GetMin(), span->GetMin(), segment->GetMax(), span->GetMax());
+				if (segment.m_min < p_rect.GetRight()) {
+					SetRect(i, j);
 					*m_rect &= p_rect;
 					return;
 				}
@@ -391,106 +509,3 @@ void MxRegionCursor::PrevSpan(MxRect32& p_rect)
 
 	Reset();
 }
-
-// FUNCTION: LEGO1 0x100c4c90
-MxSpan::MxSpan(MxS32 p_min, MxS32 p_max)
-{
-	m_min = p_min;
-	m_max = p_max;
-	m_segList = new MxSegmentList;
-}
-
-// FUNCTION: LEGO1 0x100c50e0
-// FUNCTION: BETA10 0x1014a2d6
-MxSpan::MxSpan(MxRect32& p_rect)
-{
-	m_min = p_rect.GetTop();
-	m_max = p_rect.GetBottom();
-	m_segList = new MxSegmentList;
-
-	MxSegment* segment = new MxSegment(p_rect.GetLeft(), p_rect.GetRight());
-	m_segList->Append(segment);
-}
-
-// FUNCTION: LEGO1 0x100c5280
-// FUNCTION: BETA10 0x1014a3fc
-void MxSpan::AddSegment(MxS32 p_min, MxS32 p_max)
-{
-	MxSegmentListCursor a(m_segList);
-	MxSegmentListCursor b(m_segList);
-
-	MxSegment* segment;
-	while (a.Next(segment) && segment->GetMax() < p_min) {
-		;
-	}
-
-	if (a.HasMatch()) {
-		if (p_min > segment->GetMin()) {
-			p_min = segment->GetMin();
-		}
-
-		while (segment->GetMin() < p_max) {
-			if (p_max < segment->GetMax()) {
-				p_max = segment->GetMax();
-			}
-
-			b = a;
-			b.Next();
-			a.Destroy();
-
-			if (!b.Current(segment)) {
-				break;
-			}
-
-			a = b;
-		}
-
-		if (a.HasMatch()) {
-			MxSegment* copy = new MxSegment(p_min, p_max);
-			a.Prepend(copy);
-		}
-		else {
-			MxSegment* copy = new MxSegment(p_min, p_max);
-			m_segList->Append(copy);
-		}
-	}
-	else {
-		MxSegment* copy = new MxSegment(p_min, p_max);
-		m_segList->Append(copy);
-	}
-}
-
-// FUNCTION: LEGO1 0x100c55d0
-MxSpan* MxSpan::Clone()
-{
-	MxSpan* clone = new MxSpan(m_min, m_max);
-
-	MxSegmentListCursor cursor(m_segList);
-	MxSegment* segment;
-
-	while (cursor.Next(segment)) {
-		clone->m_segList->Append(segment->Clone());
-	}
-
-	return clone;
-}
-
-// FUNCTION: LEGO1 0x100c57b0
-// FUNCTION: BETA10 0x1014aa46
-MxBool MxSpan::IntersectsH(MxRect32& p_rect)
-{
-	MxSegmentListCursor cursor(m_segList);
-	MxSegment* segment;
-
-	while (cursor.Next(segment)) {
-		if (p_rect.GetRight() <= segment->GetMin()) {
-			return FALSE;
-		}
-
-		if (segment->GetMax() > p_rect.GetLeft()) {
-			return TRUE;
-		}
-	}
-
-	return FALSE;
-}
@@ -0,0 +1,140 @@
+#ifndef MATHKERNEL_H
+#define MATHKERNEL_H
+
+#include <math.h>
+
+// Non-virtual counterparts of the Vector3 and Matrix4 operations that show up in
+// transform propagation, path actor steering and animation evaluation.
+// The classes in vector.h and matrix.h route every operation through their
+// vtables to match the original binary, which keeps the compiler from inlining
+// or vectorizing any of it. These kernels work on the same float data and are
+// meant to be called directly from hot paths; the virtual API forwards to them.
+//
+// Matrices are 16 floats in row-major order, vectors multiply from the left.
+// The SIMD paths are only selected when the target guarantees the instruction
+// set, so no runtime dispatch is needed. Their results match the scalar
+// fallback, which performs the operations in the same order.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATHKERNEL_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__3DS__)
+#define MATHKERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+// p_out = p_a * p_b. p_out may be the same matrix as p_a, but not as p_b.
+inline void Mat4Product(float* p_out, const float* p_a, const float* p_b)
+{
+#if defined(MATHKERNEL_SSE2)
+	__m128 b0 = _mm_loadu_ps(p_b);
+	__m128 b1 = _mm_loadu_ps(p_b + 4);
+	__m128 b2 = _mm_loadu_ps(p_b + 8);
+	__m128 b3 = _mm_loadu_ps(p_b + 12);
+
+	for (int row = 0; row < 16; row += 4) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(p_a[row]), b0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p_a[row + 1]), b1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p_a[row + 2]), b2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p_a[row + 3]), b3));
+		_mm_storeu_ps(p_out + row, r);
+	}
+#elif defined(MATHKERNEL_NEON)
+	float32x4_t b0 = vld1q_f32(p_b);
+	float32x4_t b1 = vld1q_f32(p_b + 4);
+	float32x4_t b2 = vld1q_f32(p_b + 8);
+	float32x4_t b3 = vld1q_f32(p_b + 12);
+
+	for (int row = 0; row < 16; row += 4) {
+		float32x4_t r = vmulq_n_f32(b0, p_a[row]);
+		r = vaddq_f32(r, vmulq_n_f32(b1, p_a[row + 1]));
+		r = vaddq_f32(r, vmulq_n_f32(b2, p_a[row + 2]));
+		r = vaddq_f32(r, vmulq_n_f32(b3, p_a[row + 3]));
+		vst1q_f32(p_out + row, r);
+	}
+#else
+	for (int row = 0; row < 16; row += 4) {
+		float a0 = p_a[row];
+		float a1 = p_a[row + 1];
+		float a2 = p_a[row + 2];
+		float a3 = p_a[row + 3];
+
+		for (int col = 0; col < 4; col++) {
+			p_out[row + col] = a0 * p_b[col] + a1 * p_b[4 + col] + a2 * p_b[8 + col] + a3 * p_b[12 + col];
+		}
+	}
+#endif
+}
+
+// p_out = (p_v, 1) * p_mat, the first three components
+inline void Vec3TransformPoint(float* p_out, const float* p_v, const float* p_mat)
+{
+#if defined(MATHKERNEL_SSE2)
+	__m128 r = _mm_mul_ps(_mm_set1_ps(p_v[0]), _mm_loadu_ps(p_mat));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p_v[1]), _mm_loadu_ps(p_mat + 4)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p_v[2]), _mm_loadu_ps(p_mat + 8)));
+	r = _mm_add_ps(r, _mm_loadu_ps(p_mat + 12));
+
+	float result[4];
+	_mm_storeu_ps(result, r);
+	p_out[0] = result[0];
+	p_out[1] = result[1];
+	p_out[2] = result[2];
+#elif defined(MATHKERNEL_NEON)
+	float32x4_t r = vmulq_n_f32(vld1q_f32(p_mat), p_v[0]);
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(p_mat + 4), p_v[1]));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(p_mat + 8), p_v[2]));
+	r = vaddq_f32(r, vld1q_f32(p_mat + 12));
+
+	float result[4];
+	vst1q_f32(result, r);
+	p_out[0] = result[0];
+	p_out[1] = result[1];
+	p_out[2] = result[2];
+#else
+	float x = p_v[0];
+	float y = p_v[1];
+	float z = p_v[2];
+
+	for (int i = 0; i < 3; i++) {
+		p_out[i] = x * p_mat[i] + y * p_mat[4 + i] + z * p_mat[8 + i] + p_mat[12 + i];
+	}
+#endif
+}
+
+inline float Vec3Dot(const float* p_a, const float* p_b)
+{
+	return p_a[0] * p_b[0] + p_a[1] * p_b[1] + p_a[2] * p_b[2];
+}
+
+// p_out = p_a x p_b. p_out may be the same vector as either input.
+inline void Vec3Cross(float* p_out, const float* p_a, const float* p_b)
+{
+	float x = p_a[1] * p_b[2] - p_a[2] * p_b[1];
+	float y = p_a[2] * p_b[0] - p_a[0] * p_b[2];
+	float z = p_a[0] * p_b[1] - p_a[1] * p_b[0];
+
+	p_out[0] = x;
+	p_out[1] = y;
+	p_out[2] = z;
+}
+
+// Same contract as Vector2::Unitize: 0 on success, -1 if p_v has no length
+inline int Vec3Unitize(float* p_v)
+{
+	float sq = Vec3Dot(p_v, p_v);
+
+	if (sq > 0.0f) {
+		sq = sqrt(sq);
+		if (sq > 0.0f) {
+			p_v[0] /= sq;
+			p_v[1] /= sq;
+			p_v[2] /= sq;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+#endif // MATHKERNEL_H
@@ -1,6 +1,7 @@
 #ifndef MATRIX4D_H
 #define MATRIX4D_H
 
+#include "mathkernel.h"
 #include "matrix.h"
 
 #include <math.h>
@@ -120,17 +121,7 @@ void Matrix4::SetTranslation(const float& p_x, const float& p_y, const float& p_
 // FUNCTION: BETA10 0x100100a0
 void Matrix4::Product(float (*p_a)[4], float (*p_b)[4])
 {
-	float* cur = (float*) m_data;
-
-	for (int row = 0; row < 4; row++) {
-		for (int col = 0; col < 4; col++) {
-			*cur = 0.0f;
-			for (int k = 0; k < 4; k++) {
-				*cur += p_a[row][k] * p_b[k][col];
-			}
-			cur++;
-		}
-	}
+	Mat4Product((float*) m_data, (const float*) p_a, (const float*) p_b);
 }
 
 // FUNCTION: LEGO1 0x10002530
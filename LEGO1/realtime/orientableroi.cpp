@@ -1,6 +1,7 @@
 #include "orientableroi.h"
 
 #include "decomp.h"
+#include "mathkernel.h"
 
 #include <vec.h>
 
@@ -129,7 +130,7 @@ void OrientableROI::SetLocal2WorldWithWorldDataUpdate(const Matrix4& p_transform
 void OrientableROI::UpdateWorldDataWithTransform(const Matrix4& p_transform)
 {
 	MxMatrix l_matrix(m_local2world);
-	m_local2world.Product(p_transform, l_matrix);
+	Mat4Product(m_local2world[0], p_transform[0], l_matrix[0]);
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 }
@@ -139,7 +140,7 @@ void OrientableROI::UpdateWorldDataWithTransform(const Matrix4& p_transform)
 void OrientableROI::UpdateWorldDataWithTransformAndChildren(const Matrix4& p_transform)
 {
 	MxMatrix l_matrix(m_local2world);
-	m_local2world.Product(l_matrix, p_transform);
+	Mat4Product(m_local2world[0], l_matrix[0], p_transform[0]);
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 
@@ -178,7 +179,7 @@ void CalcWorldBoundingVolumes(
 
 	// ??? we need to transform the radius too... if scaling...
 
-	V3XM4(world_bounding_sphere.Center(), modelling_sphere.Center(), local2world);
+	Vec3TransformPoint(&world_bounding_sphere.Center()[0], &modelling_sphere.Center()[0], local2world[0]);
 
 	world_bounding_sphere.Radius() = modelling_sphere.Radius();
 
@@ -1,15 +1,14 @@
 #ifndef VECTOR3D_H
 #define VECTOR3D_H
 
+#include "mathkernel.h"
 #include "vector2d.inl.h"
 
 // FUNCTION: LEGO1 0x10002270
 // FUNCTION: BETA10 0x10011350
 void Vector3::EqualsCrossImpl(const float* p_a, const float* p_b)
 {
-	m_data[0] = p_a[1] * p_b[2] - p_a[2] * p_b[1];
-	m_data[1] = p_a[2] * p_b[0] - p_a[0] * p_b[2];
-	m_data[2] = p_a[0] * p_b[1] - p_a[1] * p_b[0];
+	Vec3Cross(m_data, p_a, p_b);
 }
 
 // FUNCTION: LEGO1 0x100022c0
@@ -86,7 +85,7 @@ void Vector3::DivImpl(const float& p_value)
 // FUNCTION: BETA10 0x10011300
 float Vector3::DotImpl(const float* p_a, const float* p_b) const
 {
-	return p_a[0] * p_b[0] + p_a[1] * p_b[1] + p_a[2] * p_b[2];
+	return Vec3Dot(p_a, p_b);
 }
 
 // FUNCTION: LEGO1 0x10003ba0
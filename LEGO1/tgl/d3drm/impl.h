@@ -558,6 +558,13 @@ class MeshBuilderImpl : public MeshBuilder {
 
 	// vtable+0x10
 	MeshBuilder* Clone() override;
+	Mesh* CreateMesh(
+		unsigned int faceCount,
+		unsigned int vertexCount,
+		const MeshVertex* pVertices,
+		const unsigned int* pFaceIndices,
+		ShadingModel shadingModel
+	) override;
 
 	typedef IDirect3DRMMesh* MeshBuilderDataType;
 
@@ -48,63 +48,44 @@ Mesh* MeshBuilderImpl::CreateMesh(
 	return pMeshImpl;
 }
 
-// FUNCTION: BETA10 0x1016fef0
-inline Result CreateMesh(
+// Adds a group made of vertices and vertex indices expanded by Tgl::ExpandMeshData
+inline Result CreateExpandedMesh(
 	IDirect3DRMMesh* pD3DRM,
 	unsigned int p_numFaces,
 	unsigned int p_numVertices,
-	float(*p_positions),
-	float(*p_normals),
-	float(*p_textureCoordinates),
-	unsigned int (*p_faceIndices)[3],
-	unsigned int (*p_textureIndices)[3],
-	ShadingModel shadingModel,
+	const MeshVertex* p_vertices,
+	const unsigned int* p_faceIndices,
 	MeshImpl::MeshDataType& rpMesh
 )
 {
-	unsigned short* faceIndices = (unsigned short*) p_faceIndices;
 	D3DRMGROUPINDEX groupIndex = 0;
-	int faceCount = p_numFaces * 3;
-	int count = 0;
-
-	unsigned int* fData = new unsigned int[faceCount];
 
+#ifdef MINIWIN
+	static_assert(sizeof(MeshVertex) == sizeof(D3DRMVERTEX), "MeshVertex must match D3DRMVERTEX");
+	D3DRMVERTEX* vertices = (D3DRMVERTEX*) p_vertices;
+#else
 	D3DRMVERTEX* vertices = new D3DRMVERTEX[p_numVertices];
 	memset(vertices, 0, sizeof(*vertices) * p_numVertices);
 
+	for (unsigned int i = 0; i < p_numVertices; i++) {
+		vertices[i].position.x = p_vertices[i].m_position[0];
+		vertices[i].position.y = p_vertices[i].m_position[1];
+		vertices[i].position.z = p_vertices[i].m_position[2];
+		vertices[i].normal.x = p_vertices[i].m_normal[0];
+		vertices[i].normal.y = p_vertices[i].m_normal[1];
+		vertices[i].normal.z = p_vertices[i].m_normal[2];
+		vertices[i].tu = p_vertices[i].m_tu;
+		vertices[i].tv = p_vertices[i].m_tv;
+	}
+#endif
+
 	rpMesh = new MeshImpl::MeshData;
 	rpMesh->groupMesh = pD3DRM;
 
-	for (int i = 0; i < faceCount; i++) {
-		if (((faceIndices[2 * i + 1]) >> 0x0f) & 0x01) {
-			unsigned int j = 3 * faceIndices[2 * i];
-			vertices[count].position.x = p_positions[j];
-			vertices[count].position.y = p_positions[j + 1];
-			vertices[count].position.z = p_positions[j + 2];
-
-			int k = 3 * (faceIndices[2 * i + 1] & MAXSHORT);
-			vertices[count].normal.x = p_normals[k];
-			vertices[count].normal.y = p_normals[k + 1];
-			vertices[count].normal.z = p_normals[k + 2];
-
-			if (p_textureIndices != NULL && p_textureCoordinates != NULL) {
-				int kk = 2 * ((unsigned int*) p_textureIndices)[i];
-				vertices[count].tu = p_textureCoordinates[kk];
-				vertices[count].tv = p_textureCoordinates[kk + 1];
-			}
-
-			fData[i] = count;
-			count++;
-		}
-		else {
-			fData[i] = faceIndices[2 * i];
-		}
-	}
-
-	assert(count == (int) p_numVertices);
+	unsigned int* faceIndices = const_cast<unsigned int*>(p_faceIndices);
 
 	Result result;
-	result = ResultVal(pD3DRM->AddGroup(p_numVertices, p_numFaces, 3, fData, &groupIndex));
+	result = ResultVal(pD3DRM->AddGroup(p_numVertices, p_numFaces, 3, faceIndices, &groupIndex));
 
 	if (Succeeded(result)) {
 		rpMesh->groupIndex = groupIndex;
@@ -122,14 +103,46 @@ inline Result CreateMesh(
 		assert(Succeeded(result));
 	}
 
-	if (fData != NULL) {
-		delete[] fData;
-	}
+#ifndef MINIWIN
+	delete[] vertices;
+#endif
 
-	if (vertices != NULL) {
-		delete[] vertices;
-	}
+	return result;
+}
+
+// FUNCTION: BETA10 0x1016fef0
+inline Result CreateMesh(
+	IDirect3DRMMesh* pD3DRM,
+	unsigned int p_numFaces,
+	unsigned int p_numVertices,
+	float (*p_positions)[3],
+	float (*p_normals)[3],
+	float (*p_textureCoordinates)[2],
+	unsigned int (*p_faceIndices)[3],
+	unsigned int (*p_textureIndices)[3],
+	ShadingModel shadingModel,
+	MeshImpl::MeshDataType& rpMesh
+)
+{
+	unsigned int* fData = new unsigned int[p_numFaces * 3];
+	MeshVertex* vertices = new MeshVertex[p_numVertices];
+
+	ExpandMeshData(
+		p_numFaces,
+		p_numVertices,
+		p_positions,
+		p_normals,
+		p_textureCoordinates,
+		p_faceIndices,
+		p_textureIndices,
+		vertices,
+		fData
+	);
+
+	Result result = CreateExpandedMesh(pD3DRM, p_numFaces, p_numVertices, vertices, fData, rpMesh);
 
+	delete[] fData;
+	delete[] vertices;
 	return result;
 }
 
@@ -153,9 +166,9 @@ inline Result MeshBuilderImpl::CreateMeshImpl(
 		m_data,
 		faceCount,
 		vertexCount,
-		reinterpret_cast<float*>(pPositions),
-		reinterpret_cast<float*>(pNormals),
-		reinterpret_cast<float*>(pTextureCoordinates),
+		pPositions,
+		pNormals,
+		pTextureCoordinates,
 		pFaceIndices,
 		pTextureIndices,
 		shadingModel,
@@ -179,6 +192,74 @@ inline Result MeshBuilderGetBoundingBox(IDirect3DRMMesh* pMesh, float min[3], fl
 	return result;
 }
 
+void Tgl::ExpandMeshData(
+	unsigned int faceCount,
+	unsigned int vertexCount,
+	float (*pPositions)[3],
+	float (*pNormals)[3],
+	float (*pTextureCoordinates)[2],
+	unsigned int (*pFaceIndices)[3],
+	unsigned int (*pTextureIndices)[3],
+	MeshVertex* pVertices,
+	unsigned int* pExpandedFaceIndices
+)
+{
+	unsigned short* faceIndices = (unsigned short*) pFaceIndices;
+	int indexCount = faceCount * 3;
+	int count = 0;
+
+	memset(pVertices, 0, sizeof(*pVertices) * vertexCount);
+
+	for (int i = 0; i < indexCount; i++) {
+		if (((faceIndices[2 * i + 1]) >> 0x0f) & 0x01) {
+			unsigned int j = faceIndices[2 * i];
+			pVertices[count].m_position[0] = pPositions[j][0];
+			pVertices[count].m_position[1] = pPositions[j][1];
+			pVertices[count].m_position[2] = pPositions[j][2];
+
+			int k = faceIndices[2 * i + 1] & MAXSHORT;
+			pVertices[count].m_normal[0] = pNormals[k][0];
+			pVertices[count].m_normal[1] = pNormals[k][1];
+			pVertices[count].m_normal[2] = pNormals[k][2];
+
+			if (pTextureIndices != NULL && pTextureCoordinates != NULL) {
+				int kk = ((unsigned int*) pTextureIndices)[i];
+				pVertices[count].m_tu = pTextureCoordinates[kk][0];
+				pVertices[count].m_tv = pTextureCoordinates[kk][1];
+			}
+
+			pExpandedFaceIndices[i] = count;
+			count++;
+		}
+		else {
+			pExpandedFaceIndices[i] = faceIndices[2 * i];
+		}
+	}
+
+	assert(count == (int) vertexCount);
+}
+
+Mesh* MeshBuilderImpl::CreateMesh(
+	unsigned int faceCount,
+	unsigned int vertexCount,
+	const MeshVertex* pVertices,
+	const unsigned int* pFaceIndices,
+	ShadingModel shadingModel
+)
+{
+	assert(m_data);
+
+	MeshImpl* pMeshImpl = new MeshImpl;
+	MeshImpl::MeshDataType& rpMesh = pMeshImpl->ImplementationData();
+
+	if (CreateExpandedMesh(m_data, faceCount, vertexCount, pVertices, pFaceIndices, rpMesh) == Error) {
+		delete pMeshImpl;
+		pMeshImpl = NULL;
+	}
+
+	return pMeshImpl;
+}
+
 // FUNCTION: LEGO1 0x100a3ae0
 // FUNCTION: BETA10 0x1016ce00
 Result MeshBuilderImpl::GetBoundingBox(float min[3], float max[3]) const
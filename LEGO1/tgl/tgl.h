@@ -67,6 +67,16 @@ struct PaletteEntry {
 	unsigned char m_blue;
 };
 
+// Vertex after positions, normals and texture coordinates have been expanded
+// per face corner, i.e. the form a MeshBuilder ultimately hands to the renderer.
+// Matches the layout of miniwin's D3DRMVERTEX.
+struct MeshVertex {
+	float m_position[3];
+	float m_normal[3];
+	float m_tu;
+	float m_tv;
+};
+
 struct DeviceDirect3DCreateData {
 	IDirect3D2* m_pDirect3D;
 	IDirect3DDevice2* m_pDirect3DDevice;
@@ -394,6 +404,15 @@ class MeshBuilder : public Object {
 	virtual Result GetBoundingBox(float min[3], float max[3]) const = 0;
 	virtual MeshBuilder* Clone() = 0;
 
+	// Creates a mesh from data already expanded with ExpandMeshData
+	virtual Mesh* CreateMesh(
+		unsigned int faceCount,
+		unsigned int vertexCount,
+		const MeshVertex* pVertices,
+		const unsigned int* pFaceIndices,
+		ShadingModel shadingModel
+	) = 0;
+
 	// SYNTHETIC: BETA10 0x1016b630
 	// Tgl::MeshBuilder::MeshBuilder
 
@@ -406,6 +425,20 @@ class MeshBuilder : public Object {
 	// Tgl::MeshBuilder::`scalar deleting destructor'
 };
 
+// Expands the indexed data accepted by MeshBuilder::CreateMesh into vertexCount
+// vertices and faceCount * 3 vertex indices.
+void ExpandMeshData(
+	unsigned int faceCount,
+	unsigned int vertexCount,
+	float (*pPositions)[3],
+	float (*pNormals)[3],
+	float (*pTextureCoordinates)[2],
+	unsigned int (*pFaceIndices)[3],
+	unsigned int (*pTextureIndices)[3],
+	MeshVertex* pVertices,
+	unsigned int* pExpandedFaceIndices
+);
+
 // VTABLE: LEGO1 0x100dbb68
 // VTABLE: BETA10 0x101c3280
 class Texture : public Object {
@@ -1,13 +1,17 @@
 #include "viewmanager.h"
 
 #include "mxdirectx/mxstopwatch.h"
+#include "mxprofiler.h"
 #include "tgl/d3drm/impl.h"
 #include "viewlod.h"
 
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_thread.h>
+#include <string.h>
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(ViewManager, 0x1bc)
-
 // GLOBAL: LEGO1 0x100dbc78
 int g_boundingBoxCornerMap[8][3] =
 	{{0, 0, 0}, {0, 0, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 1}, {1, 0, 1}, {1, 1, 0}, {1, 1, 1}};
@@ -30,6 +34,37 @@ float g_viewDistance = 0.000125F;
 // GLOBAL: LEGO1 0x10101060
 float g_elapsedSeconds = 0;
 
+// Factor the projected size has to move past a LOD threshold before a ROI that
+// has already picked a LOD switches to another one. 1 disables the hysteresis.
+float g_lodHysteresis = 1.0F;
+
+// Helper threads for the read-only part of ViewManager::Update.
+// Each pass hands out the top-level ROIs in small batches to whichever thread is free.
+class ViewLODWorkers {
+public:
+	enum {
+		c_batchSize = 16
+	};
+
+	ViewLODWorkers(ViewManager* p_viewManager, int p_threads);
+	~ViewLODWorkers();
+
+	void Run(int p_numROIs);
+	int GetNumThreads() const { return m_threads.size(); }
+
+private:
+	static int SDLCALL ThreadProc(void* p_workers);
+	void Work();
+
+	ViewManager* m_viewManager;
+	vector<SDL_Thread*> m_threads;
+	SDL_Semaphore* m_start;
+	SDL_Semaphore* m_done;
+	SDL_AtomicInt m_next;
+	int m_numROIs;
+	bool m_quit;
+};
+
 inline void SetAppData(ViewROI* p_roi, LPD3DRM_APPDATA data);
 inline undefined4 GetD3DRM(IDirect3DRM2*& d3drm, Tgl::Renderer* pRenderer);
 inline undefined4 GetFrame(IDirect3DRMFrame2*& frame, Tgl::Group* scene);
@@ -51,12 +86,19 @@ ViewManager::ViewManager(Tgl::Renderer* pRenderer, Tgl::Group* scene, const Orie
 
 	memset(transformed_points, 0, sizeof(transformed_points));
 	seconds_allowed = 1.0;
+
+	memset(&m_lodStats, 0, sizeof(m_lodStats));
+	memset(m_lodPov, 0, sizeof(m_lodPov));
+	m_lodMaxPower = 0.0;
+	m_lodViewChanged = TRUE;
+	m_lodWorkers = NULL;
 }
 
 // FUNCTION: LEGO1 0x100a60c0
 ViewManager::~ViewManager()
 {
 	SetPOVSource(NULL);
+	delete m_lodWorkers;
 }
 
 // FUNCTION: LEGO1 0x100a6150
@@ -133,6 +175,7 @@ void ViewManager::RemoveAll(ViewROI* p_roi)
 		}
 
 		p_roi->SetLodLevel(ViewROI::c_lodLevelUnset);
+		p_roi->SetLODStateChanged();
 		const CompoundObject* comp = p_roi->GetComp();
 
 		if (comp != NULL) {
@@ -158,6 +201,8 @@ void ViewManager::UpdateROIDetailBasedOnLOD(ViewROI* p_roi, int p_lodLevel)
 		return;
 	}
 
+	m_lodStats.m_switched++;
+
 	Tgl::Group* group = p_roi->GetGeometry();
 	Tgl::MeshBuilder* meshBuilder;
 	ViewLOD* lod;
@@ -204,6 +249,8 @@ void ViewManager::RemoveROIDetailFromScene(ViewROI* p_roi)
 	const ViewLOD* lod = (const ViewLOD*) p_roi->GetLOD(p_roi->GetLodLevel());
 
 	if (lod != NULL) {
+		m_lodStats.m_switched++;
+
 		const Tgl::MeshBuilder* meshBuilder = NULL;
 		Tgl::Group* roiGeometry = p_roi->GetGeometry();
 
@@ -225,6 +272,8 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_from, i
 {
 	assert(p_from);
 
+	p_from->ClearLODStateChanged();
+
 	if (!p_from->GetVisibility() && p_lodLevel != ViewROI::c_lodLevelInvisible) {
 		ManageVisibilityAndDetailRecursively(p_from, ViewROI::c_lodLevelInvisible);
 	}
@@ -234,8 +283,12 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_from, i
 		if (p_lodLevel == ViewROI::c_lodLevelUnset) {
 			if (p_from->GetWorldBoundingSphere().Radius() > 0.001F) {
 				float projectedSize = ProjectedSize(p_from->GetWorldBoundingSphere());
+				int lodLevel = SelectLODLevel(projectedSize, p_from);
+
+				p_from->SetLodDecision(lodLevel);
+				p_from->ClearWorldChanged();
 
-				if (projectedSize < seconds_allowed * g_viewDistance) {
+				if (lodLevel == ViewROI::c_lodLevelInvisible) {
 					if (p_from->GetLodLevel() != ViewROI::c_lodLevelInvisible) {
 						ManageVisibilityAndDetailRecursively(p_from, ViewROI::c_lodLevelInvisible);
 					}
@@ -243,10 +296,12 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_from, i
 					return;
 				}
 				else {
-					p_lodLevel =
-						CalculateLODLevel(projectedSize, RealtimeView::GetUserMaxLodPower() * seconds_allowed, p_from);
+					p_lodLevel = lodLevel;
 				}
 			}
+			else {
+				p_from->SetLodDecision(ViewROI::c_lodLevelUnset);
+			}
 		}
 
 		if (p_lodLevel == ViewROI::c_lodLevelInvisible) {
@@ -279,12 +334,19 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_from, i
 // FUNCTION: LEGO1 0x100a6930
 void ViewManager::Update(float p_previousRenderTime, float)
 {
+	MxProfileZone zone("ViewManager::Update");
 	MxStopWatch stopWatch;
 	stopWatch.Start();
 
 	prev_render_time = p_previousRenderTime;
 	flags |= c_bit1;
 
+	// The point of view is handed in every frame, so compare it to see whether the camera moved
+	m_lodViewChanged = (flags & c_bit3) || memcmp(m_lodPov, pov[0], sizeof(m_lodPov)) ||
+					   m_lodMaxPower != RealtimeView::GetUserMaxLodPower();
+	memcpy(m_lodPov, pov[0], sizeof(m_lodPov));
+	m_lodMaxPower = RealtimeView::GetUserMaxLodPower();
+
 	if (flags & c_bit3) {
 		CalculateFrustumTransformations();
 	}
@@ -292,8 +354,33 @@ void ViewManager::Update(float p_previousRenderTime, float)
 		UpdateViewTransformations();
 	}
 
+	// First find the top-level ROIs that would come out unchanged. That part only
+	// reads the scene and may be spread over threads; the updates are made here.
+	m_lodRoots.clear();
+
 	for (CompoundObject::iterator it = rois.begin(); it != rois.end(); it++) {
-		ManageVisibilityAndDetailRecursively((ViewROI*) *it, ViewROI::c_lodLevelUnset);
+		m_lodRoots.push_back((ViewROI*) *it);
+	}
+
+	m_lodUpToDate.resize(m_lodRoots.size());
+
+	if (m_lodWorkers != NULL) {
+		m_lodWorkers->Run(m_lodRoots.size());
+	}
+	else {
+		FindUpToDateROIs(0, m_lodRoots.size());
+	}
+
+	memset(&m_lodStats, 0, sizeof(m_lodStats));
+
+	for (size_t i = 0; i < m_lodRoots.size(); i++) {
+		if (m_lodUpToDate[i]) {
+			m_lodStats.m_skipped++;
+		}
+		else {
+			m_lodStats.m_visited++;
+			ManageVisibilityAndDetailRecursively(m_lodRoots[i], ViewROI::c_lodLevelUnset);
+		}
 	}
 
 	stopWatch.Stop();
@@ -383,6 +470,194 @@ inline int ViewManager::CalculateLODLevel(float p_maximumScale, float p_initialS
 	return lodLevel;
 }
 
+// The LOD the original picks for p_projectedSize, c_lodLevelInvisible if it is too small
+// to draw. A ROI that already has a decision keeps it while the size is within
+// g_lodHysteresis of it, so objects at a threshold distance do not flip every frame.
+inline int ViewManager::SelectLODLevel(float p_projectedSize, ViewROI* p_from)
+{
+	float minimumSize = seconds_allowed * g_viewDistance;
+	float initialScale = RealtimeView::GetUserMaxLodPower() * seconds_allowed;
+	int previous = p_from->GetLodDecision();
+	int lodLevel = ViewROI::c_lodLevelInvisible;
+
+	if (p_projectedSize >= minimumSize) {
+		lodLevel = CalculateLODLevel(p_projectedSize, initialScale, p_from);
+	}
+
+	if (g_lodHysteresis > 1.0F && previous != ViewROI::c_lodLevelUnset && previous != lodLevel) {
+		// The decision grows with the size, c_lodLevelInvisible being the lowest
+		float smaller = p_projectedSize / g_lodHysteresis;
+		float larger = p_projectedSize * g_lodHysteresis;
+		int lowest =
+			smaller < minimumSize ? ViewROI::c_lodLevelInvisible : CalculateLODLevel(smaller, initialScale, p_from);
+		int highest =
+			larger < minimumSize ? ViewROI::c_lodLevelInvisible : CalculateLODLevel(larger, initialScale, p_from);
+
+		if (lowest <= previous && previous <= highest) {
+			return previous;
+		}
+	}
+
+	return lodLevel;
+}
+
+inline unsigned char ViewManager::HasChildLODStateChanged(const CompoundObject* p_comp)
+{
+	if (p_comp != NULL) {
+		for (CompoundObject::const_iterator it = p_comp->begin(); it != p_comp->end(); it++) {
+			ViewROI* roi = (ViewROI*) *it;
+
+			if (roi->HasLODStateChanged() || HasChildLODStateChanged(roi->GetComp())) {
+				return TRUE;
+			}
+		}
+	}
+
+	return FALSE;
+}
+
+// TRUE if ManageVisibilityAndDetailRecursively would leave p_roi and everything below it
+// as it is. Only reads the ROIs.
+inline unsigned char ViewManager::IsLODUpToDate(ViewROI* p_roi)
+{
+	if (p_roi->HasLODStateChanged()) {
+		return FALSE;
+	}
+
+	if (!p_roi->GetVisibility()) {
+		// Everything below was hidden on the last visit
+		return !HasChildLODStateChanged(p_roi->GetComp());
+	}
+
+	if (p_roi->GetWorldBoundingSphere().Radius() <= 0.001F) {
+		// The children pick their own LODs
+		return FALSE;
+	}
+
+	int lodLevel = p_roi->GetLodDecision();
+
+	if (m_lodViewChanged || p_roi->HasWorldChanged()) {
+		lodLevel = SelectLODLevel(ProjectedSize(p_roi->GetWorldBoundingSphere()), p_roi);
+	}
+
+	if (lodLevel == ViewROI::c_lodLevelUnset || lodLevel != p_roi->GetLodDecision()) {
+		return FALSE;
+	}
+
+	if (lodLevel == ViewROI::c_lodLevelInvisible && p_roi->GetLodLevel() == ViewROI::c_lodLevelInvisible) {
+		// The children are not looked at in this case
+		return TRUE;
+	}
+
+	// With the same LOD handed down, the children only depend on their visibility and LOD lists
+	return !HasChildLODStateChanged(p_roi->GetComp());
+}
+
+void ViewManager::FindUpToDateROIs(int p_begin, int p_end)
+{
+	for (int i = p_begin; i < p_end; i++) {
+		m_lodUpToDate[i] = IsLODUpToDate(m_lodRoots[i]);
+	}
+}
+
+void ViewManager::SetLODSelectionThreads(int p_threads)
+{
+	delete m_lodWorkers;
+	m_lodWorkers = p_threads > 0 ? new ViewLODWorkers(this, p_threads) : NULL;
+}
+
+int ViewManager::GetLODSelectionThreads() const
+{
+	return m_lodWorkers != NULL ? m_lodWorkers->GetNumThreads() : 0;
+}
+
+void ViewManager::SetLODHysteresis(float p_hysteresis)
+{
+	g_lodHysteresis = p_hysteresis > 1.0F ? p_hysteresis : 1.0F;
+}
+
+float ViewManager::GetLODHysteresis()
+{
+	return g_lodHysteresis;
+}
+
+ViewLODWorkers::ViewLODWorkers(ViewManager* p_viewManager, int p_threads)
+{
+	m_viewManager = p_viewManager;
+	m_start = SDL_CreateSemaphore(0);
+	m_done = SDL_CreateSemaphore(0);
+	m_numROIs = 0;
+	m_quit = false;
+	SDL_SetAtomicInt(&m_next, 0);
+
+	for (int i = 0; i < p_threads; i++) {
+		SDL_Thread* thread = SDL_CreateThread(&ThreadProc, "ViewLODWorker", this);
+
+		if (thread != NULL) {
+			m_threads.push_back(thread);
+		}
+	}
+}
+
+ViewLODWorkers::~ViewLODWorkers()
+{
+	m_quit = true;
+
+	for (size_t i = 0; i < m_threads.size(); i++) {
+		SDL_SignalSemaphore(m_start);
+	}
+
+	for (size_t i = 0; i < m_threads.size(); i++) {
+		SDL_WaitThread(m_threads[i], NULL);
+	}
+
+	SDL_DestroySemaphore(m_start);
+	SDL_DestroySemaphore(m_done);
+}
+
+void ViewLODWorkers::Run(int p_numROIs)
+{
+	m_numROIs = p_numROIs;
+	SDL_SetAtomicInt(&m_next, 0);
+
+	for (size_t i = 0; i < m_threads.size(); i++) {
+		SDL_SignalSemaphore(m_start);
+	}
+
+	Work();
+
+	for (size_t i = 0; i < m_threads.size(); i++) {
+		SDL_WaitSemaphore(m_done);
+	}
+}
+
+void ViewLODWorkers::Work()
+{
+	int begin;
+
+	while ((begin = SDL_AddAtomicInt(&m_next, c_batchSize)) < m_numROIs) {
+		m_viewManager->FindUpToDateROIs(begin, SDL_min(begin + c_batchSize, m_numROIs));
+	}
+}
+
+int SDLCALL ViewLODWorkers::ThreadProc(void* p_workers)
+{
+	ViewLODWorkers* workers = (ViewLODWorkers*) p_workers;
+
+	for (;;) {
+		SDL_WaitSemaphore(workers->m_start);
+
+		if (workers->m_quit) {
+			break;
+		}
+
+		workers->Work();
+		SDL_SignalSemaphore(workers->m_done);
+	}
+
+	return 0;
+}
+
 // FUNCTION: BETA10 0x10172cb0
 inline int ViewManager::GetFirstLODIndex(ViewROI* p_roi)
 {
@@ -12,6 +12,8 @@
 #include <d3drm.h>
 #endif
 
+class ViewLODWorkers;
+
 // VTABLE: LEGO1 0x100dbd88
 // SIZE 0x1bc
 class ViewManager {
@@ -48,12 +50,39 @@ class ViewManager {
 	const CompoundObject& GetROIs() { return rois; }
 
 	// FUNCTION: BETA10 0x100e1260
-	void Add(ViewROI* p_roi) { rois.push_back(p_roi); }
+	void Add(ViewROI* p_roi)
+	{
+		p_roi->SetLODStateChanged();
+		rois.push_back(p_roi);
+	}
+
+	// Not in the original: what the last Update did
+	struct LODStats {
+		unsigned int m_visited;  // top-level ROIs whose subtree was updated
+		unsigned int m_skipped;  // top-level ROIs left alone because nothing they depend on changed
+		unsigned int m_switched; // ROIs that changed LOD or were taken out of the scene
+	};
+
+	const LODStats& GetLODStats() const { return m_lodStats; }
+
+	// Number of helper threads deciding which top-level ROIs need an update, 0 to do it inline
+	LEGO1_EXPORT void SetLODSelectionThreads(int p_threads);
+	LEGO1_EXPORT int GetLODSelectionThreads() const;
+
+	// How far past a LOD threshold a ROI has to move before switching LOD, 1 (the default) for none
+	LEGO1_EXPORT static void SetLODHysteresis(float p_hysteresis);
+	LEGO1_EXPORT static float GetLODHysteresis();
 
 	// SYNTHETIC: LEGO1 0x100a6000
 	// ViewManager::`scalar deleting destructor'
 
 private:
+	inline int SelectLODLevel(float p_projectedSize, ViewROI* p_from);
+	inline unsigned char IsLODUpToDate(ViewROI* p_roi);
+	void FindUpToDateROIs(int p_begin, int p_end);
+
+	inline static unsigned char HasChildLODStateChanged(const CompoundObject* p_comp);
+
 	Tgl::Group* scene;              // 0x04
 	CompoundObject rois;            // 0x08
 	RealtimeView rt_view;           // 0x14
@@ -73,6 +102,17 @@ class ViewManager {
 	IDirect3DRM2* d3drm;            // 0x1b0
 	IDirect3DRMFrame2* frame;       // 0x1b4
 	float seconds_allowed;          // 0x1b8
+
+	// Not in the original, see Update
+	LODStats m_lodStats;
+	vector<ViewROI*> m_lodRoots;
+	vector<unsigned char> m_lodUpToDate;
+	float m_lodPov[4][4];
+	float m_lodMaxPower;
+	unsigned char m_lodViewChanged;
+	ViewLODWorkers* m_lodWorkers;
+
+	friend class ViewLODWorkers;
 };
 
 // TEMPLATE: LEGO1 0x10022030
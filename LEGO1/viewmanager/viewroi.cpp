@@ -4,8 +4,6 @@
 
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(ViewROI, 0xe4)
-
 // GLOBAL: LEGO1 0x101013d8
 unsigned char g_lightSupport = FALSE;
 
@@ -46,6 +44,8 @@ inline void ViewROI::SetGeometryTransformation()
 		SETMAT4(in, m_local2world);
 		geometry->SetTransformation(matrix);
 	}
+
+	m_lodWorldChanged = TRUE;
 }
 
 // FUNCTION: LEGO1 0x100a9fc0
@@ -28,6 +28,9 @@ class ViewROI : public OrientableROI {
 		SetLODList(lodList);
 		geometry = pRenderer->CreateGroup();
 		m_lodLevel = c_lodLevelUnset;
+		m_lodDecision = c_lodLevelUnset;
+		m_lodVisible = FALSE;
+		m_lodWorldChanged = TRUE;
 	}
 
 	// FUNCTION: LEGO1 0x100a9e20
@@ -56,6 +59,8 @@ class ViewROI : public OrientableROI {
 		if (lods) {
 			reinterpret_cast<ViewLODList*>(lods)->AddRef();
 		}
+
+		m_lodStateChanged = TRUE;
 	}
 
 	float IntrinsicImportance() const override;                                  // vtable+0x04
@@ -68,6 +73,21 @@ class ViewROI : public OrientableROI {
 	int GetLodLevel() { return m_lodLevel; }
 	void SetLodLevel(int p_lodLevel) { m_lodLevel = p_lodLevel; }
 
+	int GetLodDecision() { return m_lodDecision; }
+	void SetLodDecision(int p_lodDecision) { m_lodDecision = p_lodDecision; }
+
+	// TRUE if the visibility or LOD list of this ROI changed since ViewManager last visited it
+	unsigned char HasLODStateChanged() { return m_lodStateChanged || m_lodVisible != GetVisibility(); }
+	unsigned char HasWorldChanged() { return m_lodWorldChanged; }
+
+	void SetLODStateChanged() { m_lodStateChanged = TRUE; }
+	void ClearLODStateChanged()
+	{
+		m_lodVisible = GetVisibility();
+		m_lodStateChanged = FALSE;
+	}
+	void ClearWorldChanged() { m_lodWorldChanged = FALSE; }
+
 	static unsigned char SetLightSupport(unsigned char p_lightSupport);
 
 protected:
@@ -77,6 +97,13 @@ class ViewROI : public OrientableROI {
 
 	Tgl::Group* geometry; // 0xdc
 	int m_lodLevel;       // 0xe0
+
+	// Not in the original: what ViewManager::Update last saw of this ROI, so that
+	// it can leave subtrees alone while nothing they depend on has changed
+	int m_lodDecision;               // LOD picked from the projected size, or c_lodLevelUnset
+	unsigned char m_lodVisible;      // visibility at the last visit
+	unsigned char m_lodStateChanged; // LOD list replaced or ROI added to the view since then
+	unsigned char m_lodWorldChanged; // world transform updated since the last LOD decision
 };
 
 // SYNTHETIC: LEGO1 0x100aa250
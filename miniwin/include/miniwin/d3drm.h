@@ -39,6 +39,14 @@ enum class D3DRMTEXTUREQUALITY {
 };
 typedef D3DRMTEXTUREQUALITY* LPD3DRMTEXTUREQUALITY;
 
+#define D3DRMTEXTURE_CHANGEDPIXELS D3DRMTEXTURECHANGEDFLAGS::CHANGEDPIXELS
+#define D3DRMTEXTURE_CHANGEDPALETTE D3DRMTEXTURECHANGEDFLAGS::CHANGEDPALETTE
+enum class D3DRMTEXTURECHANGEDFLAGS : uint32_t {
+	CHANGEDPIXELS = 1 << 6,
+	CHANGEDPALETTE = 1 << 7,
+};
+ENABLE_BITMASK_OPERATORS(D3DRMTEXTURECHANGEDFLAGS)
+
 #define D3DRMRENDERMODE_BLENDEDTRANSPARENCY D3DRMRENDERMODE::BLENDEDTRANSPARENCY
 enum class D3DRMRENDERMODE {
 	BLENDEDTRANSPARENCY = 1
@@ -169,7 +177,11 @@ struct IDirect3DRMTexture : public IDirect3DRMVisual {
 };
 typedef IDirect3DRMTexture* LPDIRECT3DRMTEXTURE;
 
-struct IDirect3DRMTexture2 : public IDirect3DRMTexture {};
+struct IDirect3DRMTexture2 : public IDirect3DRMTexture {
+	using IDirect3DRMTexture::Changed;
+	// As in IDirect3DRMTexture3, lets the renderer update only the given rects
+	virtual HRESULT Changed(D3DRMTEXTURECHANGEDFLAGS flags, DWORD rectCount, LPRECT rects) = 0;
+};
 typedef IDirect3DRMTexture2* LPDIRECT3DRMTEXTURE2;
 
 struct IDirect3DRMMaterial : public IDirect3DRMObject {
@@ -4,6 +4,34 @@
 
 DEFINE_GUID(IID_IDirect3DRMMiniwinDevice, 0x6eb09673, 0x8d30, 0x4d8a, 0x8d, 0x81, 0x34, 0xea, 0x69, 0x30, 0x12, 0x01);
 
+// Accumulated since frame stats were enabled or last reset. Times are in
+// SDL_GetPerformanceCounter ticks. Triangles, lighting, rasterization and the
+// image hash are only filled in by the software renderer, which does that work
+// on the CPU.
+struct MiniwinFrameStats {
+	Uint32 frames;
+	Uint32 meshesTested;
+	Uint32 meshesCulled;
+	Uint32 draws;
+	Uint32 triangles;
+	Uint64 cullingTicks;
+	Uint64 lightingTicks;
+	Uint64 rasterizationTicks;
+	Uint64 presentTicks;
+	Uint32 imageHash; // FNV-1a of the last finished frame, to compare runs of the same scene
+};
+
+// Called around the renderer's own phases of a frame, for an external profiler.
+// Returns whether the zone was begun; only then is it called again to end it.
+typedef bool (*MiniwinProfileCallback)(const char* name, bool begin);
+
+// Called with the change in bytes whenever mesh vertex and index storage grows or shrinks
+typedef void (*MiniwinMemoryCallback)(int delta);
+
 struct IDirect3DRMMiniwinDevice : virtual public IUnknown {
 	virtual bool ConvertEventToRenderCoordinates(SDL_Event* event) = 0;
+	virtual void EnableFrameStats(bool enable) = 0;
+	virtual bool GetFrameStats(MiniwinFrameStats* stats, bool reset) = 0;
+	virtual void SetProfileCallback(MiniwinProfileCallback callback) = 0;
+	virtual void SetMemoryCallback(MiniwinMemoryCallback callback) = 0;
 };
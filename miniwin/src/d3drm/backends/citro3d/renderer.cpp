@@ -246,6 +246,7 @@ Uint32 Citro3DRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 					return NO_TEXTURE_ID;
 				}
 
+				texture->m_dirtyRect = {};
 				tex.version = texture->m_version;
 				tex.width = NearestPowerOfTwoClamp(originalW * m_viewportTransform.scale);
 				tex.height = NearestPowerOfTwoClamp(originalH * m_viewportTransform.scale);
@@ -263,6 +264,7 @@ Uint32 Citro3DRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 	if (!ConvertAndUploadTexture(&entry.c3dTex, originalSurface, isUi, m_viewportTransform.scale)) {
 		return NO_TEXTURE_ID;
 	}
+	texture->m_dirtyRect = {};
 
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
 		if (!m_textures[i].texture) {
@@ -279,25 +281,27 @@ Uint32 Citro3DRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 
 C3DMeshCacheEntry C3DUploadMesh(const MeshGroup& meshGroup)
 {
-	C3DMeshCacheEntry cache{&meshGroup, meshGroup.version};
+	C3DMeshCacheEntry cache{meshGroup.geometry.get(), meshGroup.geometry->version};
+	cache.flat = meshGroup.IsFlat();
+	cache.textured = meshGroup.texture != nullptr;
 
 	std::vector<D3DRMVERTEX> vertexBuffer;
 	std::vector<uint16_t> indexBuffer;
 
-	if (meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT) {
+	if (meshGroup.IsFlat()) {
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			meshGroup.texture != nullptr,
 			vertexBuffer,
 			indexBuffer
 		);
 	}
 	else {
-		vertexBuffer.assign(meshGroup.vertices.begin(), meshGroup.vertices.end());
-		indexBuffer.assign(meshGroup.indices.begin(), meshGroup.indices.end());
+		vertexBuffer.assign(meshGroup.geometry->vertices.begin(), meshGroup.geometry->vertices.end());
+		indexBuffer.assign(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end());
 	}
 
 	// Flatten vertices as IBO is buggy on 3DS hardware
@@ -316,15 +320,15 @@ C3DMeshCacheEntry C3DUploadMesh(const MeshGroup& meshGroup)
 	return cache;
 }
 
-void Citro3DRenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void Citro3DRenderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new Citro3DCacheDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject* obj, void* arg) {
 			auto* ctx = static_cast<Citro3DCacheDestroyContext*>(arg);
 			auto& cacheEntry = ctx->renderer->m_meshs[ctx->id];
-			if (cacheEntry.meshGroup) {
-				cacheEntry.meshGroup = nullptr;
+			if (cacheEntry.geometry) {
+				cacheEntry.geometry = nullptr;
 				linearFree(cacheEntry.vbo);
 				cacheEntry.vertexCount = 0;
 			}
@@ -338,8 +342,9 @@ Uint32 Citro3DRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGr
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				cache = std::move(C3DUploadMesh(*meshGroup));
 			}
 			return i;
@@ -350,15 +355,15 @@ Uint32 Citro3DRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGr
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
+		if (!cache.geometry) {
 			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
+			AddMeshDestroyCallback(i, meshGroup->geometry.get());
 			return i;
 		}
 	}
 
 	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
+	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), meshGroup->geometry.get());
 	return (Uint32) (m_meshs.size() - 1);
 }
 
@@ -30,7 +30,7 @@ struct IDirect3DRMTexture;
 struct IDirect3DTexture9;
 struct IDirect3DVertexBuffer9;
 struct IDirect3DIndexBuffer9;
-struct MeshGroup;
+struct MeshGeometry;
 
 struct D3D9TextureCacheEntry {
 	IDirect3DRMTexture* texture;
@@ -39,9 +39,10 @@ struct D3D9TextureCacheEntry {
 };
 
 struct D3D9MeshCacheEntry {
-	const MeshGroup* meshGroup;
+	const MeshGeometry* geometry;
 	uint32_t version;
 	bool flat;
+	bool textured;
 
 	IDirect3DVertexBuffer9* vbo;
 	uint32_t vertexCount;
@@ -93,6 +93,7 @@ Uint32 DirectX9Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 				if (!tex.dxTexture) {
 					return NO_TEXTURE_ID;
 				}
+				texture->m_dirtyRect = {};
 				tex.version = texture->m_version;
 			}
 			return i;
@@ -103,6 +104,7 @@ Uint32 DirectX9Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 	if (!newTex) {
 		return NO_TEXTURE_ID;
 	}
+	texture->m_dirtyRect = {};
 
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
 		auto& tex = m_textures[i];
@@ -123,28 +125,29 @@ Uint32 DirectX9Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 D3D9MeshCacheEntry UploadD3D9Mesh(const MeshGroup& meshGroup)
 {
 	D3D9MeshCacheEntry cache;
-	cache.meshGroup = &meshGroup;
-	cache.version = meshGroup.version;
-	cache.flat = meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT;
+	cache.geometry = meshGroup.geometry.get();
+	cache.version = meshGroup.geometry->version;
+	cache.flat = meshGroup.IsFlat();
+	cache.textured = meshGroup.texture != nullptr;
 
 	std::vector<D3DRMVERTEX> vertices;
 	std::vector<uint16_t> indices;
 
 	if (cache.flat) {
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			meshGroup.texture != nullptr,
 			vertices,
 			indices
 		);
 	}
 	else {
-		vertices = meshGroup.vertices;
-		indices.resize(meshGroup.indices.size());
-		std::transform(meshGroup.indices.begin(), meshGroup.indices.end(), indices.begin(), [](DWORD i) {
+		vertices = meshGroup.geometry->vertices;
+		indices.resize(meshGroup.geometry->indices.size());
+		std::transform(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end(), indices.begin(), [](DWORD i) {
 			return static_cast<uint16_t>(i);
 		});
 	}
@@ -168,10 +171,10 @@ struct D3D9MeshDestroyContext {
 	Uint32 id;
 };
 
-void DirectX9Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void DirectX9Renderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new D3D9MeshDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject*, void* arg) {
 			auto* ctx = static_cast<D3D9MeshDestroyContext*>(arg);
 			auto& cache = ctx->renderer->m_meshs[ctx->id];
@@ -183,7 +186,7 @@ void DirectX9Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
 				ReleaseD3DIndexBuffer(cache.ibo);
 				cache.ibo = nullptr;
 			}
-			cache.meshGroup = nullptr;
+			cache.geometry = nullptr;
 
 			delete ctx;
 		},
@@ -195,8 +198,9 @@ Uint32 DirectX9Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshG
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				cache = UploadD3D9Mesh(*meshGroup);
 			}
 			return i;
@@ -206,7 +210,7 @@ Uint32 DirectX9Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshG
 	auto newCache = UploadD3D9Mesh(*meshGroup);
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
-		if (!m_meshs[i].meshGroup) {
+		if (!m_meshs[i].geometry) {
 			m_meshs[i] = std::move(newCache);
 			return i;
 		}
@@ -9,7 +9,7 @@
 // We don't want to transitively include windows.h, but we need GLuint
 typedef unsigned int GLuint;
 struct IDirect3DRMTexture;
-struct MeshGroup;
+struct MeshGeometry;
 
 typedef float Matrix4x4[4][4];
 
@@ -44,9 +44,10 @@ struct GLTextureCacheEntry {
 };
 
 struct GLMeshCacheEntry {
-	const MeshGroup* meshGroup;
+	const MeshGeometry* geometry;
 	int version;
 	bool flat;
+	bool textured;
 
 	// non-VBO cache
 	std::vector<GL11_BridgeVector> positions;
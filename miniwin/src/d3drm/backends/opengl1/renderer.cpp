@@ -184,6 +184,7 @@ Uint32 OpenGL1Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 			if (tex.version != texture->m_version) {
 				GL11_DestroyTexture(tex.glTextureId);
 				tex.glTextureId = UploadTextureData(surface->m_surface, m_useNPOT, isUi);
+				texture->m_dirtyRect = {};
 				tex.version = texture->m_version;
 				tex.width = surface->m_surface->w;
 				tex.height = surface->m_surface->h;
@@ -193,6 +194,7 @@ Uint32 OpenGL1Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 	}
 
 	GLuint texId = UploadTextureData(surface->m_surface, m_useNPOT, isUi);
+	texture->m_dirtyRect = {};
 
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
 		auto& tex = m_textures[i];
@@ -220,26 +222,27 @@ Uint32 OpenGL1Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 
 GLMeshCacheEntry GLUploadMesh(const MeshGroup& meshGroup, bool useVBOs)
 {
-	GLMeshCacheEntry cache{&meshGroup, meshGroup.version};
+	GLMeshCacheEntry cache{meshGroup.geometry.get(), meshGroup.geometry->version};
 
-	cache.flat = meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT;
+	cache.flat = meshGroup.IsFlat();
+	cache.textured = meshGroup.texture != nullptr;
 
 	std::vector<D3DRMVERTEX> vertices;
 	if (cache.flat) {
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			meshGroup.texture != nullptr,
 			vertices,
 			cache.indices
 		);
 	}
 	else {
-		vertices = meshGroup.vertices;
-		cache.indices.resize(meshGroup.indices.size());
-		std::transform(meshGroup.indices.begin(), meshGroup.indices.end(), cache.indices.begin(), [](DWORD index) {
+		vertices = meshGroup.geometry->vertices;
+		cache.indices.resize(meshGroup.geometry->indices.size());
+		std::transform(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end(), cache.indices.begin(), [](DWORD index) {
 			return static_cast<uint16_t>(index);
 		});
 	}
@@ -269,14 +272,14 @@ struct GLMeshDestroyContext {
 	Uint32 id;
 };
 
-void OpenGL1Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void OpenGL1Renderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new GLMeshDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject*, void* arg) {
 			auto* ctx = static_cast<GLMeshDestroyContext*>(arg);
 			auto& cache = ctx->renderer->m_meshs[ctx->id];
-			cache.meshGroup = nullptr;
+			cache.geometry = nullptr;
 			GL11_DestroyMesh(cache);
 			delete ctx;
 		},
@@ -288,8 +291,9 @@ Uint32 OpenGL1Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGr
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				cache = std::move(GLUploadMesh(*meshGroup, m_useVBOs));
 			}
 			return i;
@@ -300,15 +304,15 @@ Uint32 OpenGL1Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* meshGr
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
+		if (!cache.geometry) {
 			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
+			AddMeshDestroyCallback(i, meshGroup->geometry.get());
 			return i;
 		}
 	}
 
 	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
+	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), meshGroup->geometry.get());
 	return (Uint32) (m_meshs.size() - 1);
 }
 
@@ -173,26 +173,27 @@ Direct3DRMRenderer* OpenGLES2Renderer::Create(DWORD width, DWORD height)
 
 GLES2MeshCacheEntry GLES2UploadMesh(const MeshGroup& meshGroup, bool forceUV = false)
 {
-	GLES2MeshCacheEntry cache{&meshGroup, meshGroup.version};
+	GLES2MeshCacheEntry cache{meshGroup.geometry.get(), meshGroup.geometry->version};
 
-	cache.flat = meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT;
+	cache.flat = meshGroup.IsFlat();
+	cache.textured = meshGroup.texture != nullptr;
 
 	std::vector<D3DRMVERTEX> vertices;
 	if (cache.flat) {
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			meshGroup.texture != nullptr || forceUV,
 			vertices,
 			cache.indices
 		);
 	}
 	else {
-		vertices = meshGroup.vertices;
-		cache.indices.resize(meshGroup.indices.size());
-		std::transform(meshGroup.indices.begin(), meshGroup.indices.end(), cache.indices.begin(), [](DWORD index) {
+		vertices = meshGroup.geometry->vertices;
+		cache.indices.resize(meshGroup.geometry->indices.size());
+		std::transform(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end(), cache.indices.begin(), [](DWORD index) {
 			return static_cast<uint16_t>(index);
 		});
 	}
@@ -245,13 +246,13 @@ OpenGLES2Renderer::OpenGLES2Renderer(DWORD width, DWORD height, SDL_GLContext co
 	ViewportTransform viewportTransform = {1.0f, 0.0f, 0.0f};
 	Resize(width, height, viewportTransform);
 
-	m_uiMesh.vertices = {
+	m_uiMesh.geometry->vertices = {
 		{{0.0f, 0.0f, 0.0f}, {0, 0, -1}, {0.0f, 0.0f}},
 		{{1.0f, 0.0f, 0.0f}, {0, 0, -1}, {1.0f, 0.0f}},
 		{{1.0f, 1.0f, 0.0f}, {0, 0, -1}, {1.0f, 1.0f}},
 		{{0.0f, 1.0f, 0.0f}, {0, 0, -1}, {0.0f, 1.0f}}
 	};
-	m_uiMesh.indices = {0, 1, 2, 0, 2, 3};
+	m_uiMesh.geometry->indices = {0, 1, 2, 0, 2, 3};
 	m_uiMeshCache = GLES2UploadMesh(m_uiMesh, true);
 	m_posLoc = glGetAttribLocation(m_shaderProgram, "a_position");
 	m_normLoc = glGetAttribLocation(m_shaderProgram, "a_normal");
@@ -373,6 +374,7 @@ Uint32 OpenGLES2Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 			if (tex.version != texture->m_version) {
 				glDeleteTextures(1, &tex.glTextureId);
 				if (UploadTexture(surface->m_surface, tex.glTextureId, isUi)) {
+					texture->m_dirtyRect = {};
 					tex.version = texture->m_version;
 				}
 			}
@@ -384,6 +386,7 @@ Uint32 OpenGLES2Renderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 	if (!UploadTexture(surface->m_surface, texId, isUi)) {
 		return NO_TEXTURE_ID;
 	}
+	texture->m_dirtyRect = {};
 
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
 		auto& tex = m_textures[i];
@@ -410,14 +413,14 @@ struct GLES2MeshDestroyContext {
 	Uint32 id;
 };
 
-void OpenGLES2Renderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void OpenGLES2Renderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new GLES2MeshDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject*, void* arg) {
 			auto* ctx = static_cast<GLES2MeshDestroyContext*>(arg);
 			auto& cache = ctx->renderer->m_meshs[ctx->id];
-			cache.meshGroup = nullptr;
+			cache.geometry = nullptr;
 			glDeleteBuffers(1, &cache.vboPositions);
 			glDeleteBuffers(1, &cache.vboNormals);
 			glDeleteBuffers(1, &cache.vboTexcoords);
@@ -432,8 +435,9 @@ Uint32 OpenGLES2Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* mesh
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				cache = std::move(GLES2UploadMesh(*meshGroup));
 			}
 			return i;
@@ -444,15 +448,15 @@ Uint32 OpenGLES2Renderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGroup* mesh
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
+		if (!cache.geometry) {
 			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
+			AddMeshDestroyCallback(i, meshGroup->geometry.get());
 			return i;
 		}
 	}
 
 	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
+	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), meshGroup->geometry.get());
 	return (Uint32) (m_meshs.size() - 1);
 }
 
@@ -337,13 +337,13 @@ Direct3DRMSDL3GPURenderer::Direct3DRMSDL3GPURenderer(
 	ViewportTransform viewportTransform = {1.0f, 0.0f, 0.0f};
 	Resize(m_width, m_height, viewportTransform);
 
-	m_uiMesh.vertices = {
+	m_uiMesh.geometry->vertices = {
 		{{0.0f, 0.0f, 0.0f}, {0, 0, -1}, {0.0f, 0.0f}},
 		{{1.0f, 0.0f, 0.0f}, {0, 0, -1}, {1.0f, 0.0f}},
 		{{1.0f, 1.0f, 0.0f}, {0, 0, -1}, {1.0f, 1.0f}},
 		{{0.0f, 1.0f, 0.0f}, {0, 0, -1}, {0.0f, 1.0f}}
 	};
-	m_uiMesh.indices = {0, 1, 2, 0, 2, 3};
+	m_uiMesh.geometry->indices = {0, 1, 2, 0, 2, 3};
 	m_uiMeshCache = UploadMesh(m_uiMesh);
 }
 
@@ -514,6 +514,7 @@ Uint32 Direct3DRMSDL3GPURenderer::GetTextureId(IDirect3DRMTexture* iTexture, boo
 				if (!tex.gpuTexture) {
 					return NO_TEXTURE_ID;
 				}
+				texture->m_dirtyRect = {};
 				tex.version = texture->m_version;
 			}
 			return i;
@@ -524,6 +525,7 @@ Uint32 Direct3DRMSDL3GPURenderer::GetTextureId(IDirect3DRMTexture* iTexture, boo
 	if (!newTex) {
 		return NO_TEXTURE_ID;
 	}
+	texture->m_dirtyRect = {};
 
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
 		auto& tex = m_textures[i];
@@ -544,13 +546,13 @@ SDL3MeshCache Direct3DRMSDL3GPURenderer::UploadMesh(const MeshGroup& meshGroup)
 	std::vector<D3DRMVERTEX> finalVertices;
 	std::vector<Uint16> finalIndices;
 
-	if (meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT) {
+	if (meshGroup.IsFlat()) {
 		std::vector<uint16_t> newIndices;
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			true,
 			finalVertices,
 			newIndices
@@ -559,8 +561,8 @@ SDL3MeshCache Direct3DRMSDL3GPURenderer::UploadMesh(const MeshGroup& meshGroup)
 		finalIndices.assign(newIndices.begin(), newIndices.end());
 	}
 	else {
-		finalVertices = meshGroup.vertices;
-		finalIndices.assign(meshGroup.indices.begin(), meshGroup.indices.end());
+		finalVertices = meshGroup.geometry->vertices;
+		finalIndices.assign(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end());
 	}
 
 	SDL_GPUBufferCreateInfo vertexBufferCreateInfo = {};
@@ -624,7 +626,15 @@ SDL3MeshCache Direct3DRMSDL3GPURenderer::UploadMesh(const MeshGroup& meshGroup)
 	SDL_EndGPUCopyPass(copyPass);
 	m_uploadFence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdbuf);
 
-	return {&meshGroup, meshGroup.version, vertexBuffer, indexBuffer, finalIndices.size()};
+	return {
+		meshGroup.geometry.get(),
+		meshGroup.geometry->version,
+		vertexBuffer,
+		indexBuffer,
+		finalIndices.size(),
+		meshGroup.IsFlat(),
+		meshGroup.texture != nullptr
+	};
 }
 
 struct SDLMeshDestroyContext {
@@ -632,16 +642,16 @@ struct SDLMeshDestroyContext {
 	Uint32 id;
 };
 
-void Direct3DRMSDL3GPURenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void Direct3DRMSDL3GPURenderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new SDLMeshDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject*, void* arg) {
 			auto* ctx = static_cast<SDLMeshDestroyContext*>(arg);
 			auto& cache = ctx->renderer->m_meshs[ctx->id];
 			SDL_ReleaseGPUBuffer(ctx->renderer->m_device, cache.vertexBuffer);
 			SDL_ReleaseGPUBuffer(ctx->renderer->m_device, cache.indexBuffer);
-			cache.meshGroup = nullptr;
+			cache.geometry = nullptr;
 			delete ctx;
 		},
 		ctx
@@ -652,8 +662,9 @@ Uint32 Direct3DRMSDL3GPURenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGro
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				SDL_ReleaseGPUBuffer(m_device, cache.vertexBuffer);
 				SDL_ReleaseGPUBuffer(m_device, cache.indexBuffer);
 				cache = std::move(UploadMesh(*meshGroup));
@@ -666,15 +677,15 @@ Uint32 Direct3DRMSDL3GPURenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGro
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
+		if (!cache.geometry) {
 			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
+			AddMeshDestroyCallback(i, meshGroup->geometry.get());
 			return i;
 		}
 	}
 
 	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
+	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), meshGroup->geometry.get());
 	return (Uint32) (m_meshs.size() - 1);
 }
 
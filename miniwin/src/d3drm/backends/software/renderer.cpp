@@ -359,6 +359,7 @@ void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 	ProjectVertex(v1.position, p1);
 	ProjectVertex(v2.position, p2);
 
+	Uint64 lightingStart = m_frameStatsEnabled ? SDL_GetPerformanceCounter() : 0;
 	Uint8 r, g, b;
 	SDL_Color c0 = ApplyLighting(v0.position, v0.normal, appearance);
 	SDL_Color c1 = {}, c2 = {};
@@ -366,6 +367,10 @@ void Direct3DRMSoftwareRenderer::DrawTriangleProjected(
 		c1 = ApplyLighting(v1.position, v1.normal, appearance);
 		c2 = ApplyLighting(v2.position, v2.normal, appearance);
 	}
+	if (m_frameStatsEnabled) {
+		m_frameStats.lightingTicks += SDL_GetPerformanceCounter() - lightingStart;
+		m_frameStats.triangles++;
+	}
 
 	Uint8* pixels = (Uint8*) m_renderedImage->pixels;
 	int pitch = m_renderedImage->pitch;
@@ -554,6 +559,47 @@ void Direct3DRMSoftwareRenderer::AddTextureDestroyCallback(Uint32 id, IDirect3DR
 	);
 }
 
+// Converts only the changed part of source into the locked cached copy
+static bool UpdateTextureRect(SDL_Surface* cached, SDL_Surface* source, const SDL_Rect& rect)
+{
+	if (SDL_RectEmpty(&rect) || cached->w != source->w || cached->h != source->h) {
+		return false;
+	}
+
+	SDL_Surface* view = SDL_CreateSurfaceFrom(
+		rect.w,
+		rect.h,
+		source->format,
+		(Uint8*) source->pixels + rect.y * source->pitch + rect.x * SDL_BYTESPERPIXEL(source->format),
+		source->pitch
+	);
+	if (!view) {
+		return false;
+	}
+	SDL_SetSurfacePalette(view, SDL_GetSurfacePalette(source));
+	Uint32 colorKey;
+	if (SDL_GetSurfaceColorKey(source, &colorKey)) {
+		SDL_SetSurfaceColorKey(view, true, colorKey);
+	}
+
+	SDL_Surface* converted = SDL_ConvertSurface(view, cached->format);
+	SDL_DestroySurface(view);
+	if (!converted) {
+		return false;
+	}
+
+	int rowBytes = rect.w * SDL_BYTESPERPIXEL(cached->format);
+	for (int y = 0; y < rect.h; y++) {
+		memcpy(
+			(Uint8*) cached->pixels + (rect.y + y) * cached->pitch + rect.x * SDL_BYTESPERPIXEL(cached->format),
+			(Uint8*) converted->pixels + y * converted->pitch,
+			rowBytes
+		);
+	}
+	SDL_DestroySurface(converted);
+	return true;
+}
+
 Uint32 Direct3DRMSoftwareRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bool isUi)
 {
 	auto texture = static_cast<Direct3DRMTextureImpl*>(iTexture);
@@ -565,9 +611,12 @@ Uint32 Direct3DRMSoftwareRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bo
 		if (texRef.texture == texture) {
 			if (texRef.version != texture->m_version) {
 				// Update animated textures
-				SDL_DestroySurface(texRef.cached);
-				texRef.cached = SDL_ConvertSurface(surface->m_surface, m_renderedImage->format);
-				SDL_LockSurface(texRef.cached);
+				if (!UpdateTextureRect(texRef.cached, surface->m_surface, texture->m_dirtyRect)) {
+					SDL_DestroySurface(texRef.cached);
+					texRef.cached = SDL_ConvertSurface(surface->m_surface, m_renderedImage->format);
+					SDL_LockSurface(texRef.cached);
+				}
+				texture->m_dirtyRect = {};
 				texRef.version = texture->m_version;
 			}
 			return i;
@@ -576,6 +625,7 @@ Uint32 Direct3DRMSoftwareRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bo
 
 	SDL_Surface* convertedRender = SDL_ConvertSurface(surface->m_surface, m_renderedImage->format);
 	SDL_LockSurface(convertedRender);
+	texture->m_dirtyRect = {};
 
 	// Reuse freed slot
 	for (Uint32 i = 0; i < m_textures.size(); ++i) {
@@ -595,38 +645,39 @@ Uint32 Direct3DRMSoftwareRenderer::GetTextureId(IDirect3DRMTexture* iTexture, bo
 
 MeshCache UploadMesh(const MeshGroup& meshGroup)
 {
-	MeshCache cache{&meshGroup, meshGroup.version};
+	MeshCache cache{meshGroup.geometry.get(), meshGroup.geometry->version};
 
-	cache.flat = meshGroup.quality == D3DRMRENDER_FLAT || meshGroup.quality == D3DRMRENDER_UNLITFLAT;
+	cache.flat = meshGroup.IsFlat();
+	cache.textured = meshGroup.texture != nullptr;
 
 	if (cache.flat) {
 		FlattenSurfaces(
-			meshGroup.vertices.data(),
-			meshGroup.vertices.size(),
-			meshGroup.indices.data(),
-			meshGroup.indices.size(),
+			meshGroup.geometry->vertices.data(),
+			meshGroup.geometry->vertices.size(),
+			meshGroup.geometry->indices.data(),
+			meshGroup.geometry->indices.size(),
 			meshGroup.texture != nullptr,
 			cache.vertices,
 			cache.indices
 		);
 	}
 	else {
-		cache.vertices.assign(meshGroup.vertices.begin(), meshGroup.vertices.end());
-		cache.indices.assign(meshGroup.indices.begin(), meshGroup.indices.end());
+		cache.vertices.assign(meshGroup.geometry->vertices.begin(), meshGroup.geometry->vertices.end());
+		cache.indices.assign(meshGroup.geometry->indices.begin(), meshGroup.geometry->indices.end());
 	}
 
 	return cache;
 }
 
-void Direct3DRMSoftwareRenderer::AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh)
+void Direct3DRMSoftwareRenderer::AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry)
 {
 	auto* ctx = new CacheDestroyContext{this, id};
-	mesh->AddDestroyCallback(
+	geometry->AddDestroyCallback(
 		[](IDirect3DRMObject* obj, void* arg) {
 			auto* ctx = static_cast<CacheDestroyContext*>(arg);
 			auto& cacheEntry = ctx->renderer->m_meshs[ctx->id];
-			if (cacheEntry.meshGroup) {
-				cacheEntry.meshGroup = nullptr;
+			if (cacheEntry.geometry) {
+				cacheEntry.geometry = nullptr;
 				cacheEntry.vertices.clear();
 				cacheEntry.indices.clear();
 			}
@@ -640,8 +691,9 @@ Uint32 Direct3DRMSoftwareRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGr
 {
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (cache.meshGroup == meshGroup) {
-			if (cache.version != meshGroup->version) {
+		if (cache.geometry == meshGroup->geometry.get() && cache.flat == meshGroup->IsFlat() &&
+			cache.textured == (meshGroup->texture != nullptr)) {
+			if (cache.version != meshGroup->geometry->version) {
 				cache = std::move(UploadMesh(*meshGroup));
 			}
 			return i;
@@ -652,15 +704,15 @@ Uint32 Direct3DRMSoftwareRenderer::GetMeshId(IDirect3DRMMesh* mesh, const MeshGr
 
 	for (Uint32 i = 0; i < m_meshs.size(); ++i) {
 		auto& cache = m_meshs[i];
-		if (!cache.meshGroup) {
+		if (!cache.geometry) {
 			cache = std::move(newCache);
-			AddMeshDestroyCallback(i, mesh);
+			AddMeshDestroyCallback(i, meshGroup->geometry.get());
 			return i;
 		}
 	}
 
 	m_meshs.push_back(std::move(newCache));
-	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), mesh);
+	AddMeshDestroyCallback((Uint32) (m_meshs.size() - 1), meshGroup->geometry.get());
 	return (Uint32) (m_meshs.size() - 1);
 }
 
@@ -691,6 +743,9 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 	const Appearance& appearance
 )
 {
+	Uint64 start = m_frameStatsEnabled ? SDL_GetPerformanceCounter() : 0;
+	Uint64 lightingTicks = m_frameStats.lightingTicks;
+
 	memcpy(m_normalMatrix, normalMatrix, sizeof(Matrix3x3));
 
 	auto& mesh = m_meshs[meshId];
@@ -714,10 +769,32 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 			appearance
 		);
 	}
+
+	if (m_frameStatsEnabled) {
+		// Everything but lighting: transform, clipping, setup and the scanline loops
+		Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+		m_frameStats.rasterizationTicks += elapsed - (m_frameStats.lightingTicks - lightingTicks);
+	}
+}
+
+static Uint32 HashImage(const SDL_Surface* surface)
+{
+	Uint32 hash = 2166136261u;
+	int rowBytes = surface->w * SDL_BYTESPERPIXEL(surface->format);
+	for (int y = 0; y < surface->h; y++) {
+		const Uint8* row = (const Uint8*) surface->pixels + y * surface->pitch;
+		for (int x = 0; x < rowBytes; x++) {
+			hash = (hash ^ row[x]) * 16777619u;
+		}
+	}
+	return hash;
 }
 
 HRESULT Direct3DRMSoftwareRenderer::FinalizeFrame()
 {
+	if (m_frameStatsEnabled) {
+		m_frameStats.imageHash = HashImage(m_renderedImage);
+	}
 	SDL_UnlockSurface(m_renderedImage);
 
 	return DD_OK;
@@ -1,5 +1,6 @@
 #include "d3drm_impl.h"
 #include "d3drmdevice_impl.h"
+#include "d3drmmesh_impl.h"
 #include "d3drmobject_impl.h"
 #include "d3drmrenderer.h"
 #include "d3drmviewport_impl.h"
@@ -187,3 +188,34 @@ bool Direct3DRMDevice2Impl::ConvertEventToRenderCoordinates(SDL_Event* event)
 
 	return true;
 }
+
+void Direct3DRMDevice2Impl::EnableFrameStats(bool enable)
+{
+	m_renderer->EnableFrameStats(enable);
+}
+
+void Direct3DRMDevice2Impl::SetProfileCallback(MiniwinProfileCallback callback)
+{
+	m_renderer->SetProfileCallback(callback);
+}
+
+void Direct3DRMDevice2Impl::SetMemoryCallback(MiniwinMemoryCallback callback)
+{
+	MeshMemoryCallback = callback;
+}
+
+bool Direct3DRMDevice2Impl::GetFrameStats(MiniwinFrameStats* stats, bool reset)
+{
+	if (!m_renderer->IsFrameStatsEnabled()) {
+		return false;
+	}
+
+	MiniwinFrameStats& frameStats = m_renderer->GetFrameStats();
+	*stats = frameStats;
+	if (reset) {
+		Uint32 imageHash = frameStats.imageHash;
+		frameStats = {};
+		frameStats.imageHash = imageHash;
+	}
+	return true;
+}
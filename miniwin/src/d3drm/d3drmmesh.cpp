@@ -3,6 +3,8 @@
 
 #include <limits>
 
+MiniwinMemoryCallback MeshMemoryCallback = nullptr;
+
 HRESULT Direct3DRMMeshImpl::QueryInterface(const GUID& riid, void** ppvObject)
 {
 	if (SDL_memcmp(&riid, &IID_IDirect3DRMMesh, sizeof(GUID)) == 0) {
@@ -23,18 +25,10 @@ HRESULT Direct3DRMMeshImpl::Clone(int flags, GUID iid, void** object)
 		return DDERR_INVALIDPARAMS;
 	}
 
+	// Groups share their geometry with the original until either side modifies it.
+	// Reusing the same texture and material on the new mesh instead of cloning them might not be correct
 	auto* clone = new Direct3DRMMeshImpl(*this);
 
-	for (auto& group : clone->m_groups) {
-		// Reusing the same texture and material on the new mesh instead of cloning them might not be correct
-		if (group.texture) {
-			group.texture->AddRef();
-		}
-		if (group.material) {
-			group.material->AddRef();
-		}
-	}
-
 	*object = static_cast<IDirect3DRMMesh*>(clone);
 	return DD_OK;
 }
@@ -60,7 +54,8 @@ HRESULT Direct3DRMMeshImpl::AddGroup(
 	group.vertexPerFace = vertexPerFace;
 
 	unsigned int* src = faceBuffer;
-	group.indices.assign(src, src + faceCount * vertexPerFace);
+	group.geometry->indices.assign(src, src + faceCount * vertexPerFace);
+	group.geometry->UpdateMemory();
 
 	m_groups.push_back(std::move(group));
 
@@ -82,20 +77,22 @@ HRESULT Direct3DRMMeshImpl::GetGroup(
 
 	const auto& group = m_groups[groupIndex];
 
+	const auto& geometry = *group.geometry;
+
 	if (vertexCount) {
-		*vertexCount = static_cast<DWORD>(group.vertices.size());
+		*vertexCount = static_cast<DWORD>(geometry.vertices.size());
 	}
 	if (faceCount) {
-		*faceCount = static_cast<DWORD>(group.indices.size() / group.vertexPerFace);
+		*faceCount = static_cast<DWORD>(geometry.indices.size() / group.vertexPerFace);
 	}
 	if (vertexPerFace) {
 		*vertexPerFace = static_cast<DWORD>(group.vertexPerFace);
 	}
 	if (indexCount) {
-		*indexCount = static_cast<DWORD>(group.indices.size());
+		*indexCount = static_cast<DWORD>(geometry.indices.size());
 	}
 	if (indices) {
-		std::copy(group.indices.begin(), group.indices.end(), reinterpret_cast<unsigned int*>(indices));
+		std::copy(geometry.indices.begin(), geometry.indices.end(), reinterpret_cast<unsigned int*>(indices));
 	}
 
 	return DD_OK;
@@ -177,7 +174,6 @@ HRESULT Direct3DRMMeshImpl::SetGroupTexture(D3DRMGROUPINDEX groupIndex, IDirect3
 
 	texture->AddRef();
 	group.texture = texture;
-	group.version++;
 	return DD_OK;
 }
 
@@ -238,7 +234,6 @@ HRESULT Direct3DRMMeshImpl::SetGroupQuality(D3DRMGROUPINDEX groupIndex, D3DRMREN
 
 	auto& group = m_groups[groupIndex];
 	group.quality = quality;
-	group.version++;
 
 	return DD_OK;
 }
@@ -258,19 +253,17 @@ HRESULT Direct3DRMMeshImpl::SetVertices(D3DRMGROUPINDEX groupIndex, int offset,
 		return DDERR_INVALIDPARAMS;
 	}
 
-	auto& group = m_groups[groupIndex];
-	auto& vertList = group.vertices;
+	auto& vertList = m_groups[groupIndex].MutableGeometry().vertices;
 
 	if (offset + count > static_cast<int>(vertList.size())) {
 		vertList.resize(offset + count);
 	}
 
 	std::copy(vertices, vertices + count, vertList.begin() + offset);
+	m_groups[groupIndex].geometry->UpdateMemory();
 
 	UpdateBox();
 
-	group.version++;
-
 	return DD_OK;
 }
 
@@ -280,7 +273,7 @@ HRESULT Direct3DRMMeshImpl::GetVertices(D3DRMGROUPINDEX groupIndex, int startInd
 		return DDERR_INVALIDPARAMS;
 	}
 
-	const auto& vertList = m_groups[groupIndex].vertices;
+	const auto& vertList = m_groups[groupIndex].geometry->vertices;
 
 	if (startIndex + count > static_cast<int>(vertList.size())) {
 		return DDERR_INVALIDPARAMS;
@@ -297,7 +290,7 @@ void Direct3DRMMeshImpl::UpdateBox()
 	m_box.max = {-INF, -INF, -INF};
 
 	for (size_t i = 0; i < m_groups.size(); ++i) {
-		for (const D3DRMVERTEX& v : m_groups[i].vertices) {
+		for (const D3DRMVERTEX& v : m_groups[i].geometry->vertices) {
 			m_box.min.x = std::min(m_box.min.x, v.position.x);
 			m_box.min.y = std::min(m_box.min.y, v.position.y);
 			m_box.min.z = std::min(m_box.min.z, v.position.z);
@@ -1,4 +1,5 @@
 #include "d3drmtexture_impl.h"
+#include "ddsurface_impl.h"
 #include "miniwin.h"
 
 Direct3DRMTextureImpl::Direct3DRMTextureImpl(D3DRMIMAGE* image)
@@ -37,6 +38,24 @@ HRESULT Direct3DRMTextureImpl::Changed(BOOL pixels, BOOL palette)
 	if (!m_surface) {
 		return DDERR_GENERIC;
 	}
+	SDL_Surface* surface = static_cast<DirectDrawSurfaceImpl*>(m_surface)->m_surface;
+	m_dirtyRect = {0, 0, surface->w, surface->h};
+	m_version++;
+	return DD_OK;
+}
+
+HRESULT Direct3DRMTextureImpl::Changed(D3DRMTEXTURECHANGEDFLAGS flags, DWORD rectCount, LPRECT rects)
+{
+	if ((flags & D3DRMTEXTURE_CHANGEDPALETTE) == D3DRMTEXTURE_CHANGEDPALETTE || !rects) {
+		return Changed(TRUE, TRUE);
+	}
+	if (!m_surface) {
+		return DDERR_GENERIC;
+	}
+	for (DWORD i = 0; i < rectCount; i++) {
+		SDL_Rect rect = {rects[i].left, rects[i].top, rects[i].right - rects[i].left, rects[i].bottom - rects[i].top};
+		SDL_GetRectUnion(&m_dirtyRect, &rect, &m_dirtyRect);
+	}
 	m_version++;
 	return DD_OK;
 }
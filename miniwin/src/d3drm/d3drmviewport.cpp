@@ -220,6 +220,23 @@ float CalculateDepth(const D3DRMMATRIX4D& viewProj, const D3DRMMATRIX4D& worldMa
 	return (clipPos.z / clipPos.w + 1.0f) * 0.5f;
 }
 
+bool Direct3DRMViewportImpl::IsMeshVisible(Direct3DRMMeshImpl* mesh, const D3DRMMATRIX4D& modelViewMatrix)
+{
+	if (!m_renderer->IsFrameStatsEnabled()) {
+		return IsMeshInFrustum(mesh, modelViewMatrix, m_frustumPlanes);
+	}
+
+	MiniwinFrameStats& stats = m_renderer->GetFrameStats();
+	Uint64 start = SDL_GetPerformanceCounter();
+	bool visible = IsMeshInFrustum(mesh, modelViewMatrix, m_frustumPlanes);
+	stats.cullingTicks += SDL_GetPerformanceCounter() - start;
+	stats.meshesTested++;
+	if (!visible) {
+		stats.meshesCulled++;
+	}
+	return visible;
+}
+
 void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3DRMMATRIX4D parentMatrix)
 {
 	Direct3DRMFrameImpl* frameImpl = static_cast<Direct3DRMFrameImpl*>(frame);
@@ -253,7 +270,7 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 		if (mesh) {
 			D3DRMMATRIX4D modelViewMatrix;
 			MultiplyMatrix(modelViewMatrix, worldMatrix, m_viewMatrix);
-			if (IsMeshInFrustum(mesh, modelViewMatrix, m_frustumPlanes)) {
+			if (IsMeshVisible(mesh, modelViewMatrix)) {
 				DWORD groupCount = mesh->GetGroupCount();
 				for (DWORD gi = 0; gi < groupCount; ++gi) {
 					const MeshGroup& meshGroup = mesh->GetGroup(gi);
@@ -279,6 +296,9 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 						memcpy(m_deferredDraws.back().normalMatrix, worldMatrixInvert, sizeof(Matrix3x3));
 					}
 					else {
+						if (m_renderer->IsFrameStatsEnabled()) {
+							m_renderer->GetFrameStats().draws++;
+						}
 						m_renderer->SubmitDraw(
 							m_renderer->GetMeshId(mesh, &meshGroup),
 							modelViewMatrix,
@@ -338,6 +358,12 @@ HRESULT Direct3DRMViewportImpl::RenderScene()
 			cmd.appearance
 		);
 	}
+
+	if (m_renderer->IsFrameStatsEnabled()) {
+		MiniwinFrameStats& stats = m_renderer->GetFrameStats();
+		stats.frames++;
+		stats.draws += m_deferredDraws.size();
+	}
 	m_deferredDraws.clear();
 
 	return m_renderer->FinalizeFrame();
@@ -349,7 +375,10 @@ HRESULT Direct3DRMViewportImpl::Render(IDirect3DRMFrame* rootFrame)
 		return DDERR_GENERIC;
 	}
 	m_rootFrame = rootFrame;
-	return RenderScene();
+	bool zone = m_renderer->ProfileBegin("RenderScene");
+	HRESULT result = RenderScene();
+	m_renderer->ProfileEnd(zone);
+	return result;
 }
 
 HRESULT Direct3DRMViewportImpl::ForceUpdate(int x, int y, int w, int h)
@@ -691,15 +720,15 @@ bool RayIntersectsMeshTriangles(
 		const MeshGroup& meshGroup = mesh.GetGroup(gi);
 
 		// Iterate over each face and do ray-triangle tests
-		for (DWORD fi = 0; fi < meshGroup.indices.size(); fi += 3) {
-			DWORD i0 = meshGroup.indices[fi + 0];
-			DWORD i1 = meshGroup.indices[fi + 1];
-			DWORD i2 = meshGroup.indices[fi + 2];
+		for (DWORD fi = 0; fi < meshGroup.geometry->indices.size(); fi += 3) {
+			DWORD i0 = meshGroup.geometry->indices[fi + 0];
+			DWORD i1 = meshGroup.geometry->indices[fi + 1];
+			DWORD i2 = meshGroup.geometry->indices[fi + 2];
 
 			// Transform vertices to world space
 			D3DVECTOR tri[3];
 			for (int j = 0; j < 3; ++j) {
-				const D3DVECTOR& v = meshGroup.vertices[(j == 0 ? i0 : (j == 1 ? i1 : i2))].position;
+				const D3DVECTOR& v = meshGroup.geometry->vertices[(j == 0 ? i0 : (j == 1 ? i1 : i2))].position;
 				tri[j] = TransformPoint(v, worldMatrix);
 			}
 
@@ -109,7 +109,17 @@ HRESULT FrameBufferImpl::Flip(LPDIRECTDRAWSURFACE lpDDSurfaceTargetOverride, DDF
 	if (!DDRenderer) {
 		return DDERR_GENERIC;
 	}
+	bool zone = DDRenderer->ProfileBegin("Present");
+	if (!DDRenderer->IsFrameStatsEnabled()) {
+		DDRenderer->Flip();
+		DDRenderer->ProfileEnd(zone);
+		return DD_OK;
+	}
+
+	Uint64 start = SDL_GetPerformanceCounter();
 	DDRenderer->Flip();
+	DDRenderer->GetFrameStats().presentTicks += SDL_GetPerformanceCounter() - start;
+	DDRenderer->ProfileEnd(zone);
 	return DD_OK;
 }
 
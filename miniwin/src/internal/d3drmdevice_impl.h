@@ -34,6 +34,10 @@ struct Direct3DRMDevice2Impl : public Direct3DRMObjectBaseImpl<IDirect3DRMDevice
 
 	// IDirect3DRMMiniwinDevice interface
 	bool ConvertEventToRenderCoordinates(SDL_Event* event) override;
+	void EnableFrameStats(bool enable) override;
+	bool GetFrameStats(MiniwinFrameStats* stats, bool reset) override;
+	void SetProfileCallback(MiniwinProfileCallback callback) override;
+	void SetMemoryCallback(MiniwinMemoryCallback callback) override;
 
 	Direct3DRMRenderer* m_renderer;
 
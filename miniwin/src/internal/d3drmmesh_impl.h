@@ -1,25 +1,65 @@
 #pragma once
 
 #include "d3drmobject_impl.h"
+#include "miniwin/miniwindevice.h"
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
+extern MiniwinMemoryCallback MeshMemoryCallback;
+
+// Vertex and index buffers of a mesh group. A mesh and its clones share one
+// instance; SetVertices copies it first if anyone else still references it.
+// Renderers cache uploaded buffers per geometry and drop them on destruction.
+struct MeshGeometry {
+	int version = 0;
+	std::vector<D3DRMVERTEX> vertices;
+	std::vector<DWORD> indices;
+
+	MeshGeometry() = default;
+	MeshGeometry(const MeshGeometry& other) : vertices(other.vertices), indices(other.indices) { UpdateMemory(); }
+
+	~MeshGeometry()
+	{
+		for (const auto& callback : callbacks) {
+			callback.first(nullptr, callback.second);
+		}
+		if (reportedBytes && MeshMemoryCallback) {
+			MeshMemoryCallback(-reportedBytes);
+		}
+	}
+
+	// Reports the change in storage since the last call to the memory callback
+	void UpdateMemory()
+	{
+		int bytes = vertices.capacity() * sizeof(D3DRMVERTEX) + indices.capacity() * sizeof(DWORD);
+		if (bytes != reportedBytes && MeshMemoryCallback) {
+			MeshMemoryCallback(bytes - reportedBytes);
+			reportedBytes = bytes;
+		}
+	}
+
+	void AddDestroyCallback(D3DRMOBJECTCALLBACK callback, void* arg) { callbacks.push_back({callback, arg}); }
+
+private:
+	std::vector<std::pair<D3DRMOBJECTCALLBACK, void*>> callbacks;
+	int reportedBytes = 0;
+};
+
 struct MeshGroup {
 	SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF};
 	IDirect3DRMTexture* texture = nullptr;
 	IDirect3DRMMaterial* material = nullptr;
 	D3DRMRENDERQUALITY quality = D3DRMRENDER_GOURAUD;
 	int vertexPerFace = 3;
-	int version = 0;
-	std::vector<D3DRMVERTEX> vertices;
-	std::vector<DWORD> indices;
+	std::shared_ptr<MeshGeometry> geometry = std::make_shared<MeshGeometry>();
 
 	MeshGroup() = default;
 
 	MeshGroup(const MeshGroup& other)
 		: color(other.color), texture(other.texture), material(other.material), quality(other.quality),
-		  vertexPerFace(other.vertexPerFace), vertices(std::move(other.vertices)), indices(std::move(other.indices))
+		  vertexPerFace(other.vertexPerFace), geometry(other.geometry)
 	{
 		if (texture) {
 			texture->AddRef();
@@ -32,7 +72,7 @@ struct MeshGroup {
 	// Move constructor
 	MeshGroup(MeshGroup&& other) noexcept
 		: color(other.color), texture(other.texture), material(other.material), quality(other.quality),
-		  vertexPerFace(other.vertexPerFace), vertices(other.vertices), indices(other.indices)
+		  vertexPerFace(other.vertexPerFace), geometry(std::move(other.geometry))
 	{
 		other.texture = nullptr;
 		other.material = nullptr;
@@ -46,8 +86,7 @@ struct MeshGroup {
 		material = other.material;
 		quality = other.quality;
 		vertexPerFace = other.vertexPerFace;
-		vertices = std::move(other.vertices);
-		indices = std::move(other.indices);
+		geometry = std::move(other.geometry);
 		other.texture = nullptr;
 		other.material = nullptr;
 		return *this;
@@ -62,6 +101,20 @@ struct MeshGroup {
 			material->Release();
 		}
 	}
+
+	bool IsFlat() const { return quality == D3DRMRENDER_FLAT || quality == D3DRMRENDER_UNLITFLAT; }
+
+	// Returns geometry that may be modified without affecting clones
+	MeshGeometry& MutableGeometry()
+	{
+		if (geometry.use_count() > 1) {
+			geometry = std::make_shared<MeshGeometry>(*geometry);
+		}
+		else {
+			geometry->version++;
+		}
+		return *geometry;
+	}
 };
 
 struct Direct3DRMMeshImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMMesh> {
@@ -55,8 +55,28 @@ class Direct3DRMRenderer : public IDirect3DDevice2 {
 	virtual void Download(SDL_Surface* target) = 0;
 	virtual void SetDither(bool dither) = 0;
 
+	void EnableFrameStats(bool enable)
+	{
+		m_frameStatsEnabled = enable;
+		m_frameStats = {};
+	}
+	bool IsFrameStatsEnabled() const { return m_frameStatsEnabled; }
+	MiniwinFrameStats& GetFrameStats() { return m_frameStats; }
+
+	void SetProfileCallback(MiniwinProfileCallback callback) { m_profileCallback = callback; }
+	bool ProfileBegin(const char* name) { return m_profileCallback && m_profileCallback(name, true); }
+	void ProfileEnd(bool begun)
+	{
+		if (begun) {
+			m_profileCallback(nullptr, false);
+		}
+	}
+
 protected:
 	int m_width, m_height;
 	int m_virtualWidth, m_virtualHeight;
 	ViewportTransform m_viewportTransform;
+	bool m_frameStatsEnabled = false;
+	MiniwinFrameStats m_frameStats = {};
+	MiniwinProfileCallback m_profileCallback = nullptr;
 };
@@ -18,8 +18,10 @@ struct C3DTextureCacheEntry {
 };
 
 struct C3DMeshCacheEntry {
-	const MeshGroup* meshGroup = nullptr;
+	const MeshGeometry* geometry = nullptr;
 	int version = 0;
+	bool flat = false;
+	bool textured = false;
 	void* vbo = nullptr;
 	int vertexCount = 0;
 };
@@ -54,7 +56,7 @@ class Citro3DRenderer : public Direct3DRMRenderer {
 
 private:
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 	void StartFrame();
 
 	D3DRMMATRIX4D m_projection;
@@ -40,7 +40,7 @@ class DirectX9Renderer : public Direct3DRMRenderer {
 
 private:
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 
 	SDL_Surface* m_renderedImage;
 	std::vector<SceneLight> m_lights;
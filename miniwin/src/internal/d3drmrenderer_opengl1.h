@@ -40,7 +40,7 @@ class OpenGL1Renderer : public Direct3DRMRenderer {
 
 private:
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 
 	std::vector<GLTextureCacheEntry> m_textures;
 	std::vector<GLMeshCacheEntry> m_meshs;
@@ -19,9 +19,10 @@ struct GLES2TextureCacheEntry {
 };
 
 struct GLES2MeshCacheEntry {
-	const MeshGroup* meshGroup;
+	const MeshGeometry* geometry;
 	int version;
 	bool flat;
+	bool textured;
 
 	std::vector<uint16_t> indices;
 	GLuint vboPositions;
@@ -61,7 +62,7 @@ class OpenGLES2Renderer : public Direct3DRMRenderer {
 
 private:
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 
 	MeshGroup m_uiMesh;
 	GLES2MeshCacheEntry m_uiMeshCache;
@@ -35,11 +35,13 @@ struct SDL3TextureCache {
 };
 
 struct SDL3MeshCache {
-	const MeshGroup* meshGroup;
+	const MeshGeometry* geometry;
 	int version;
 	SDL_GPUBuffer* vertexBuffer;
 	SDL_GPUBuffer* indexBuffer;
 	size_t indexCount;
+	bool flat;
+	bool textured;
 };
 
 class Direct3DRMSDL3GPURenderer : public Direct3DRMRenderer {
@@ -87,7 +89,7 @@ class Direct3DRMSDL3GPURenderer : public Direct3DRMRenderer {
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
 	SDL_GPUTransferBuffer* GetUploadBuffer(size_t size);
 	SDL_GPUTexture* CreateTextureFromSurface(SDL_Surface* surface);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 	SDL3MeshCache UploadMesh(const MeshGroup& meshGroup);
 
 	MeshGroup m_uiMesh;
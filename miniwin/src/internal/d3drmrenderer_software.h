@@ -17,9 +17,10 @@ struct TextureCache {
 };
 
 struct MeshCache {
-	const MeshGroup* meshGroup;
+	const MeshGeometry* geometry;
 	int version;
 	bool flat;
+	bool textured;
 	std::vector<D3DRMVERTEX> vertices;
 	std::vector<uint16_t> indices;
 };
@@ -64,7 +65,7 @@ class Direct3DRMSoftwareRenderer : public Direct3DRMRenderer {
 	Uint32 BlendPixel(Uint8* pixelAddr, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 	SDL_Color ApplyLighting(const D3DVECTOR& position, const D3DVECTOR& normal, const Appearance& appearance);
 	void AddTextureDestroyCallback(Uint32 id, IDirect3DRMTexture* texture);
-	void AddMeshDestroyCallback(Uint32 id, IDirect3DRMMesh* mesh);
+	void AddMeshDestroyCallback(Uint32 id, MeshGeometry* geometry);
 
 	SDL_Surface* m_renderedImage = nullptr;
 	SDL_Palette* m_palette;
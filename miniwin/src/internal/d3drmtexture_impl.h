@@ -8,8 +8,10 @@ struct Direct3DRMTextureImpl : public Direct3DRMObjectBaseImpl<IDirect3DRMTextur
 	~Direct3DRMTextureImpl() override;
 	HRESULT QueryInterface(const GUID& riid, void** ppvObject) override;
 	HRESULT Changed(BOOL pixels, BOOL palette) override;
+	HRESULT Changed(D3DRMTEXTURECHANGEDFLAGS flags, DWORD rectCount, LPRECT rects) override;
 
 	IDirectDrawSurface* m_surface = nullptr;
 	Uint8 m_version = 0;
+	SDL_Rect m_dirtyRect = {}; // Changed since a renderer last picked up m_version, empty once it has
 	bool m_holdsRef;
 };
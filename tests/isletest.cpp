@@ -0,0 +1,64 @@
+#include "isletest.h"
+
+#include <SDL3/SDL_hints.h>
+#include <SDL3/SDL_init.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+static IsleTest* g_tests = NULL;
+static bool g_failed = false;
+
+IsleTest::IsleTest(const char* p_name, IsleTestFunction p_function)
+{
+	m_name = p_name;
+	m_function = p_function;
+	m_next = g_tests;
+	g_tests = this;
+}
+
+void IsleTest_Fail(const char* p_file, int p_line, const char* p_condition)
+{
+	SDL_LogError(SDL_LOG_CATEGORY_TEST, "%s:%d: check failed: %s", p_file, p_line, p_condition);
+	g_failed = true;
+}
+
+// Runs the test named on the command line, or every test without one
+int main(int argc, char** argv)
+{
+	// Tests never need a real device
+	SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
+	if (!SDL_Init(SDL_INIT_AUDIO)) {
+		SDL_LogError(SDL_LOG_CATEGORY_TEST, "SDL_Init failed: %s", SDL_GetError());
+		return 1;
+	}
+
+	int numRun = 0;
+	int numFailed = 0;
+
+	for (IsleTest* test = g_tests; test; test = test->m_next) {
+		if (argc > 1 && SDL_strcmp(argv[1], test->m_name) != 0) {
+			continue;
+		}
+
+		g_failed = false;
+		test->m_function();
+		numRun++;
+
+		if (g_failed) {
+			numFailed++;
+		}
+
+		SDL_Log("%s: %s", test->m_name, g_failed ? "failed" : "passed");
+	}
+
+	SDL_Quit();
+
+	if (numRun == 0) {
+		SDL_LogError(SDL_LOG_CATEGORY_TEST, "No test named %s", argc > 1 ? argv[1] : "");
+		return 1;
+	}
+
+	return numFailed ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#ifndef ISLETEST_H
+#define ISLETEST_H
+
+// A minimal test registry for isle-tests. Tests are plain functions registered
+// by ISLE_TEST and run by name. A failed ISLE_CHECK logs the condition and
+// returns from the test, which is then reported as failed.
+
+typedef void (*IsleTestFunction)();
+
+struct IsleTest {
+	IsleTest(const char* p_name, IsleTestFunction p_function);
+
+	const char* m_name;
+	IsleTestFunction m_function;
+	IsleTest* m_next;
+};
+
+extern void IsleTest_Fail(const char* p_file, int p_line, const char* p_condition);
+
+#define ISLE_TEST(NAME)                                                                                                \
+	static void NAME();                                                                                                \
+	static IsleTest g_##NAME##Test(#NAME, &NAME);                                                                      \
+	static void NAME()
+
+#define ISLE_CHECK(CONDITION)                                                                                          \
+	do {                                                                                                               \
+		if (!(CONDITION)) {                                                                                            \
+			IsleTest_Fail(__FILE__, __LINE__, #CONDITION);                                                             \
+			return;                                                                                                    \
+		}                                                                                                              \
+	} while (0)
+
+// A fixed-seed linear congruential generator, so that every run of a test or
+// benchmark sees the same data
+class IsleRandom {
+public:
+	IsleRandom(unsigned int p_seed) { m_seed = p_seed; }
+
+	// Uniform in [0, p_max)
+	int Next(int p_max)
+	{
+		m_seed = m_seed * 1103515245 + 12345;
+		return (int) ((m_seed >> 8) % (unsigned int) p_max);
+	}
+
+private:
+	unsigned int m_seed;
+};
+
+#endif // ISLETEST_H
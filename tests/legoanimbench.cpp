@@ -0,0 +1,143 @@
+// Times N characters playing one walk animation for M frames, each at its own
+// phase as LegoExtraActor and the ambient actors do, through the recursive
+// LegoROI::FUN_100a8e80 and through LegoFlatAnim. The skeleton has the shape of
+// a minifig's: a body with a head, two arms with hands, and two legs.
+//
+// Usage: legoanim-bench [characters] [frames] [keys]
+
+#include "anim/legoanim.h"
+#include "mxgeometry/mxmatrix.h"
+#include "roi/legoflatanim.h"
+#include "roi/legoroi.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#define BENCH_KEY_SPACING 100
+
+// LegoAnimNodeData has no setter for its translation keys
+class BenchNodeData : public LegoAnimNodeData {
+public:
+	BenchNodeData(LegoU16 p_numKeys, LegoFloat p_phase)
+	{
+		m_numTranslationKeys = p_numKeys;
+		m_translationKeys = new LegoTranslationKey[p_numKeys];
+		m_numRotationKeys = p_numKeys;
+		m_rotationKeys = new LegoRotationKey[p_numKeys];
+
+		for (LegoU16 i = 0; i < p_numKeys; i++) {
+			LegoFloat a = (i + p_phase) * 0.1f;
+
+			m_translationKeys[i].SetTime(i * BENCH_KEY_SPACING);
+			m_translationKeys[i].SetActive(TRUE);
+			m_translationKeys[i].SetX(SDL_sinf(a));
+			m_translationKeys[i].SetY(p_phase);
+			m_translationKeys[i].SetZ(SDL_cosf(a));
+
+			m_rotationKeys[i].SetTime(i * BENCH_KEY_SPACING);
+			m_rotationKeys[i].SetActive(TRUE);
+			m_rotationKeys[i].SetAngle(SDL_cosf(a));
+			m_rotationKeys[i].SetX(SDL_sinf(a));
+			m_rotationKeys[i].SetY(0.0f);
+			m_rotationKeys[i].SetZ(0.0f);
+		}
+	}
+};
+
+static LegoTreeNode* CreateNode(LegoU16 p_numKeys, LegoFloat p_phase, LegoU32 p_numChildren)
+{
+	LegoTreeNode* node = new LegoTreeNode;
+	node->SetData(new BenchNodeData(p_numKeys, p_phase));
+	node->SetNumChildren(p_numChildren);
+	node->SetChildren(p_numChildren ? new LegoTreeNode*[p_numChildren] : NULL);
+	return node;
+}
+
+// root -> body -> head, arms -> hands, legs
+static LegoTreeNode* CreateSkeleton(LegoU16 p_numKeys)
+{
+	LegoTreeNode* root = CreateNode(p_numKeys, 0.0f, 1);
+	LegoTreeNode* body = CreateNode(p_numKeys, 1.0f, 5);
+	root->SetChild(0, body);
+
+	body->SetChild(0, CreateNode(p_numKeys, 2.0f, 0));
+	for (LegoU32 i = 0; i < 2; i++) {
+		LegoTreeNode* arm = CreateNode(p_numKeys, 3.0f + i, 1);
+		arm->SetChild(0, CreateNode(p_numKeys, 5.0f + i, 0));
+		body->SetChild(1 + i, arm);
+		body->SetChild(3 + i, CreateNode(p_numKeys, 7.0f + i, 0));
+	}
+
+	return root;
+}
+
+static LegoTime GetTime(MxS32 p_frame, MxS32 p_character, LegoU16 p_numKeys)
+{
+	return (p_frame * 33 + p_character * 7919) % ((p_numKeys - 1) * BENCH_KEY_SPACING);
+}
+
+static void Report(const char* p_name, Uint64 p_ticks, MxS32 p_numCharacters, MxS32 p_numFrames)
+{
+	double usPerFrame = p_ticks * 1000000.0 / SDL_GetPerformanceFrequency() / p_numFrames;
+	SDL_Log(
+		"legoanim-bench: %-10s %8.2f us per frame, %6.3f us per character",
+		p_name,
+		usPerFrame,
+		usPerFrame / p_numCharacters
+	);
+}
+
+int main(int argc, char** argv)
+{
+	MxS32 numCharacters = argc > 1 ? SDL_atoi(argv[1]) : 64;
+	MxS32 numFrames = argc > 2 ? SDL_atoi(argv[2]) : 2000;
+	MxS32 numKeys = argc > 3 ? SDL_atoi(argv[3]) : 300;
+	if (numCharacters <= 0 || numFrames <= 0 || numKeys < 2 || numKeys > 0xffff) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Usage: %s [characters] [frames] [keys]", argv[0]);
+		return 1;
+	}
+
+	// No ROIs, so both paths only evaluate the keys and multiply the matrices
+	LegoAnim anim;
+	anim.SetRoot(CreateSkeleton(numKeys));
+	LegoTreeNode* root = anim.GetRoot();
+	LegoROI* roiMap[1] = {NULL};
+
+	LegoFlatAnim** flatAnims = new LegoFlatAnim*[numCharacters];
+	for (MxS32 i = 0; i < numCharacters; i++) {
+		flatAnims[i] = new LegoFlatAnim(root, FALSE, roiMap);
+	}
+
+	MxMatrix transform;
+	transform.SetIdentity();
+
+	SDL_Log("legoanim-bench: %d characters, %d frames, 8 nodes, %d keys", numCharacters, numFrames, numKeys);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (MxS32 frame = 0; frame < numFrames; frame++) {
+		for (MxS32 i = 0; i < numCharacters; i++) {
+			LegoTime time = GetTime(frame, i, numKeys);
+
+			for (LegoU32 j = 0; j < root->GetNumChildren(); j++) {
+				LegoROI::FUN_100a8e80(root->GetChild(j), transform, time, roiMap);
+			}
+		}
+	}
+	Report("recursive", SDL_GetPerformanceCounter() - start, numCharacters, numFrames);
+
+	start = SDL_GetPerformanceCounter();
+	for (MxS32 frame = 0; frame < numFrames; frame++) {
+		for (MxS32 i = 0; i < numCharacters; i++) {
+			flatAnims[i]->ApplyAnimation(transform, GetTime(frame, i, numKeys));
+		}
+	}
+	Report("flattened", SDL_GetPerformanceCounter() - start, numCharacters, numFrames);
+
+	for (MxS32 i = 0; i < numCharacters; i++) {
+		delete flatAnims[i];
+	}
+
+	delete[] flatAnims;
+	return 0;
+}
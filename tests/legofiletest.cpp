@@ -0,0 +1,267 @@
+#include "isletest.h"
+#include "misc/legostorage.h"
+#include "modeldb/modeldb.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#define TEST_FILE "isle-tests-file.bin"
+#define TEST_FILE_SIZE 5000
+#define TEST_NUM_WORLDS 20
+
+// Mostly small reads and writes, as the file formats make, with the odd one
+// larger than the buffer
+static MxU32 RandomSize(IsleRandom& p_random)
+{
+	return p_random.Next(5) == 0 ? p_random.Next(1500) : p_random.Next(20);
+}
+
+// Random writes, reads and seeks through files with random buffer sizes see
+// the same bytes and positions as a model of the file kept in memory
+ISLE_TEST(LegoFileBuffered)
+{
+	LegoU8 model[TEST_FILE_SIZE];
+	LegoU8 data[TEST_FILE_SIZE];
+	IsleRandom random(1);
+
+	for (MxU32 iteration = 0; iteration < 300; iteration++) {
+		LegoU32 bufferSize = random.Next(3) == 0 ? 0 : 1 + random.Next(700);
+		LegoU32 size = 0;
+		LegoU32 position = 0;
+		LegoU32 actual;
+
+		LegoFile file;
+		ISLE_CHECK(file.SetBufferSize(bufferSize) == SUCCESS);
+		ISLE_CHECK(file.Open(TEST_FILE, LegoFile::c_write) == SUCCESS);
+
+		// Seeks back over written data overwrite it, and the file grows at its end
+		for (MxU32 op = 0; op < 200; op++) {
+			switch (random.Next(3)) {
+			case 0: {
+				LegoU32 length = RandomSize(random);
+				if (position + length > TEST_FILE_SIZE) {
+					break;
+				}
+
+				for (LegoU32 i = 0; i < length; i++) {
+					data[i] = (LegoU8) random.Next(256);
+				}
+
+				ISLE_CHECK(file.Write(data, length) == SUCCESS);
+				SDL_memcpy(model + position, data, length);
+				position += length;
+				size = SDL_max(size, position);
+				break;
+			}
+			case 1:
+				position = random.Next(size + 1);
+				ISLE_CHECK(file.SetPosition(position) == SUCCESS);
+				break;
+			case 2:
+				ISLE_CHECK(file.GetPosition(actual) == SUCCESS);
+				ISLE_CHECK(actual == position);
+				break;
+			}
+		}
+
+		// Reopening passes on what is still buffered
+		ISLE_CHECK(file.Open(TEST_FILE, LegoFile::c_read) == SUCCESS);
+		position = 0;
+
+		for (MxU32 op = 0; op < 200; op++) {
+			switch (random.Next(3)) {
+			case 0: {
+				LegoU32 length = RandomSize(random);
+				if (position + length > size) {
+					break;
+				}
+
+				ISLE_CHECK(file.Read(data, length) == SUCCESS);
+				ISLE_CHECK(SDL_memcmp(data, model + position, length) == 0);
+				position += length;
+				break;
+			}
+			case 1:
+				position = random.Next(size + 1);
+				ISLE_CHECK(file.SetPosition(position) == SUCCESS);
+				break;
+			case 2:
+				ISLE_CHECK(file.GetPosition(actual) == SUCCESS);
+				ISLE_CHECK(actual == position);
+				break;
+			}
+		}
+
+		// Nothing was lost or left over
+		ISLE_CHECK(file.SetPosition(0) == SUCCESS);
+		ISLE_CHECK(file.Read(data, size) == SUCCESS);
+		ISLE_CHECK(SDL_memcmp(data, model, size) == 0);
+		ISLE_CHECK(file.Read(data, 1) != SUCCESS);
+	}
+
+	ISLE_CHECK(SDL_RemovePath(TEST_FILE));
+}
+
+// Writes a name as WORLD.WDB stores it: its length with the terminator, then
+// the name. With the terminator they are two to twelve bytes, as the part and
+// model names are.
+static LegoResult WriteName(LegoFile& p_file, IsleRandom& p_random, char* p_name)
+{
+	MxU32 length = 2 + p_random.Next(11);
+
+	for (MxU32 i = 0; i < length - 1; i++) {
+		p_name[i] = 'a' + p_random.Next(26);
+	}
+	p_name[length - 1] = '\0';
+
+	if (p_file.Write(&length, sizeof(length)) != SUCCESS) {
+		return FAILURE;
+	}
+	return p_file.Write(p_name, length);
+}
+
+// Writes a model database directory of TEST_NUM_WORLDS worlds with random parts
+// and models, in the layout ReadModelDbWorlds reads from the start of WORLD.WDB.
+// The name of the last model of each world is kept in p_lastModels.
+static LegoResult WriteWdbDirectory(IsleRandom& p_random, char p_lastModels[TEST_NUM_WORLDS][12])
+{
+	LegoFile file;
+	char name[12];
+	MxU32 value;
+	float vectors[9];
+	MxU8 visible = 1;
+
+	if (file.Open(TEST_FILE, LegoFile::c_write) != SUCCESS) {
+		return FAILURE;
+	}
+
+	value = TEST_NUM_WORLDS;
+	if (file.Write(&value, sizeof(value)) != SUCCESS) {
+		return FAILURE;
+	}
+
+	for (MxU32 i = 0; i < TEST_NUM_WORLDS; i++) {
+		if (WriteName(file, p_random, name) != SUCCESS) {
+			return FAILURE;
+		}
+
+		MxU32 numParts = 20 + p_random.Next(40);
+		if (file.Write(&numParts, sizeof(numParts)) != SUCCESS) {
+			return FAILURE;
+		}
+
+		for (MxU32 j = 0; j < numParts; j++) {
+			if (WriteName(file, p_random, name) != SUCCESS) {
+				return FAILURE;
+			}
+
+			// Data length and offset
+			for (MxU32 k = 0; k < 2; k++) {
+				value = p_random.Next(100000);
+				if (file.Write(&value, sizeof(value)) != SUCCESS) {
+					return FAILURE;
+				}
+			}
+		}
+
+		MxU32 numModels = 20 + p_random.Next(40);
+		if (file.Write(&numModels, sizeof(numModels)) != SUCCESS) {
+			return FAILURE;
+		}
+
+		for (MxU32 j = 0; j < numModels; j++) {
+			if (WriteName(file, p_random, p_lastModels[i]) != SUCCESS) {
+				return FAILURE;
+			}
+
+			// Data length and offset
+			for (MxU32 k = 0; k < 2; k++) {
+				value = p_random.Next(100000);
+				if (file.Write(&value, sizeof(value)) != SUCCESS) {
+					return FAILURE;
+				}
+			}
+
+			if (WriteName(file, p_random, name) != SUCCESS) {
+				return FAILURE;
+			}
+
+			// Location, direction and up, then whether the model is visible
+			for (MxU32 k = 0; k < 9; k++) {
+				vectors[k] = p_random.Next(1000) / 10.0f;
+			}
+
+			if (file.Write(vectors, sizeof(vectors)) != SUCCESS || file.Write(&visible, sizeof(visible)) != SUCCESS) {
+				return FAILURE;
+			}
+		}
+	}
+
+	return SUCCESS;
+}
+
+// Small writes and reads through the default buffer reach the file in a few
+// large calls
+ISLE_TEST(LegoFileBufferedCalls)
+{
+	LegoFile::Stats before;
+	LegoFile::Stats after;
+	LegoFile file;
+	MxU32 value;
+
+	LegoFile::GetStats(before);
+	ISLE_CHECK(file.Open(TEST_FILE, LegoFile::c_write) == SUCCESS);
+	for (MxU32 i = 0; i < 1000; i++) {
+		ISLE_CHECK(file.Write(&i, sizeof(i)) == SUCCESS);
+	}
+
+	ISLE_CHECK(file.Open(TEST_FILE, LegoFile::c_read) == SUCCESS);
+	for (MxU32 i = 0; i < 1000; i++) {
+		ISLE_CHECK(file.Read(&value, sizeof(value)) == SUCCESS);
+		ISLE_CHECK(value == i);
+	}
+	LegoFile::GetStats(after);
+
+	ISLE_CHECK(after.m_calls - before.m_calls == 2000);
+	ISLE_CHECK(after.m_ioCalls - before.m_ioCalls <= 2);
+
+	// The model database directory is read a field at a time, as LegoWorldPresenter
+	// reads it from WORLD.WDB when the file can't be kept resident
+	IsleRandom random(1);
+	char lastModels[TEST_NUM_WORLDS][12];
+	ISLE_CHECK(WriteWdbDirectory(random, lastModels) == SUCCESS);
+
+	LegoU32 bufferSizes[] = {LegoFile::c_defaultBufferSize, 0};
+	MxU32 ioCalls[2];
+
+	for (MxU32 i = 0; i < sizeOfArray(bufferSizes); i++) {
+		ModelDbWorld* worlds;
+		MxS32 numWorlds;
+
+		ISLE_CHECK(file.SetBufferSize(bufferSizes[i]) == SUCCESS);
+		ISLE_CHECK(file.Open(TEST_FILE, LegoFile::c_read) == SUCCESS);
+
+		LegoFile::GetStats(before);
+		ISLE_CHECK(ReadModelDbWorlds(&file, worlds, numWorlds) == SUCCESS);
+		LegoFile::GetStats(after);
+
+		ISLE_CHECK(numWorlds == TEST_NUM_WORLDS);
+		for (MxS32 j = 0; j < numWorlds; j++) {
+			ISLE_CHECK(!SDL_strcmp(worlds[j].m_models[worlds[j].m_numModels - 1].m_modelName, lastModels[j]));
+		}
+		FreeModelDbWorlds(worlds, numWorlds);
+
+		ioCalls[i] = after.m_ioCalls - before.m_ioCalls;
+		SDL_Log(
+			"LegoFileBufferedCalls: WDB directory with a %u byte buffer: %u calls, %u io calls",
+			bufferSizes[i],
+			after.m_calls - before.m_calls,
+			ioCalls[i]
+		);
+	}
+
+	// Unbuffered, every field is a call of its own
+	ISLE_CHECK(ioCalls[0] * 100 < ioCalls[1]);
+	ISLE_CHECK(SDL_RemovePath(TEST_FILE));
+}
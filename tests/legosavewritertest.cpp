@@ -0,0 +1,311 @@
+#include "gasstation.h"
+#include "hospital.h"
+#include "infocenter.h"
+#include "isletest.h"
+#include "legobuildingmanager.h"
+#include "legocharactermanager.h"
+#include "legogamestate.h"
+#include "legomain.h"
+#include "legoobjectfactory.h"
+#include "legoplantmanager.h"
+#include "legosavewriter.h"
+#include "misc/legostorage.h"
+#include "mxatom.h"
+#include "mxmisc.h"
+#include "mxnotificationmanager.h"
+#include "mxstillpresenter.h"
+#include "mxticklemanager.h"
+#include "mxvariabletable.h"
+
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_thread.h>
+
+#define TEST_SAVE "isle-tests-save.gs"
+#define TEST_OTHER_SAVE "isle-tests-other.gs"
+#define TEST_MAX_SIZE 8192
+#define TEST_GAME_DIR "isle-tests-game"
+
+// Writes fields the way the game state does, with a size and content that
+// depend on p_seed
+static void Serialize(LegoStorage& p_storage, MxU32 p_seed)
+{
+	p_storage.WriteString("isle-tests");
+	p_storage.WriteU32(p_seed);
+
+	for (MxU32 i = 0; i < 1000 / p_seed; i++) {
+		p_storage.WriteS16((LegoS16) (i * p_seed));
+		p_storage.WriteFloat(i * 0.5f + p_seed);
+	}
+}
+
+// Loads p_path and compares it with the image of p_seed
+static bool MatchesFile(const char* p_path, MxU32 p_seed)
+{
+	LegoMemory expected;
+	Serialize(expected, p_seed);
+
+	LegoFile file;
+	if (file.Open(p_path, LegoFile::c_read) != SUCCESS) {
+		return false;
+	}
+
+	LegoU8 data[TEST_MAX_SIZE];
+	LegoU8 extra;
+
+	return expected.GetSize() <= sizeof(data) && file.Read(data, expected.GetSize()) == SUCCESS &&
+		   SDL_memcmp(data, expected.GetBuffer(), expected.GetSize()) == 0 && file.Read(&extra, 1) != SUCCESS;
+}
+
+// Holds up the writer thread once it has been written, until released
+class BlockingImage : public LegoMemory {
+public:
+	BlockingImage(SDL_Semaphore* p_release) : m_release(p_release) {}
+
+	// The timeout keeps a failed test from hanging
+	~BlockingImage() override { SDL_WaitSemaphoreTimeout(m_release, 5000); }
+
+	SDL_Semaphore* m_release;
+};
+
+// Records the thread it was deleted on
+class TrackedImage : public LegoMemory {
+public:
+	TrackedImage(SDL_ThreadID* p_deletedOn) : m_deletedOn(p_deletedOn) {}
+	~TrackedImage() override { *m_deletedOn = SDL_GetCurrentThreadID(); }
+
+	SDL_ThreadID* m_deletedOn;
+};
+
+// The parts of LegoOmni that saving and loading a game use
+class TestLego : public LegoOmni {
+public:
+	TestLego()
+	{
+		SetInstance(this);
+		m_atomSet = new MxAtomSet;
+		m_tickleManager = new MxTickleManager;
+		m_notificationManager = new MxNotificationManager;
+		m_notificationManager->Create(0, FALSE);
+		m_variableTable = new MxVariableTable;
+		m_objectFactory = new LegoObjectFactory;
+		SetCharacterManager(new LegoCharacterManager);
+		SetPlantManager(new LegoPlantManager);
+		SetBuildingManager(new LegoBuildingManager);
+	}
+};
+
+static void RandomName(IsleRandom& p_random, LegoGameState::Username& p_name)
+{
+	for (MxS32 i = 0; i < (MxS32) sizeOfArray(p_name.m_letters); i++) {
+		p_name.m_letters[i] = p_random.Next(26);
+	}
+}
+
+static bool NameEquals(const LegoGameState::Username& p_a, const LegoGameState::Username& p_b)
+{
+	return SDL_memcmp(p_a.m_letters, p_b.m_letters, sizeof(p_a.m_letters)) == 0;
+}
+
+static bool HistoryEquals(const LegoGameState::History& p_a, const LegoGameState::History& p_b)
+{
+	if (p_a.m_count != p_b.m_count || p_a.m_nextPlayerId != p_b.m_nextPlayerId) {
+		return false;
+	}
+
+	for (MxS16 i = 0; i < p_a.m_count; i++) {
+		const LegoGameState::ScoreItem& a = p_a.m_scores[i];
+		const LegoGameState::ScoreItem& b = p_b.m_scores[i];
+
+		if (a.m_totalScore != b.m_totalScore || SDL_memcmp(a.m_scores, b.m_scores, sizeof(a.m_scores)) != 0 ||
+			!NameEquals(a.m_name, b.m_name) || a.m_playerId != b.m_playerId) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Images committed to the writer and flushed load back byte for byte, and a
+// smaller image replaces a larger one without leaving the rest of it behind
+ISLE_TEST(LegoSaveRoundTrip)
+{
+	LegoSaveWriter writer;
+
+	LegoMemory* image = new LegoMemory;
+	Serialize(*image, 1);
+	writer.Commit(TEST_SAVE, image);
+	writer.Flush();
+	ISLE_CHECK(MatchesFile(TEST_SAVE, 1));
+
+	image = new LegoMemory;
+	Serialize(*image, 3);
+	writer.Commit(TEST_SAVE, image);
+	writer.Flush();
+	ISLE_CHECK(MatchesFile(TEST_SAVE, 3));
+
+	// Written under a temporary name, which is gone once renamed
+	ISLE_CHECK(!SDL_GetPathInfo(TEST_SAVE ".tmp", NULL));
+	ISLE_CHECK(SDL_RemovePath(TEST_SAVE));
+}
+
+// Two saves to the same file committed before the writer gets to them are
+// written once, with the second image. The writer is held up on another file
+// so that both are still queued when the second is committed.
+ISLE_TEST(LegoSaveCoalesced)
+{
+	SDL_Semaphore* release = SDL_CreateSemaphore(0);
+	SDL_ThreadID firstDeletedOn = 0;
+	ISLE_CHECK(release);
+
+	{
+		LegoSaveWriter writer;
+
+		LegoMemory* image = new BlockingImage(release);
+		Serialize(*image, 1);
+		writer.Commit(TEST_OTHER_SAVE, image);
+
+		image = new TrackedImage(&firstDeletedOn);
+		Serialize(*image, 2);
+		writer.Commit(TEST_SAVE, image);
+
+		image = new LegoMemory;
+		Serialize(*image, 3);
+		writer.Commit(TEST_SAVE, image);
+
+		SDL_SignalSemaphore(release);
+		writer.Flush();
+	}
+
+	SDL_DestroySemaphore(release);
+
+	// The first image was replaced in the queue rather than written
+	ISLE_CHECK(firstDeletedOn == SDL_GetCurrentThreadID());
+	ISLE_CHECK(MatchesFile(TEST_OTHER_SAVE, 1));
+	ISLE_CHECK(MatchesFile(TEST_SAVE, 3));
+	ISLE_CHECK(SDL_RemovePath(TEST_OTHER_SAVE));
+	ISLE_CHECK(SDL_RemovePath(TEST_SAVE));
+}
+
+// A game saved through LegoGameState loads back into a new game state, with its
+// players, score history and states, the way the game loads it on startup
+ISLE_TEST(LegoGameStateSaveLoad)
+{
+	IsleRandom random(1);
+	char savePath[] = TEST_GAME_DIR;
+	ISLE_CHECK(SDL_CreateDirectory(TEST_GAME_DIR));
+
+	LegoOmni* lego = new TestLego;
+	LegoGameState* state = new LegoGameState;
+	lego->SetGameState(state);
+	state->SetSavePath(savePath);
+
+	// Save only writes the game of a registered player
+	InfocenterState* infocenterState = (InfocenterState*) state->CreateState("InfocenterState");
+	infocenterState->SetNameLetter(0, new MxStillPresenter);
+
+	state->m_playerCount = 4;
+	for (MxS16 i = 0; i < state->m_playerCount; i++) {
+		RandomName(random, state->m_players[i]);
+	}
+
+	state->m_history.m_count = 12;
+	for (MxS16 i = 0; i < state->m_history.m_count; i++) {
+		LegoGameState::ScoreItem& score = state->m_history.m_scores[i];
+		score.m_totalScore = 0;
+
+		for (MxS32 j = 0; j < 5; j++) {
+			for (MxS32 k = 0; k < 5; k++) {
+				score.m_scores[j][k] = random.Next(4);
+				score.m_totalScore += score.m_scores[j][k];
+			}
+		}
+
+		RandomName(random, score.m_name);
+		score.m_playerId = i;
+	}
+
+	// The current player is in the score history, and is ranked again on saving
+	state->m_history.m_nextPlayerId = state->m_history.m_count;
+	state->m_currentPlayerId = 5;
+	state->m_history.m_scores[5].m_name = state->m_players[0];
+
+	HospitalState hospital;
+	hospital.m_stateActor = random.Next(6);
+	hospital.m_statePepper = random.Next(3);
+	hospital.m_stateMama = random.Next(3);
+	hospital.m_statePapa = random.Next(3);
+	hospital.m_stateNick = random.Next(3);
+	hospital.m_stateLaura = random.Next(3);
+	state->RegisterState(new HospitalState(hospital));
+
+	GasStationState gasStation;
+	gasStation.m_pepperAction = random.Next(3);
+	gasStation.m_mamaAction = random.Next(3);
+	gasStation.m_papaAction = random.Next(3);
+	gasStation.m_nickAction = random.Next(3);
+	gasStation.m_lauraAction = random.Next(3);
+	state->RegisterState(new GasStationState(gasStation));
+
+	state->SetCurrentAct(LegoGameState::e_act2);
+	state->m_unk0x42c = LegoGameState::e_infomain;
+	VariableTable()->SetVariable("lightposition", "4");
+
+	ISLE_CHECK(state->Save(0) == SUCCESS);
+	state->SerializePlayersInfo(LegoFile::c_write);
+
+	LegoGameState::History history = state->m_history;
+	LegoGameState::Username players[4];
+	for (MxS16 i = 0; i < 4; i++) {
+		players[i] = state->m_players[i];
+	}
+
+	// Deleting the game state waits for its files to be written, as quitting does
+	lego->SetGameState(NULL);
+	delete state;
+	VariableTable()->SetVariable("lightposition", "1");
+
+	state = new LegoGameState;
+	lego->SetGameState(state);
+	state->SetSavePath(savePath);
+	state->SerializePlayersInfo(LegoFile::c_read);
+	state->SerializeScoreHistory(LegoFile::c_read);
+	ISLE_CHECK(state->Load(0) == SUCCESS);
+
+	ISLE_CHECK(state->m_playerCount == 4);
+	for (MxS16 i = 0; i < 4; i++) {
+		ISLE_CHECK(NameEquals(state->m_players[i], players[i]));
+	}
+
+	ISLE_CHECK(HistoryEquals(state->m_history, history));
+	ISLE_CHECK(state->m_currentPlayerId == 5);
+	ISLE_CHECK(state->GetCurrentAct() == LegoGameState::e_act2);
+	ISLE_CHECK(state->m_unk0x42c == LegoGameState::e_infomain);
+	ISLE_CHECK(SDL_strcmp(VariableTable()->GetVariable("lightposition"), "4") == 0);
+
+	HospitalState* loadedHospital = (HospitalState*) state->GetState("HospitalState");
+	ISLE_CHECK(loadedHospital != NULL);
+	ISLE_CHECK(loadedHospital->m_stateActor == hospital.m_stateActor);
+	ISLE_CHECK(loadedHospital->m_statePepper == hospital.m_statePepper);
+	ISLE_CHECK(loadedHospital->m_stateMama == hospital.m_stateMama);
+	ISLE_CHECK(loadedHospital->m_statePapa == hospital.m_statePapa);
+	ISLE_CHECK(loadedHospital->m_stateNick == hospital.m_stateNick);
+	ISLE_CHECK(loadedHospital->m_stateLaura == hospital.m_stateLaura);
+
+	GasStationState* loadedGasStation = (GasStationState*) state->GetState("GasStationState");
+	ISLE_CHECK(loadedGasStation != NULL);
+	ISLE_CHECK(loadedGasStation->m_pepperAction == gasStation.m_pepperAction);
+	ISLE_CHECK(loadedGasStation->m_mamaAction == gasStation.m_mamaAction);
+	ISLE_CHECK(loadedGasStation->m_papaAction == gasStation.m_papaAction);
+	ISLE_CHECK(loadedGasStation->m_nickAction == gasStation.m_nickAction);
+	ISLE_CHECK(loadedGasStation->m_lauraAction == gasStation.m_lauraAction);
+
+	// Also deletes the game state
+	MxOmni::DestroyInstance();
+
+	ISLE_CHECK(SDL_RemovePath(TEST_GAME_DIR "/G0.GS"));
+	ISLE_CHECK(SDL_RemovePath(TEST_GAME_DIR "/Players.gsi"));
+	ISLE_CHECK(SDL_RemovePath(TEST_GAME_DIR "/History.gsi"));
+	ISLE_CHECK(SDL_RemovePath(TEST_GAME_DIR));
+}
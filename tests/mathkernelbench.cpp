@@ -0,0 +1,130 @@
+// Times the virtual Matrix4 and Vector3 API against the math kernels it
+// forwards to, on fixed random data. The virtual calls go through a reference,
+// as the ROI and animation code makes them, so the compiler cannot
+// devirtualize them. The original Product loop is timed as well.
+//
+// Usage: mathkernel-bench [iterations]
+
+#include "mxgeometry/mxgeometry3d.h"
+#include "mxgeometry/mxmatrix.h"
+#include "realtime/mathkernel.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#define BENCH_COUNT 1024
+
+static MxMatrix g_a[BENCH_COUNT];
+static MxMatrix g_b[BENCH_COUNT];
+static MxMatrix g_out[BENCH_COUNT];
+static Mx3DPointFloat g_v[BENCH_COUNT];
+static Mx3DPointFloat g_w[BENCH_COUNT];
+static Mx3DPointFloat g_cross[BENCH_COUNT];
+
+// Matrix4::Product as it was before it forwarded to Mat4Product
+static void OriginalProduct(float (*p_out)[4], float (*p_a)[4], float (*p_b)[4])
+{
+	float* cur = (float*) p_out;
+
+	for (int row = 0; row < 4; row++) {
+		for (int col = 0; col < 4; col++) {
+			*cur = 0.0f;
+			for (int k = 0; k < 4; k++) {
+				*cur += p_a[row][k] * p_b[k][col];
+			}
+			cur++;
+		}
+	}
+}
+
+static void VirtualProduct(Matrix4& p_out, const Matrix4& p_a, const Matrix4& p_b)
+{
+	p_out.Product(p_a, p_b);
+}
+
+static float VirtualCrossDot(Vector3& p_out, const Vector3& p_a, const Vector3& p_b)
+{
+	p_out.EqualsCross(p_a, p_b);
+	return p_out.Dot(p_out, p_a);
+}
+
+static void Report(const char* p_name, Uint64 p_ticks, int p_numIterations, float p_checksum)
+{
+	double nsPerCall = p_ticks * 1000000000.0 / SDL_GetPerformanceFrequency() / p_numIterations / BENCH_COUNT;
+	SDL_Log("mathkernel-bench: %-24s %7.2f ns per call, checksum %g", p_name, nsPerCall, p_checksum);
+}
+
+int main(int argc, char** argv)
+{
+	int numIterations = argc > 1 ? SDL_atoi(argv[1]) : 2000;
+	if (numIterations == 0) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Usage: %s [iterations]", argv[0]);
+		return 1;
+	}
+
+	SDL_srand(1);
+	for (int i = 0; i < BENCH_COUNT; i++) {
+		for (int j = 0; j < 16; j++) {
+			g_a[i][0][j] = SDL_randf() * 2.0f - 1.0f;
+			g_b[i][0][j] = SDL_randf() * 2.0f - 1.0f;
+		}
+
+		for (int j = 0; j < 3; j++) {
+			g_v[i][j] = SDL_randf() * 2.0f - 1.0f;
+			g_w[i][j] = SDL_randf() * 2.0f - 1.0f;
+		}
+	}
+
+	// Each checksum also keeps its loop from being optimized away
+	float checksum = 0.0f;
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int n = 0; n < numIterations; n++) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			OriginalProduct(g_out[i].GetData(), g_a[i].GetData(), g_b[i].GetData());
+		}
+		checksum += g_out[n % BENCH_COUNT][1][2];
+	}
+	Report("original Product loop", SDL_GetPerformanceCounter() - start, numIterations, checksum);
+
+	checksum = 0.0f;
+	start = SDL_GetPerformanceCounter();
+	for (int n = 0; n < numIterations; n++) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			VirtualProduct(g_out[i], g_a[i], g_b[i]);
+		}
+		checksum += g_out[n % BENCH_COUNT][1][2];
+	}
+	Report("virtual Matrix4::Product", SDL_GetPerformanceCounter() - start, numIterations, checksum);
+
+	checksum = 0.0f;
+	start = SDL_GetPerformanceCounter();
+	for (int n = 0; n < numIterations; n++) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			Mat4Product(g_out[i][0], g_a[i][0], g_b[i][0]);
+		}
+		checksum += g_out[n % BENCH_COUNT][1][2];
+	}
+	Report("Mat4Product", SDL_GetPerformanceCounter() - start, numIterations, checksum);
+
+	checksum = 0.0f;
+	start = SDL_GetPerformanceCounter();
+	for (int n = 0; n < numIterations; n++) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			checksum += VirtualCrossDot(g_cross[i], g_v[i], g_w[i]);
+		}
+	}
+	Report("virtual cross and dot", SDL_GetPerformanceCounter() - start, numIterations, checksum);
+
+	checksum = 0.0f;
+	start = SDL_GetPerformanceCounter();
+	for (int n = 0; n < numIterations; n++) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			Vec3Cross(&g_cross[i][0], &g_v[i][0], &g_w[i][0]);
+			checksum += Vec3Dot(&g_cross[i][0], &g_v[i][0]);
+		}
+	}
+	Report("Vec3Cross and Vec3Dot", SDL_GetPerformanceCounter() - start, numIterations, checksum);
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+#include "isletest.h"
+#include "mxgeometry/mxgeometry3d.h"
+#include "mxgeometry/mxmatrix.h"
+#include "realtime/mathkernel.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <vec.h>
+
+// Compilers may fuse the multiplies and adds of one path and not the other,
+// so results are compared to within a few units in the last place
+static bool Near(float p_a, float p_b)
+{
+	return SDL_fabsf(p_a - p_b) <= 1e-5f * (1.0f + SDL_fabsf(p_b));
+}
+
+static bool Near(const float* p_a, const float* p_b, int p_count)
+{
+	for (int i = 0; i < p_count; i++) {
+		if (!Near(p_a[i], p_b[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void RandomFill(float* p_data, int p_count)
+{
+	for (int i = 0; i < p_count; i++) {
+		p_data[i] = SDL_randf() * 20.0f - 10.0f;
+	}
+}
+
+// Matrix4::Product as it was before it forwarded to Mat4Product
+static void OriginalProduct(float (*p_out)[4], float (*p_a)[4], float (*p_b)[4])
+{
+	float* cur = (float*) p_out;
+
+	for (int row = 0; row < 4; row++) {
+		for (int col = 0; col < 4; col++) {
+			*cur = 0.0f;
+			for (int k = 0; k < 4; k++) {
+				*cur += p_a[row][k] * p_b[k][col];
+			}
+			cur++;
+		}
+	}
+}
+
+// The kernels compute what the virtual Vector3 and Matrix4 API and the vec.h
+// macros they replaced compute, including when the output aliases an input
+ISLE_TEST(MathKernelMatchesVirtual)
+{
+	SDL_srand(1);
+
+	for (int iteration = 0; iteration < 1000; iteration++) {
+		MxMatrix a;
+		MxMatrix b;
+		MxMatrix product;
+		float expected[4][4];
+		float kernel[16];
+
+		RandomFill(a[0], 16);
+		RandomFill(b[0], 16);
+
+		OriginalProduct(expected, a.GetData(), b.GetData());
+		product.Product(a, b);
+		Mat4Product(kernel, a[0], b[0]);
+		ISLE_CHECK(Near(product[0], expected[0], 16));
+		ISLE_CHECK(Near(kernel, expected[0], 16));
+
+		// In place, as OrientableROI updates its local to world transform
+		Mat4Product(a[0], a[0], b[0]);
+		ISLE_CHECK(Near(a[0], expected[0], 16));
+
+		Mx3DPointFloat v;
+		Mx3DPointFloat w;
+		Mx3DPointFloat cross;
+		float point[3];
+		float transformed[3];
+
+		RandomFill(&v[0], 3);
+		RandomFill(&w[0], 3);
+
+		V3XM4(point, &v[0], b.GetData());
+		Vec3TransformPoint(transformed, &v[0], b[0]);
+		ISLE_CHECK(Near(transformed, point, 3));
+
+		ISLE_CHECK(Near(Vec3Dot(&v[0], &w[0]), v.Dot(v, w)));
+
+		cross.EqualsCross(v, w);
+		Vec3Cross(point, &v[0], &w[0]);
+		ISLE_CHECK(Near(point, &cross[0], 3));
+
+		Vec3Cross(&v[0], &v[0], &w[0]);
+		ISLE_CHECK(Near(&v[0], &cross[0], 3));
+
+		ISLE_CHECK(cross.Unitize() == 0);
+		Vec3Unitize(point);
+		ISLE_CHECK(Near(point, &cross[0], 3));
+	}
+
+	float zero[3] = {0.0f, 0.0f, 0.0f};
+	Mx3DPointFloat virtualZero(0.0f, 0.0f, 0.0f);
+	ISLE_CHECK(Vec3Unitize(zero) == -1);
+	ISLE_CHECK(virtualZero.Unitize() == -1);
+}
@@ -0,0 +1,245 @@
+// Renders a fixed scene through miniwin's software renderer without showing a
+// window, and reports where the frame time went along with a hash of the last
+// frame. The scene only depends on the frame number, so the hash of a run can
+// be compared across builds to check that an optimization kept the output.
+//
+// Usage: miniwin-bench [frames]
+
+#include "miniwinfixture.h"
+
+#include <SDL3/SDL_hints.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include <miniwin/miniwindevice.h>
+#include <vector>
+
+#define BENCH_WIDTH 640
+#define BENCH_HEIGHT 480
+#define BENCH_GRID 9     // Spheres per row and column, the outer ones partly outside the view
+#define BENCH_SLICES 16  // Around the sphere
+#define BENCH_STACKS 12  // Pole to pole
+#define BENCH_TEXTURE 64 // Checkerboard size in pixels
+
+static IDirect3DRMMesh* CreateSphere(IDirect3DRM2* p_d3drm, IDirect3DRMTexture2* p_texture, float p_radius)
+{
+	std::vector<D3DRMVERTEX> vertices;
+	std::vector<unsigned int> faces;
+
+	for (int stack = 0; stack <= BENCH_STACKS; stack++) {
+		float theta = SDL_PI_F * stack / BENCH_STACKS;
+
+		for (int slice = 0; slice <= BENCH_SLICES; slice++) {
+			float phi = 2.0f * SDL_PI_F * slice / BENCH_SLICES;
+			D3DRMVERTEX vertex;
+			SDL_zero(vertex);
+			vertex.normal.x = SDL_sinf(theta) * SDL_cosf(phi);
+			vertex.normal.y = SDL_cosf(theta);
+			vertex.normal.z = SDL_sinf(theta) * SDL_sinf(phi);
+			vertex.position.x = vertex.normal.x * p_radius;
+			vertex.position.y = vertex.normal.y * p_radius;
+			vertex.position.z = vertex.normal.z * p_radius;
+			vertex.tu = (float) slice / BENCH_SLICES;
+			vertex.tv = (float) stack / BENCH_STACKS;
+			vertices.push_back(vertex);
+		}
+	}
+
+	for (int stack = 0; stack < BENCH_STACKS; stack++) {
+		for (int slice = 0; slice < BENCH_SLICES; slice++) {
+			unsigned int a = stack * (BENCH_SLICES + 1) + slice;
+			unsigned int b = a + BENCH_SLICES + 1;
+			unsigned int quad[] = {a, a + 1, b, a + 1, b + 1, b};
+			faces.insert(faces.end(), quad, quad + 6);
+		}
+	}
+
+	IDirect3DRMMesh* mesh;
+	D3DRMGROUPINDEX group;
+	p_d3drm->CreateMesh(&mesh);
+	mesh->AddGroup(vertices.size(), faces.size() / 3, 3, faces.data(), &group);
+	mesh->SetVertices(group, 0, vertices.size(), vertices.data());
+
+	if (p_texture) {
+		mesh->SetGroupColorRGB(group, 1.0f, 1.0f, 1.0f);
+		mesh->SetGroupTexture(group, p_texture);
+		mesh->SetGroupMapping(group, D3DRMMAP_PERSPCORRECT);
+	}
+	else {
+		mesh->SetGroupColorRGB(group, 0.8f, 0.4f, 0.2f);
+	}
+
+	return mesh;
+}
+
+static IDirectDrawSurface* CreateCheckerboard(IDirectDraw* p_directDraw)
+{
+	DDSURFACEDESC desc;
+	SDL_zero(desc);
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DDSD_WIDTH | DDSD_HEIGHT;
+	desc.dwWidth = BENCH_TEXTURE;
+	desc.dwHeight = BENCH_TEXTURE;
+
+	IDirectDrawSurface* surface;
+	if (p_directDraw->CreateSurface(&desc, &surface, NULL) != DD_OK) {
+		return NULL;
+	}
+
+	if (surface->Lock(NULL, &desc, DDLOCK_WAIT, NULL) == DD_OK) {
+		for (int y = 0; y < BENCH_TEXTURE; y++) {
+			Uint32* row = (Uint32*) ((Uint8*) desc.lpSurface + y * desc.lPitch);
+			for (int x = 0; x < BENCH_TEXTURE; x++) {
+				row[x] = ((x / 8 + y / 8) & 1) ? 0xffffffff : 0xff2060c0;
+			}
+		}
+		surface->Unlock(desc.lpSurface);
+	}
+
+	return surface;
+}
+
+static void SetPosition(IDirect3DRMFrame* p_frame, float p_x, float p_y, float p_z, float p_angle)
+{
+	float c = SDL_cosf(p_angle);
+	float s = SDL_sinf(p_angle);
+	D3DRMMATRIX4D matrix = {{c, 0.0f, -s, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {s, 0.0f, c, 0.0f}, {p_x, p_y, p_z, 1.0f}};
+	p_frame->AddTransform(D3DRMCOMBINE_REPLACE, matrix);
+}
+
+static double ToMilliseconds(Uint64 p_ticks, Uint32 p_frames)
+{
+	return p_ticks * 1000.0 / SDL_GetPerformanceFrequency() / p_frames;
+}
+
+static bool Run(SoftwareDevice& p_device, Uint32 p_numFrames)
+{
+	IDirect3DRM2* d3drm2 = p_device.m_d3drm;
+	IDirect3DRMMiniwinDevice* miniwinDevice;
+	p_device.m_device->QueryInterface(IID_IDirect3DRMMiniwinDevice, (void**) &miniwinDevice);
+
+	// Scene: a grid of spheres, every other one textured, lit by an ambient and a directional light
+	IDirect3DRMFrame2* scene;
+	IDirect3DRMFrame2* camera;
+	IDirect3DRMFrame2* sun;
+	IDirect3DRMLight* ambientLight;
+	IDirect3DRMLight* sunLight;
+	IDirect3DRMViewport* viewport;
+
+	d3drm2->CreateFrame(NULL, &scene);
+	scene->SetSceneBackgroundRGB(0.1f, 0.1f, 0.2f);
+	d3drm2->CreateFrame(scene, &camera);
+	d3drm2->CreateFrame(scene, &sun);
+	SetPosition(sun, 0.0f, 0.0f, 0.0f, 0.6f);
+
+	d3drm2->CreateLightRGB(D3DRMLIGHT_AMBIENT, 0.3f, 0.3f, 0.3f, &ambientLight);
+	d3drm2->CreateLightRGB(D3DRMLIGHT_DIRECTIONAL, 0.8f, 0.8f, 0.8f, &sunLight);
+	scene->AddLight(ambientLight);
+	sun->AddLight(sunLight);
+
+	IDirectDrawSurface* textureSurface = CreateCheckerboard(p_device.m_directDraw);
+	IDirect3DRMTexture2* texture = NULL;
+	if (textureSurface) {
+		d3drm2->CreateTextureFromSurface(textureSurface, &texture);
+	}
+
+	IDirect3DRMMesh* plainSphere = CreateSphere(d3drm2, NULL, 0.6f);
+	IDirect3DRMMesh* texturedSphere = CreateSphere(d3drm2, texture, 0.6f);
+	std::vector<IDirect3DRMFrame2*> objects;
+
+	for (int i = 0; i < BENCH_GRID * BENCH_GRID; i++) {
+		// Rendered frames are visuals of their parent, the way Tgl builds groups
+		IDirect3DRMFrame2* object;
+		d3drm2->CreateFrame(NULL, &object);
+		scene->AddVisual(object);
+		object->AddVisual(i % 2 ? texturedSphere : plainSphere);
+		objects.push_back(object);
+	}
+
+	d3drm2->CreateViewport(p_device.m_device, camera, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, &viewport);
+	viewport->SetFront(0.1f);
+	viewport->SetBack(100.0f);
+	viewport->SetField(0.5f);
+
+	miniwinDevice->EnableFrameStats(true);
+	Uint64 totalTicks = 0;
+
+	for (Uint32 frame = 0; frame < p_numFrames; frame++) {
+		for (int i = 0; i < BENCH_GRID * BENCH_GRID; i++) {
+			float x = (i % BENCH_GRID - BENCH_GRID / 2) * 1.5f;
+			float y = (i / BENCH_GRID - BENCH_GRID / 2) * 1.5f;
+			SetPosition(objects[i], x, y, 8.0f + 0.5f * SDL_sinf(frame * 0.05f + i), frame * 0.02f + i);
+		}
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		viewport->Clear();
+		viewport->Render(scene);
+		p_device.m_frontBuffer->Flip(NULL, DDFLIP_WAIT);
+		totalTicks += SDL_GetPerformanceCounter() - start;
+	}
+
+	MiniwinFrameStats stats;
+	miniwinDevice->GetFrameStats(&stats, false);
+	bool rendered = stats.frames == p_numFrames;
+
+	if (!rendered) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only %u of %u frames were rendered", stats.frames, p_numFrames);
+	}
+	else {
+		SDL_Log("miniwin-bench: %u frames of %ux%u", stats.frames, BENCH_WIDTH, BENCH_HEIGHT);
+		SDL_Log(
+			"  per frame: total %.3f ms, culling %.3f ms, lighting %.3f ms, rasterization %.3f ms, present %.3f ms",
+			ToMilliseconds(totalTicks, stats.frames),
+			ToMilliseconds(stats.cullingTicks, stats.frames),
+			ToMilliseconds(stats.lightingTicks, stats.frames),
+			ToMilliseconds(stats.rasterizationTicks, stats.frames),
+			ToMilliseconds(stats.presentTicks, stats.frames)
+		);
+		SDL_Log(
+			"  per frame: %u meshes tested, %u culled, %u draws, %u triangles",
+			stats.meshesTested / stats.frames,
+			stats.meshesCulled / stats.frames,
+			stats.draws / stats.frames,
+			stats.triangles / stats.frames
+		);
+		SDL_Log("  image hash: 0x%08x", stats.imageHash);
+	}
+
+	for (IDirect3DRMFrame2* object : objects) {
+		object->Release();
+	}
+	plainSphere->Release();
+	texturedSphere->Release();
+	if (texture) {
+		texture->Release();
+		textureSurface->Release();
+	}
+	viewport->Release();
+	sunLight->Release();
+	ambientLight->Release();
+	sun->Release();
+	camera->Release();
+	scene->Release();
+	miniwinDevice->Release();
+	return rendered;
+}
+
+int main(int argc, char** argv)
+{
+	Uint32 numFrames = argc > 1 ? SDL_atoi(argv[1]) : 300;
+	if (numFrames == 0) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Usage: %s [frames]", argv[0]);
+		return 1;
+	}
+
+	// Rendered to an offscreen surface, presented to a window that is never shown
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
+	SoftwareDevice device;
+	if (!device.Init(BENCH_WIDTH, BENCH_HEIGHT)) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create the software renderer: %s", SDL_GetError());
+		return 1;
+	}
+
+	return Run(device, numFrames) ? 0 : 1;
+}
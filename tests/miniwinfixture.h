@@ -0,0 +1,220 @@
+#ifndef MINIWINFIXTURE_H
+#define MINIWINFIXTURE_H
+
+#include <SDL3/SDL_init.h>
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_video.h>
+#include <miniwin/d3d.h>
+#include <miniwin/d3drm.h>
+#include <miniwin/ddraw.h>
+
+#define TEST_WIDTH 160
+#define TEST_HEIGHT 120
+#define TEST_TEXTURE 64
+
+// Miniwin's software renderer, see d3drmrenderer_software.h
+DEFINE_GUID(TEST_SOFTWARE_GUID, 0x682656F3, 0x0000, 0x0000, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02);
+
+// Miniwin's software renderer in a hidden window, set up the way MxDirect3D
+// does, through a primary surface and IDirect3D2
+class SoftwareDevice {
+public:
+	SoftwareDevice()
+	{
+		m_window = NULL;
+		m_directDraw = NULL;
+		m_device = NULL;
+	}
+
+	~SoftwareDevice()
+	{
+		if (m_device) {
+			m_device->Release(); // Also deletes the renderer
+			m_d3drm->Release();
+			m_direct3D->Release();
+			m_frontBuffer->Release();
+		}
+		if (m_directDraw) {
+			m_directDraw->Release();
+		}
+		if (m_window) {
+			SDL_DestroyWindow(m_window);
+			SDL_QuitSubSystem(SDL_INIT_VIDEO);
+		}
+	}
+
+	bool Init(int p_width, int p_height)
+	{
+		if (!SDL_InitSubSystem(SDL_INIT_VIDEO)) {
+			return false;
+		}
+
+		m_window = SDL_CreateWindow("isle-tests", p_width, p_height, SDL_WINDOW_HIDDEN);
+		if (!m_window) {
+			SDL_QuitSubSystem(SDL_INIT_VIDEO);
+			return false;
+		}
+
+		DDSURFACEDESC desc;
+		SDL_zero(desc);
+		desc.dwSize = sizeof(desc);
+		desc.dwFlags = DDSD_CAPS;
+		desc.ddsCaps.dwCaps = DDSCAPS_PRIMARYSURFACE;
+
+		IDirect3DDevice2* direct3DDevice;
+		IDirect3DRM* d3drm;
+
+		DirectDrawCreate(NULL, &m_directDraw, NULL);
+		m_directDraw->SetCooperativeLevel((HWND) m_window, DDSCL_NORMAL);
+		m_directDraw->CreateSurface(&desc, &m_frontBuffer, NULL);
+		m_directDraw->QueryInterface(IID_IDirect3D2, (void**) &m_direct3D);
+
+		if (m_direct3D->CreateDevice(TEST_SOFTWARE_GUID, m_frontBuffer, &direct3DDevice) != DD_OK) {
+			m_direct3D->Release();
+			m_frontBuffer->Release();
+			return false;
+		}
+
+		Direct3DRMCreate(&d3drm);
+		d3drm->QueryInterface(IID_IDirect3DRM2, (void**) &m_d3drm);
+		d3drm->Release();
+		m_d3drm->CreateDeviceFromD3D(m_direct3D, direct3DDevice, &m_device);
+		return true;
+	}
+
+	SDL_Window* m_window;
+	IDirectDraw* m_directDraw;
+	IDirectDrawSurface* m_frontBuffer;
+	IDirect3D2* m_direct3D;
+	IDirect3DRM2* m_d3drm;
+	IDirect3DRMDevice2* m_device;
+};
+
+// A software renderer drawing one textured quad that covers the whole view,
+// with the texture's center at the center of the view
+class SoftwareFixture : public SoftwareDevice {
+public:
+	SoftwareFixture() { m_scene = NULL; }
+
+	~SoftwareFixture()
+	{
+		if (m_scene) {
+			m_viewport->Release();
+			m_quad->Release();
+			m_object->Release();
+			m_light->Release();
+			m_camera->Release();
+			m_scene->Release();
+			m_texture->Release();
+			m_textureSurface->Release();
+		}
+	}
+
+	bool Init()
+	{
+		if (!SoftwareDevice::Init(TEST_WIDTH, TEST_HEIGHT)) {
+			return false;
+		}
+
+		DDSURFACEDESC desc;
+		SDL_zero(desc);
+		desc.dwSize = sizeof(desc);
+		desc.dwFlags = DDSD_WIDTH | DDSD_HEIGHT;
+		desc.dwWidth = TEST_TEXTURE;
+		desc.dwHeight = TEST_TEXTURE;
+		m_directDraw->CreateSurface(&desc, &m_textureSurface, NULL);
+
+		// Not the surface's own texture, so unlocking the surface does not mark the texture changed
+		m_d3drm->CreateTextureFromSurface(m_textureSurface, &m_texture);
+
+		m_d3drm->CreateFrame(NULL, &m_scene);
+		m_d3drm->CreateFrame(m_scene, &m_camera);
+		m_d3drm->CreateFrame(NULL, &m_object);
+		m_scene->AddVisual(m_object);
+		m_d3drm->CreateLightRGB(D3DRMLIGHT_AMBIENT, 1.0f, 1.0f, 1.0f, &m_light);
+		m_scene->AddLight(m_light);
+
+		// At z = 2 the view spans x from -2 to 2 and y from -1.5 to 1.5
+		D3DRMVERTEX vertices[4];
+		SDL_zeroa(vertices);
+		for (int i = 0; i < 4; i++) {
+			vertices[i].position.x = i & 1 ? 2.2f : -2.2f;
+			vertices[i].position.y = i & 2 ? 2.2f : -2.2f;
+			vertices[i].position.z = 2.0f;
+			vertices[i].normal.z = -1.0f;
+			vertices[i].tu = i & 1 ? 1.0f : 0.0f;
+			vertices[i].tv = i & 2 ? 0.0f : 1.0f;
+		}
+
+		// Both windings, so that one of them faces the camera
+		unsigned int faces[] = {0, 1, 2, 2, 1, 3, 0, 2, 1, 2, 3, 1};
+		D3DRMGROUPINDEX group;
+		m_d3drm->CreateMesh(&m_quad);
+		m_quad->AddGroup(4, 4, 3, faces, &group);
+		m_quad->SetVertices(group, 0, 4, vertices);
+		m_quad->SetGroupColorRGB(group, 1.0f, 1.0f, 1.0f);
+		m_quad->SetGroupTexture(group, m_texture);
+		m_quad->SetGroupMapping(group, D3DRMMAP_PERSPCORRECT);
+		m_object->AddVisual(m_quad);
+
+		m_d3drm->CreateViewport(m_device, m_camera, 0, 0, TEST_WIDTH, TEST_HEIGHT, &m_viewport);
+		m_viewport->SetFront(0.5f);
+		m_viewport->SetBack(10.0f);
+		m_viewport->SetField(0.5f);
+		return true;
+	}
+
+	bool FillTexture(Uint8 p_r, Uint8 p_g, Uint8 p_b)
+	{
+		DDSURFACEDESC desc;
+		SDL_zero(desc);
+		desc.dwSize = sizeof(desc);
+
+		if (m_textureSurface->Lock(NULL, &desc, DDLOCK_WAIT, NULL) != DD_OK) {
+			return false;
+		}
+
+		const SDL_PixelFormatDetails* details = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32);
+		for (int y = 0; y < TEST_TEXTURE; y++) {
+			Uint32* row = (Uint32*) ((Uint8*) desc.lpSurface + y * desc.lPitch);
+			for (int x = 0; x < TEST_TEXTURE; x++) {
+				row[x] = SDL_MapRGBA(details, NULL, p_r, p_g, p_b, 255);
+			}
+		}
+
+		m_textureSurface->Unlock(desc.lpSurface);
+		return true;
+	}
+
+	// Renders a frame and reads back the pixel at p_x, p_y
+	SDL_Color Render(int p_x, int p_y)
+	{
+		SDL_Color color = {0, 0, 0, 0};
+		m_viewport->Clear();
+		m_viewport->Render(m_scene);
+
+		DDSURFACEDESC desc;
+		SDL_zero(desc);
+		desc.dwSize = sizeof(desc);
+
+		if (m_frontBuffer->Lock(NULL, &desc, DDLOCK_WAIT, NULL) == DD_OK) {
+			Uint32 pixel = *(Uint32*) ((Uint8*) desc.lpSurface + p_y * desc.lPitch + p_x * 4);
+			const SDL_PixelFormatDetails* details = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32);
+			SDL_GetRGBA(pixel, details, NULL, &color.r, &color.g, &color.b, &color.a);
+			m_frontBuffer->Unlock(desc.lpSurface);
+		}
+
+		return color;
+	}
+
+	IDirectDrawSurface* m_textureSurface;
+	IDirect3DRMTexture2* m_texture;
+	IDirect3DRMFrame2* m_scene;
+	IDirect3DRMFrame2* m_camera;
+	IDirect3DRMFrame2* m_object;
+	IDirect3DRMLight* m_light;
+	IDirect3DRMMesh* m_quad;
+	IDirect3DRMViewport* m_viewport;
+};
+
+#endif // MINIWINFIXTURE_H
@@ -0,0 +1,199 @@
+#include "isletest.h"
+#include "legotextureinfo.h"
+#include "miniwinfixture.h"
+#include "mxflcpresenter.h"
+#include "mxgeometry.h"
+#include "mxomni.h"
+
+#include <vector>
+
+static bool IsRed(SDL_Color p_color)
+{
+	return p_color.r > 200 && p_color.b < 50;
+}
+
+static bool IsBlue(SDL_Color p_color)
+{
+	return p_color.b > 200 && p_color.r < 50;
+}
+
+// A texture changed in one rect has only that rect converted again by the
+// software renderer. Texels outside of it keep what was uploaded before, even
+// though the surface behind them has changed too.
+ISLE_TEST(MiniwinDirtyTextureRect)
+{
+	const int cornerX = 4;
+	const int cornerY = 4;
+
+	SoftwareFixture fixture;
+	ISLE_CHECK(fixture.Init());
+	ISLE_CHECK(fixture.FillTexture(255, 0, 0));
+
+	// The first use uploads the whole texture
+	ISLE_CHECK(IsRed(fixture.Render(TEST_WIDTH / 2, TEST_HEIGHT / 2)));
+	ISLE_CHECK(IsRed(fixture.Render(cornerX, cornerY)));
+
+	// The whole surface turns blue, but only its center is reported
+	ISLE_CHECK(fixture.FillTexture(0, 0, 255));
+	RECT center = {TEST_TEXTURE / 4, TEST_TEXTURE / 4, TEST_TEXTURE * 3 / 4, TEST_TEXTURE * 3 / 4};
+	ISLE_CHECK(fixture.m_texture->Changed(D3DRMTEXTURE_CHANGEDPIXELS, 1, &center) == DD_OK);
+
+	ISLE_CHECK(IsBlue(fixture.Render(TEST_WIDTH / 2, TEST_HEIGHT / 2)));
+	ISLE_CHECK(IsRed(fixture.Render(cornerX, cornerY)));
+
+	// Changing the whole texture uploads the rest
+	ISLE_CHECK(fixture.m_texture->Changed(TRUE, FALSE) == DD_OK);
+	ISLE_CHECK(IsBlue(fixture.Render(cornerX, cornerY)));
+}
+
+// MxVideoPresenter looks for the video manager, which the tests do without
+class TestOmni : public MxOmni {
+public:
+	TestOmni() { SetInstance(this); }
+	~TestOmni() override { SetInstance(NULL); }
+};
+
+// The rect handling of LegoFlcTexturePresenter::LoadFrame, for a FLC of the texture's size
+class FlcRects : public MxFlcPresenter {
+public:
+	FlcRects()
+	{
+		m_flcHeader = (FLIC_HEADER*) new MxU8[sizeof(FLIC_HEADER)];
+		SDL_zerop(m_flcHeader);
+		m_flcHeader->width = TEST_TEXTURE;
+		m_flcHeader->height = TEST_TEXTURE;
+	}
+
+	using MxFlcPresenter::UnionFrameRects;
+};
+
+// An 8-bit texture like the ones LegoTextureInfo::Create makes
+static bool CreateTextureInfo(SoftwareFixture& p_fixture, LegoTextureInfo& p_textureInfo)
+{
+	DDSURFACEDESC desc;
+	SDL_zero(desc);
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT | DDSD_CAPS;
+	desc.dwWidth = TEST_TEXTURE;
+	desc.dwHeight = TEST_TEXTURE;
+	desc.ddsCaps.dwCaps = DDSCAPS_TEXTURE | DDSCAPS_SYSTEMMEMORY;
+	desc.ddpfPixelFormat.dwSize = sizeof(desc.ddpfPixelFormat);
+	desc.ddpfPixelFormat.dwFlags = DDPF_RGB | DDPF_PALETTEINDEXED8;
+	desc.ddpfPixelFormat.dwRGBBitCount = 8;
+
+	if (p_fixture.m_directDraw->CreateSurface(&desc, &p_textureInfo.m_surface, NULL) != DD_OK) {
+		return false;
+	}
+
+	PALETTEENTRY entries[256];
+	for (int i = 0; i < 256; i++) {
+		entries[i].peRed = i;
+		entries[i].peGreen = 255 - i;
+		entries[i].peBlue = 0;
+		entries[i].peFlags = PC_NONE;
+	}
+
+	if (p_fixture.m_directDraw->CreatePalette(
+			DDPCAPS_ALLOW256 | DDPCAPS_8BIT,
+			entries,
+			&p_textureInfo.m_palette,
+			NULL
+		) != DD_OK) {
+		return false;
+	}
+
+	p_textureInfo.m_surface->SetPalette(p_textureInfo.m_palette);
+	return p_fixture.m_d3drm->CreateTextureFromSurface(p_textureInfo.m_surface, &p_textureInfo.m_texture) == D3DRM_OK;
+}
+
+static bool RectEquals(const MxRect32& p_rect, MxS32 p_left, MxS32 p_top, MxS32 p_right, MxS32 p_bottom)
+{
+	return p_rect.GetLeft() == p_left && p_rect.GetTop() == p_top && p_rect.GetRight() == p_right &&
+		   p_rect.GetBottom() == p_bottom;
+}
+
+// Whether the surface holds p_inside within p_rect and p_outside everywhere else
+static bool SurfaceMatches(
+	LegoTextureInfo& p_textureInfo,
+	const std::vector<MxU8>& p_inside,
+	const std::vector<MxU8>& p_outside,
+	const MxRect32& p_rect
+)
+{
+	DDSURFACEDESC desc;
+	SDL_zero(desc);
+	desc.dwSize = sizeof(desc);
+
+	if (p_textureInfo.m_surface->Lock(NULL, &desc, DDLOCK_WAIT, NULL) != DD_OK) {
+		return false;
+	}
+
+	bool matches = true;
+	for (int y = 0; y < TEST_TEXTURE; y++) {
+		const MxU8* row = (const MxU8*) desc.lpSurface + y * desc.lPitch;
+
+		for (int x = 0; x < TEST_TEXTURE; x++) {
+			bool inside = x >= p_rect.GetLeft() && x <= p_rect.GetRight() && y >= p_rect.GetTop() &&
+						  y <= p_rect.GetBottom();
+			const std::vector<MxU8>& expected = inside ? p_inside : p_outside;
+
+			if (row[x] != expected[y * TEST_TEXTURE + x]) {
+				matches = false;
+			}
+		}
+	}
+
+	p_textureInfo.m_surface->Unlock(desc.lpSurface);
+	return matches;
+}
+
+// A FLC texture frame copies the union of its changed rects into the texture,
+// flipped into the rows of the bottom-up frame bitmap, and nothing else
+ISLE_TEST(LegoFlcTextureDirtyRect)
+{
+	SoftwareFixture fixture;
+	ISLE_CHECK(fixture.Init());
+
+	TestOmni omni;
+	FlcRects flc;
+	LegoTextureInfo textureInfo;
+	ISLE_CHECK(CreateTextureInfo(fixture, textureInfo));
+
+	std::vector<MxU8> previous(TEST_TEXTURE * TEST_TEXTURE);
+	std::vector<MxU8> frame(TEST_TEXTURE * TEST_TEXTURE);
+	for (int i = 0; i < TEST_TEXTURE * TEST_TEXTURE; i++) {
+		previous[i] = i % 7;
+		frame[i] = 100 + i % 13;
+	}
+
+	// The first frame goes out whole
+	LegoU32 bytesLoaded = LegoTextureInfo::GetBytesLoaded();
+	ISLE_CHECK(textureInfo.LoadBits(previous.data()) == SUCCESS);
+	ISLE_CHECK(LegoTextureInfo::GetBytesLoaded() - bytesLoaded == TEST_TEXTURE * TEST_TEXTURE);
+
+	// Two frames decoded before the next PutFrame, their rects given top-down as in the FLC chunks
+	MxRect32 firstFrame[] = {MxRect32(8, 4, 23, 11), MxRect32(16, 10, 31, 19)};
+	MxRect32 secondFrame[] = {MxRect32(40, 50, 47, 53)};
+	MxRect32 dirtyRect;
+
+	flc.UnionFrameRects((MxU8*) firstFrame, 2, dirtyRect, FALSE);
+	ISLE_CHECK(RectEquals(dirtyRect, 8, 44, 31, 59));
+
+	flc.UnionFrameRects((MxU8*) secondFrame, 1, dirtyRect, TRUE);
+	ISLE_CHECK(RectEquals(dirtyRect, 8, 10, 47, 59));
+
+	bytesLoaded = LegoTextureInfo::GetBytesLoaded();
+	ISLE_CHECK(textureInfo.LoadBits(frame.data(), dirtyRect) == SUCCESS);
+	ISLE_CHECK(LegoTextureInfo::GetBytesLoaded() - bytesLoaded == 40 * 50);
+	ISLE_CHECK(SurfaceMatches(textureInfo, frame, previous, dirtyRect));
+
+	// The next PutFrame starts over from its own frame's rects
+	flc.UnionFrameRects((MxU8*) secondFrame, 1, dirtyRect, FALSE);
+	ISLE_CHECK(RectEquals(dirtyRect, 40, 10, 47, 13));
+
+	// Rects reaching past the texture are clipped to it
+	MxRect32 clipped(60, 60, 70, 70);
+	bytesLoaded = LegoTextureInfo::GetBytesLoaded();
+	ISLE_CHECK(textureInfo.LoadBits(previous.data(), clipped) == SUCCESS);
+	ISLE_CHECK(LegoTextureInfo::GetBytesLoaded() - bytesLoaded == 4 * 4);
+}
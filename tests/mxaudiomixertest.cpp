@@ -0,0 +1,304 @@
+#include "isletest.h"
+#include "mxaudiomixer.h"
+
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+#include <miniaudio.h>
+#include <vector>
+
+#define TEST_SAMPLE_RATE 22050
+#define TEST_NUM_FRAMES 65536
+#define TEST_DEVICE_FRAMES 8192
+
+// A mono engine without a device playing a ramp, so that mixed output can be
+// compared frame by frame with the source
+class MixerFixture {
+public:
+	MixerFixture() : m_samples(TEST_NUM_FRAMES)
+	{
+		m_initialized = false;
+
+		for (MxU32 i = 0; i < TEST_NUM_FRAMES; i++) {
+			m_samples[i] = (float) i / TEST_NUM_FRAMES;
+		}
+	}
+
+	~MixerFixture()
+	{
+		if (m_initialized) {
+			m_mixer.Destroy();
+			ma_sound_uninit(&m_sound);
+			ma_audio_buffer_uninit(&m_buffer);
+			ma_engine_uninit(&m_engine);
+		}
+	}
+
+	bool Init(MxU32 p_ringSizeInFrames, MxBool p_headless)
+	{
+		ma_engine_config engineConfig = ma_engine_config_init();
+		engineConfig.noDevice = MA_TRUE;
+		engineConfig.channels = 1;
+		engineConfig.sampleRate = TEST_SAMPLE_RATE;
+		engineConfig.allocationCallbacks = m_mixer.GetAllocationCallbacks();
+
+		if (ma_engine_init(&engineConfig, &m_engine) != MA_SUCCESS) {
+			return false;
+		}
+
+		ma_audio_buffer_config bufferConfig =
+			ma_audio_buffer_config_init(ma_format_f32, 1, TEST_NUM_FRAMES, m_samples.data(), NULL);
+		bufferConfig.sampleRate = TEST_SAMPLE_RATE;
+
+		if (ma_audio_buffer_init(&bufferConfig, &m_buffer) != MA_SUCCESS) {
+			ma_engine_uninit(&m_engine);
+			return false;
+		}
+
+		if (ma_sound_init_from_data_source(
+				&m_engine,
+				&m_buffer,
+				MA_SOUND_FLAG_NO_SPATIALIZATION | MA_SOUND_FLAG_NO_PITCH,
+				NULL,
+				&m_sound
+			) != MA_SUCCESS) {
+			ma_audio_buffer_uninit(&m_buffer);
+			ma_engine_uninit(&m_engine);
+			return false;
+		}
+
+		m_initialized = true;
+		m_mixer.SetAllocationHook(&CountAllocation);
+		g_numAllocations = 0;
+		return m_mixer.Create(&m_engine, p_ringSizeInFrames, p_headless) == SUCCESS;
+	}
+
+	MxU32 GetNumBlocks()
+	{
+		MxAudioMixer::Stats stats;
+		m_mixer.GetStats(stats);
+		return stats.m_blocks;
+	}
+
+	static void CountAllocation(size_t p_size) { g_numAllocations++; }
+
+	static MxU32 g_numAllocations;
+
+	MxAudioMixer m_mixer;
+	ma_engine m_engine;
+	ma_audio_buffer m_buffer;
+	ma_sound m_sound;
+	std::vector<float> m_samples;
+	bool m_initialized;
+};
+
+MxU32 MixerFixture::g_numAllocations = 0;
+
+// Commands are answered for as if applied, reach the engine together at the
+// next Render, and a full queue is drained instead of dropping commands
+ISLE_TEST(MixerCommandQueue)
+{
+	MixerFixture fixture;
+	ISLE_CHECK(fixture.Init(0, TRUE));
+
+	MxAudioMixer& mixer = fixture.m_mixer;
+	ma_sound* sound = &fixture.m_sound;
+	float out[256];
+
+	ISLE_CHECK(mixer.Start(NULL) == MA_INVALID_ARGS);
+
+	mixer.BeginBatch();
+	mixer.Start(sound);
+	ISLE_CHECK(mixer.IsPlaying(sound));
+	ISLE_CHECK(!ma_sound_is_playing(sound));
+	mixer.Stop(sound);
+	ISLE_CHECK(!mixer.IsPlaying(sound));
+	mixer.Start(sound);
+	mixer.EndBatch();
+
+	ISLE_CHECK(!ma_sound_is_playing(sound));
+	ISLE_CHECK(mixer.Render(out, 256) == 256);
+	ISLE_CHECK(ma_sound_is_playing(sound));
+
+	// The first frame of the render that applied the start is the first frame of the sound
+	for (MxU32 i = 0; i < 256; i++) {
+		ISLE_CHECK(SDL_fabsf(out[i] - fixture.m_samples[i]) < 1e-6f);
+	}
+
+	// A queued seek rewinds the sound
+	mixer.SeekToPCMFrame(sound, 0);
+	ISLE_CHECK(!mixer.AtEnd(sound));
+
+	// More commands than the queue holds
+	for (MxU32 i = 0; i < 3000; i++) {
+		mixer.SetVolume(sound, (float) i / 3000);
+	}
+
+	mixer.Flush(sound);
+	ISLE_CHECK(SDL_fabsf(ma_sound_get_volume(sound) - 2999.0f / 3000) < 1e-6f);
+
+	MxAudioMixer::Stats stats;
+	mixer.GetStats(stats);
+	ISLE_CHECK(stats.m_commands == 3 + 1 + 3000);
+	ISLE_CHECK(stats.m_queueFull > 0);
+
+	mixer.Stop(sound);
+	mixer.Render(out, 256);
+	ISLE_CHECK(!ma_sound_is_playing(sound));
+	ISLE_CHECK(!mixer.IsPlaying(sound));
+}
+
+// The mixer thread keeps the ring full in whole blocks, and reads from the
+// device side come out in order across the ring's wrap-around
+ISLE_TEST(MixerRing)
+{
+	const MxU32 ringSizeInFrames = 1000; // Rounded up to four blocks
+	const MxU32 chunkSizeInFrames = 300;
+
+	MixerFixture fixture;
+	ISLE_CHECK(fixture.Init(ringSizeInFrames, FALSE));
+
+	MxAudioMixer& mixer = fixture.m_mixer;
+	ISLE_CHECK(!mixer.IsHeadless());
+
+	mixer.Start(&fixture.m_sound);
+	mixer.Flush(&fixture.m_sound);
+
+	SDL_AudioSpec spec = {SDL_AUDIO_F32, 1, TEST_SAMPLE_RATE};
+	SDL_AudioStream* stream = SDL_CreateAudioStream(&spec, &spec);
+	ISLE_CHECK(stream != NULL);
+
+	MxU32 framesRead = 0;
+	MxU32 startFrame = 0;
+	bool started = false;
+	bool inOrder = true;
+
+	for (MxU32 chunk = 0; chunk < 20; chunk++) {
+		// Wait for the mixer to render past what has been read so far
+		Uint64 deadline = SDL_GetTicks() + 5000;
+		while (fixture.GetNumBlocks() * 256 < framesRead + chunkSizeInFrames && SDL_GetTicks() < deadline) {
+			SDL_Delay(1);
+		}
+
+		mixer.Read(stream, chunkSizeInFrames);
+		framesRead += chunkSizeInFrames;
+
+		float out[chunkSizeInFrames];
+		if (SDL_GetAudioStreamData(stream, out, sizeof(out)) != sizeof(out)) {
+			inOrder = false;
+			break;
+		}
+
+		for (MxU32 i = 0; i < chunkSizeInFrames; i++) {
+			// Blocks rendered before the start was applied are silent
+			if (!started && out[i] != 0.0f) {
+				started = true;
+				startFrame = (MxU32) SDL_lroundf(out[i] * TEST_NUM_FRAMES);
+			}
+
+			if (started && SDL_fabsf(out[i] - fixture.m_samples[startFrame++]) >= 1e-6f) {
+				inOrder = false;
+			}
+		}
+	}
+
+	SDL_DestroyAudioStream(stream);
+
+	MxAudioMixer::Stats stats;
+	mixer.GetStats(stats);
+
+	ISLE_CHECK(started);
+	ISLE_CHECK(inOrder);
+	ISLE_CHECK(stats.m_underruns == 0);
+	ISLE_CHECK(stats.m_blocks * 256 <= framesRead + 1024);
+}
+
+// Frames asked for per callback by SDL devices, from a single frame to the
+// largest device buffer, which MxSoundManager mixes two of ahead
+static const MxU32 g_readSizes[] = {1, 37, 255, 256, 257, 1000, 4096, TEST_DEVICE_FRAMES};
+
+// Neither Render, nor Read, nor the mixer thread makes the engine allocate,
+// whatever the commands they apply and however many frames they are asked for.
+// Run headless, then with the mixer thread.
+ISLE_TEST(MixerNoRealtimeAllocation)
+{
+	const MxU32 numReadSizes = sizeof(g_readSizes) / sizeof(g_readSizes[0]);
+	std::vector<float> out(TEST_DEVICE_FRAMES);
+
+	{
+		MixerFixture fixture;
+		ISLE_CHECK(fixture.Init(0, TRUE));
+
+		MxAudioMixer& mixer = fixture.m_mixer;
+		ma_sound* sound = &fixture.m_sound;
+
+		for (MxU32 i = 0; i < 200; i++) {
+			switch (i % 5) {
+			case 0:
+				mixer.Start(sound);
+				break;
+			case 1:
+				mixer.SetVolume(sound, 0.5f);
+				mixer.SetLooping(sound, MA_TRUE);
+				break;
+			case 2:
+				mixer.SeekToPCMFrame(sound, i * 100);
+				mixer.SetListenerPosition(1.0f, 0.0f, 0.0f);
+				break;
+			case 3:
+				mixer.Stop(sound);
+				break;
+			}
+
+			mixer.Render(out.data(), g_readSizes[i % numReadSizes]);
+		}
+
+		MxAudioMixer::Stats stats;
+		mixer.GetStats(stats);
+		ISLE_CHECK(stats.m_realtimeAllocations == 0);
+		ISLE_CHECK(MixerFixture::g_numAllocations == 0);
+	}
+
+	{
+		MixerFixture fixture;
+		ISLE_CHECK(fixture.Init(2 * TEST_DEVICE_FRAMES, FALSE));
+
+		MxAudioMixer& mixer = fixture.m_mixer;
+		SDL_AudioSpec spec = {SDL_AUDIO_F32, 1, TEST_SAMPLE_RATE};
+		SDL_AudioStream* stream = SDL_CreateAudioStream(&spec, &spec);
+		ISLE_CHECK(stream != NULL);
+
+		mixer.Start(&fixture.m_sound);
+		mixer.SetLooping(&fixture.m_sound, MA_TRUE);
+
+		MxU32 framesRead = 0;
+		bool complete = true;
+
+		for (MxU32 i = 0; i < 4 * numReadSizes; i++) {
+			MxU32 frames = g_readSizes[i % numReadSizes];
+			mixer.SetVolume(&fixture.m_sound, (float) i / (4 * numReadSizes));
+
+			// Wait for the mixer to render enough, as a device would between callbacks
+			Uint64 deadline = SDL_GetTicks() + 5000;
+			while (fixture.GetNumBlocks() * 256 < framesRead + frames && SDL_GetTicks() < deadline) {
+				SDL_Delay(1);
+			}
+
+			mixer.Read(stream, frames);
+			framesRead += frames;
+
+			if (SDL_GetAudioStreamData(stream, out.data(), frames * sizeof(float)) != (int) (frames * sizeof(float))) {
+				complete = false;
+			}
+		}
+
+		SDL_DestroyAudioStream(stream);
+
+		MxAudioMixer::Stats stats;
+		mixer.GetStats(stats);
+		ISLE_CHECK(complete);
+		ISLE_CHECK(stats.m_underruns == 0);
+		ISLE_CHECK(stats.m_realtimeAllocations == 0);
+		ISLE_CHECK(MixerFixture::g_numAllocations == 0);
+	}
+}
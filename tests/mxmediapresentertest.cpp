@@ -0,0 +1,96 @@
+#include "isletest.h"
+#include "mxdsbuffer.h"
+#include "mxmediapresenter.h"
+#include "mxmemorystats.h"
+#include "mxsharedbuffer.h"
+#include "mxstreamchunk.h"
+
+#include <SDL3/SDL_stdinc.h>
+
+#define TEST_FILE_SIZE 4096
+#define TEST_CHUNK_OFFSET 100
+#define TEST_CHUNK_SIZE 1000
+
+// Loops chunks without a stream or an action
+class LoopingPresenter : public MxMediaPresenter {
+public:
+	LoopingPresenter() { m_loopingChunks = new MxStreamChunkList; }
+
+	MxStreamChunk* GetLoopedChunk()
+	{
+		MxStreamChunkListCursor cursor(m_loopingChunks);
+		MxStreamChunk* chunk = NULL;
+		cursor.Last(chunk);
+		return chunk;
+	}
+};
+
+static MxU32 GetLiveStreamBytes()
+{
+	MxMemoryStats::Counters counters;
+	MxMemoryStats::Get(MxMemoryStats::e_streamBuffers, counters);
+	return counters.m_live;
+}
+
+// A chunk streamed from a RAM stream is looped by reference, and its payload
+// outlives the stream's buffer. A chunk with its own data is still copied.
+ISLE_TEST(MxMediaPresenterLoopChunkShared)
+{
+	MxU32 liveBefore = GetLiveStreamBytes();
+	MxU8 payload[TEST_CHUNK_SIZE];
+
+	// The RAM stream's file contents, held by its buffer as MxRAMStreamController does
+	MxSharedBuffer* file = new MxSharedBuffer(TEST_FILE_SIZE, MxMemoryStats::e_streamBuffers);
+	for (MxU32 i = 0; i < TEST_FILE_SIZE; i++) {
+		file->GetData()[i] = (MxU8) (i * 7);
+	}
+
+	MxDSBuffer* buffer = new MxDSBuffer;
+	buffer->SetBufferPointer(file->GetData(), TEST_FILE_SIZE);
+	buffer->SetSharedBuffer(file);
+	file->Release();
+
+	MxStreamChunk* chunk = new MxStreamChunk;
+	chunk->SetBuffer(buffer);
+	buffer->AddRef(chunk);
+	chunk->SetData(file->GetData() + TEST_CHUNK_OFFSET);
+	chunk->SetLength(TEST_CHUNK_SIZE);
+	chunk->SetTime(250);
+	SDL_memcpy(payload, chunk->GetData(), TEST_CHUNK_SIZE);
+
+	{
+		LoopingPresenter presenter;
+		MxU32 sharedBefore = MxMediaPresenter::GetLoopBytesShared();
+
+		presenter.LoopChunk(chunk);
+		ISLE_CHECK(MxMediaPresenter::GetLoopBytesShared() - sharedBefore == TEST_CHUNK_SIZE);
+
+		MxStreamChunk* looped = presenter.GetLoopedChunk();
+		ISLE_CHECK(looped != NULL);
+		ISLE_CHECK(looped->GetData() == chunk->GetData());
+		ISLE_CHECK(looped->GetTime() == 250);
+
+		// The stream goes away, and the file contents stay alive for the loop
+		delete chunk;
+		delete buffer;
+		ISLE_CHECK(GetLiveStreamBytes() - liveBefore == TEST_FILE_SIZE);
+		ISLE_CHECK(looped->GetLength() == TEST_CHUNK_SIZE);
+		ISLE_CHECK(SDL_memcmp(looped->GetData(), payload, TEST_CHUNK_SIZE) == 0);
+
+		// Data that is not in a shared buffer is copied
+		MxStreamChunk copied;
+		copied.SetData(payload);
+		copied.SetLength(TEST_CHUNK_SIZE);
+		sharedBefore = MxMediaPresenter::GetLoopBytesShared();
+
+		presenter.LoopChunk(&copied);
+		ISLE_CHECK(MxMediaPresenter::GetLoopBytesShared() == sharedBefore);
+
+		looped = presenter.GetLoopedChunk();
+		ISLE_CHECK(looped->GetData() != payload);
+		ISLE_CHECK(SDL_memcmp(looped->GetData(), payload, TEST_CHUNK_SIZE) == 0);
+	}
+
+	// The last looped chunk released the file contents
+	ISLE_CHECK(GetLiveStreamBytes() == liveBefore);
+}
@@ -0,0 +1,146 @@
+#include "isletest.h"
+#include "miniwinfixture.h"
+#include "mxdsbuffer.h"
+#include "mxmemorypool.h"
+#include "mxmemorystats.h"
+#include "mxsharedbuffer.h"
+
+#include <miniwin/miniwindevice.h>
+
+#define TEST_NUM_MESHES 24
+#define TEST_NUM_BUFFERS 16
+#define TEST_NUM_BLOCKS 12
+
+// What a world holds while it is loaded, allocated through the same owners
+// that report to MxMemoryStats. The game data a real world is loaded from is
+// not available to the tests.
+struct TestWorld {
+	IDirect3DRMFrame2* m_frame;
+	IDirect3DRMMesh* m_meshes[TEST_NUM_MESHES];
+	MxDSBuffer* m_buffers[TEST_NUM_BUFFERS];
+	MxSharedBuffer* m_sounds[TEST_NUM_BUFFERS];
+	MxU8* m_blocks[TEST_NUM_BLOCKS];
+};
+
+// Meshes of different sizes, so that the renderer caches geometry of each size
+static void LoadWorld(SoftwareFixture& p_fixture, MxMemoryPool<1, 8>& p_pool, TestWorld& p_world)
+{
+	p_fixture.m_d3drm->CreateFrame(NULL, &p_world.m_frame);
+	p_fixture.m_scene->AddVisual(p_world.m_frame);
+
+	for (MxS32 i = 0; i < TEST_NUM_MESHES; i++) {
+		D3DRMVERTEX vertices[64];
+		unsigned int faces[64 * 3];
+		MxS32 numVertices = 3 + i * 2;
+		SDL_zeroa(vertices);
+
+		for (MxS32 v = 0; v < numVertices; v++) {
+			vertices[v].position.x = (v & 1 ? 0.1f : -0.1f) * i;
+			vertices[v].position.y = 0.05f * v - 1.0f;
+			vertices[v].position.z = 2.0f + 0.01f * i;
+			vertices[v].normal.z = -1.0f;
+		}
+
+		for (MxS32 f = 0; f < numVertices - 2; f++) {
+			faces[f * 3] = f;
+			faces[f * 3 + 1] = f + 1;
+			faces[f * 3 + 2] = f + 2;
+		}
+
+		D3DRMGROUPINDEX group;
+		p_fixture.m_d3drm->CreateMesh(&p_world.m_meshes[i]);
+		p_world.m_meshes[i]->AddGroup(numVertices, numVertices - 2, 3, faces, &group);
+		p_world.m_meshes[i]->SetVertices(group, 0, numVertices, vertices);
+		p_world.m_meshes[i]->SetGroupColorRGB(group, 1.0f, 1.0f, 1.0f);
+		p_world.m_frame->AddVisual(p_world.m_meshes[i]);
+	}
+
+	for (MxS32 i = 0; i < TEST_NUM_BUFFERS; i++) {
+		p_world.m_buffers[i] = new MxDSBuffer;
+		p_world.m_buffers[i]->AllocateBuffer(4096 * (i + 1), MxDSBuffer::e_allocate);
+		p_world.m_sounds[i] = new MxSharedBuffer(2048 * (i + 1), MxMemoryStats::e_sounds);
+	}
+
+	// More blocks than one slab holds, so that the pool grows on the first load
+	for (MxS32 i = 0; i < TEST_NUM_BLOCKS; i++) {
+		p_world.m_blocks[i] = p_pool.Get();
+	}
+
+	p_fixture.Render(TEST_WIDTH / 2, TEST_HEIGHT / 2);
+}
+
+static void UnloadWorld(SoftwareFixture& p_fixture, MxMemoryPool<1, 8>& p_pool, TestWorld& p_world)
+{
+	p_fixture.m_scene->DeleteVisual(p_world.m_frame);
+
+	for (MxS32 i = 0; i < TEST_NUM_MESHES; i++) {
+		p_world.m_frame->DeleteVisual(p_world.m_meshes[i]);
+		p_world.m_meshes[i]->Release();
+	}
+
+	p_world.m_frame->Release();
+
+	for (MxS32 i = 0; i < TEST_NUM_BUFFERS; i++) {
+		delete p_world.m_buffers[i];
+		p_world.m_sounds[i]->Release();
+	}
+
+	for (MxS32 i = 0; i < TEST_NUM_BLOCKS; i++) {
+		p_pool.Release(p_world.m_blocks[i]);
+	}
+
+	// The renderer lets go of geometry it no longer draws on the next frame
+	p_fixture.Render(TEST_WIDTH / 2, TEST_HEIGHT / 2);
+}
+
+// Loading and unloading a world again and again leaves every tag where the
+// first unload left it. Only the pool keeps what it grew to, as the streamer's
+// pools do, and nothing grows past the first load.
+ISLE_TEST(MxMemoryStatsSteadyAfterUnload)
+{
+	SoftwareFixture fixture;
+	IDirect3DRMMiniwinDevice* miniwinDevice;
+	MxMemoryPool<1, 8> pool(2);
+	MxMemoryStats::Counters before[MxMemoryStats::e_numTags];
+	MxMemoryStats::Counters steady[MxMemoryStats::e_numTags];
+
+	ISLE_CHECK(fixture.Init());
+	ISLE_CHECK(fixture.m_device->QueryInterface(IID_IDirect3DRMMiniwinDevice, (void**) &miniwinDevice) == DD_OK);
+	miniwinDevice->SetMemoryCallback(MxMemoryStats::MiniwinCallback);
+	ISLE_CHECK(pool.Allocate() == SUCCESS);
+
+	for (MxS32 tag = 0; tag < MxMemoryStats::e_numTags; tag++) {
+		MxMemoryStats::Get((MxMemoryStats::Tag) tag, before[tag]);
+	}
+
+	for (MxS32 cycle = 0; cycle < 8; cycle++) {
+		TestWorld world;
+		LoadWorld(fixture, pool, world);
+		UnloadWorld(fixture, pool, world);
+
+		for (MxS32 tag = 0; tag < MxMemoryStats::e_numTags; tag++) {
+			MxMemoryStats::Counters counters;
+			MxMemoryStats::Get((MxMemoryStats::Tag) tag, counters);
+
+			if (cycle == 0) {
+				ISLE_CHECK(counters.m_live == before[tag].m_live || tag == MxMemoryStats::e_memoryPools);
+				steady[tag] = counters;
+			}
+			else {
+				ISLE_CHECK(counters.m_live == steady[tag].m_live);
+				ISLE_CHECK(counters.m_peak == steady[tag].m_peak);
+				MxU32 numLive = counters.m_allocations - counters.m_frees;
+				ISLE_CHECK(numLive == steady[tag].m_allocations - steady[tag].m_frees);
+			}
+		}
+	}
+
+	// The load was counted at all
+	ISLE_CHECK(steady[MxMemoryStats::e_meshes].m_peak > before[MxMemoryStats::e_meshes].m_peak);
+	ISLE_CHECK(steady[MxMemoryStats::e_streamBuffers].m_peak > before[MxMemoryStats::e_streamBuffers].m_peak);
+	ISLE_CHECK(steady[MxMemoryStats::e_sounds].m_peak > before[MxMemoryStats::e_sounds].m_peak);
+	ISLE_CHECK(steady[MxMemoryStats::e_memoryPools].m_live > before[MxMemoryStats::e_memoryPools].m_live);
+
+	miniwinDevice->SetMemoryCallback(NULL);
+	miniwinDevice->Release();
+}
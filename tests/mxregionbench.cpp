@@ -0,0 +1,122 @@
+// Times MxRegion the way MxVideoManager uses it every frame: rects are
+// invalidated, the region is walked whole and under each presenter's rect,
+// then reset. Rect streams are generated from a fixed seed so that runs can
+// be compared across builds.
+//
+// Usage: mxregion-bench [frames]
+
+#include "isletest.h"
+#include "mxregion.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#define BENCH_WIDTH 640
+#define BENCH_HEIGHT 480
+#define BENCH_MAX_RECTS 64
+
+struct RectStream {
+	const char* m_name;
+	MxU32 m_numRects;   // per frame
+	MxS32 m_maxSize;    // width and height
+	MxBool m_topDown;   // rects arrive sorted top to bottom, as a full-screen refresh invalidates them
+	MxBool m_clustered; // rects pile up around the middle of the screen, as overlapping sprites do
+};
+
+static const RectStream g_streams[] = {
+	{"few small", 4, 64, FALSE, FALSE},
+	{"many small", 48, 48, FALSE, FALSE},
+	{"many clustered", 48, 96, FALSE, TRUE},
+	{"top down", 32, 160, TRUE, FALSE},
+};
+
+static void GenerateFrame(const RectStream& p_stream, IsleRandom& p_random, MxRect32* p_rects)
+{
+	MxS32 y = 0;
+
+	for (MxU32 i = 0; i < p_stream.m_numRects; i++) {
+		MxS32 width = 1 + p_random.Next(p_stream.m_maxSize);
+		MxS32 height = 1 + p_random.Next(p_stream.m_maxSize);
+		MxS32 left;
+		MxS32 top;
+
+		if (p_stream.m_topDown) {
+			left = p_random.Next(BENCH_WIDTH - width);
+			top = y;
+			y = (y + height) % (BENCH_HEIGHT - p_stream.m_maxSize);
+		}
+		else if (p_stream.m_clustered) {
+			left = BENCH_WIDTH / 2 - p_stream.m_maxSize + p_random.Next(p_stream.m_maxSize);
+			top = BENCH_HEIGHT / 2 - p_stream.m_maxSize + p_random.Next(p_stream.m_maxSize);
+		}
+		else {
+			left = p_random.Next(BENCH_WIDTH - width);
+			top = p_random.Next(BENCH_HEIGHT - height);
+		}
+
+		p_rects[i] = MxRect32(left, top, left + width, top + height);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	MxU32 numFrames = argc > 1 ? SDL_atoi(argv[1]) : 20000;
+	if (numFrames == 0) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Usage: %s [frames]", argv[0]);
+		return 1;
+	}
+
+	MxRegion region;
+	MxRect32 rects[BENCH_MAX_RECTS];
+
+	for (MxU32 s = 0; s < sizeof(g_streams) / sizeof(g_streams[0]); s++) {
+		const RectStream& stream = g_streams[s];
+		Uint64 addTicks = 0;
+		Uint64 walkTicks = 0;
+		MxU32 numWalked = 0; // also keeps the walks from being optimized away
+		IsleRandom random(1);
+
+		for (MxU32 frame = 0; frame < numFrames; frame++) {
+			GenerateFrame(stream, random, rects);
+
+			Uint64 start = SDL_GetPerformanceCounter();
+			for (MxU32 i = 0; i < stream.m_numRects; i++) {
+				region.AddRect(rects[i]);
+			}
+			Uint64 added = SDL_GetPerformanceCounter();
+
+			MxRegionCursor cursor(&region);
+			for (MxRect32* rect = cursor.Head(); rect; rect = cursor.Next()) {
+				numWalked++;
+			}
+
+			// MxVideoPresenter::PutFrame walks the region under its own rect
+			for (MxU32 i = 0; i < stream.m_numRects; i += 4) {
+				if (region.Intersects(rects[i])) {
+					for (MxRect32* rect = cursor.Head(rects[i]); rect; rect = cursor.Next(rects[i])) {
+						numWalked++;
+					}
+				}
+			}
+
+			region.Reset();
+			Uint64 end = SDL_GetPerformanceCounter();
+
+			addTicks += added - start;
+			walkTicks += end - added;
+		}
+
+		double usPerTick = 1000000.0 / SDL_GetPerformanceFrequency();
+		SDL_Log(
+			"mxregion-bench: %-14s %2u rects, add %.3f us, walk and reset %.3f us per frame, %u rects walked",
+			stream.m_name,
+			stream.m_numRects,
+			addTicks * usPerTick / numFrames,
+			walkTicks * usPerTick / numFrames,
+			numWalked
+		);
+	}
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+#include "isletest.h"
+#include "mxregion.h"
+
+#include <SDL3/SDL_stdinc.h>
+#include <limits.h>
+
+#define TEST_SIZE 64
+
+// The region as a bitmap, filled from the rects a cursor walks over. Fails
+// when rects overlap or the walks forward and backward disagree.
+static bool Paint(MxRegion& p_region, MxU8 p_pixels[TEST_SIZE][TEST_SIZE])
+{
+	SDL_memset(p_pixels, 0, TEST_SIZE * TEST_SIZE);
+
+	MxRegionCursor cursor(&p_region);
+	MxU32 numForward = 0;
+	MxU32 numBackward = 0;
+
+	for (MxRect32* rect = cursor.Head(); rect; rect = cursor.Next()) {
+		for (MxS32 y = rect->GetTop(); y < rect->GetBottom(); y++) {
+			for (MxS32 x = rect->GetLeft(); x < rect->GetRight(); x++) {
+				if (p_pixels[y][x]) {
+					return false;
+				}
+
+				p_pixels[y][x] = 1;
+			}
+		}
+
+		numForward++;
+	}
+
+	for (MxRect32* rect = cursor.Tail(); rect; rect = cursor.Prev()) {
+		numBackward++;
+	}
+
+	return numForward == numBackward;
+}
+
+// The area a cursor limited to p_rect walks over, forward or backward
+static MxS32 GetArea(MxRegion& p_region, MxRect32& p_rect, MxBool p_backward)
+{
+	MxRegionCursor cursor(&p_region);
+	MxS32 area = 0;
+
+	MxRect32* rect = p_backward ? cursor.Tail(p_rect) : cursor.Head(p_rect);
+	while (rect) {
+		area += (rect->GetRight() - rect->GetLeft()) * (rect->GetBottom() - rect->GetTop());
+		rect = p_backward ? cursor.Prev(p_rect) : cursor.Next(p_rect);
+	}
+
+	return area;
+}
+
+// Adds up to a dozen random rects to the region and to the bitmap
+static void AddRandomRects(MxRegion& p_region, IsleRandom& p_random, MxU8 p_pixels[TEST_SIZE][TEST_SIZE])
+{
+	SDL_memset(p_pixels, 0, TEST_SIZE * TEST_SIZE);
+
+	for (MxS32 i = p_random.Next(12); i > 0; i--) {
+		MxS32 left = p_random.Next(TEST_SIZE);
+		MxS32 top = p_random.Next(TEST_SIZE);
+		MxRect32 rect(left, top, Min(TEST_SIZE, left + p_random.Next(20)), Min(TEST_SIZE, top + p_random.Next(20)));
+		p_region.AddRect(rect);
+
+		for (MxS32 y = rect.GetTop(); y < rect.GetBottom(); y++) {
+			for (MxS32 x = rect.GetLeft(); x < rect.GetRight(); x++) {
+				p_pixels[y][x] = 1;
+			}
+		}
+	}
+}
+
+// Whether the region's bounding rect is the smallest one around the bitmap's pixels
+static bool BoundsMatch(MxRegion& p_region, MxU8 p_pixels[TEST_SIZE][TEST_SIZE])
+{
+	MxRect32 bounds(INT_MAX, INT_MAX, -1, -1);
+
+	for (MxS32 y = 0; y < TEST_SIZE; y++) {
+		for (MxS32 x = 0; x < TEST_SIZE; x++) {
+			if (p_pixels[y][x]) {
+				bounds.SetLeft(Min(bounds.GetLeft(), x));
+				bounds.SetTop(Min(bounds.GetTop(), y));
+				bounds.SetRight(Max(bounds.GetRight(), x + 1));
+				bounds.SetBottom(Max(bounds.GetBottom(), y + 1));
+			}
+		}
+	}
+
+	MxRect32& rect = p_region.GetBoundingRect();
+	return rect.GetLeft() == bounds.GetLeft() && rect.GetTop() == bounds.GetTop() &&
+		   rect.GetRight() == bounds.GetRight() && rect.GetBottom() == bounds.GetBottom();
+}
+
+// Random rects added to a region cover exactly the pixels they cover in a
+// bitmap, in disjoint rects, and cursors limited to a rect see the same part
+// of the region as the bitmap. Unions and intersections of regions, and of a
+// region with a rect, cover the union and intersection of their bitmaps.
+ISLE_TEST(MxRegionMatchesBitmap)
+{
+	MxRegion region;
+	MxRegion other;
+	MxRegion intersection;
+	MxU8 expected[TEST_SIZE][TEST_SIZE];
+	MxU8 otherExpected[TEST_SIZE][TEST_SIZE];
+	MxU8 actual[TEST_SIZE][TEST_SIZE];
+	IsleRandom random(1);
+
+	for (MxU32 iteration = 0; iteration < 2000; iteration++) {
+		AddRandomRects(region, random, expected);
+
+		ISLE_CHECK(Paint(region, actual));
+		ISLE_CHECK(SDL_memcmp(actual, expected, sizeof(actual)) == 0);
+
+		MxS32 left = random.Next(TEST_SIZE);
+		MxS32 top = random.Next(TEST_SIZE);
+		MxRect32 clip(left, top, left + random.Next(40), top + random.Next(40));
+		MxS32 area = 0;
+
+		for (MxS32 y = clip.GetTop(); y < Min(TEST_SIZE, clip.GetBottom()); y++) {
+			for (MxS32 x = clip.GetLeft(); x < Min(TEST_SIZE, clip.GetRight()); x++) {
+				area += expected[y][x];
+			}
+		}
+
+		ISLE_CHECK(GetArea(region, clip, FALSE) == area);
+		ISLE_CHECK(GetArea(region, clip, TRUE) == area);
+		ISLE_CHECK(clip.Empty() || (region.Intersects(clip) != FALSE) == (area != 0));
+
+		// A region combined with itself stays as it is
+		region.Union(region);
+		region.Intersect(region);
+		ISLE_CHECK(Paint(region, actual));
+		ISLE_CHECK(SDL_memcmp(actual, expected, sizeof(actual)) == 0);
+
+		AddRandomRects(other, random, otherExpected);
+
+		intersection.Union(region);
+		intersection.Intersect(other);
+		area = 0;
+
+		for (MxS32 y = 0; y < TEST_SIZE; y++) {
+			for (MxS32 x = 0; x < TEST_SIZE; x++) {
+				otherExpected[y][x] |= expected[y][x] << 1;
+				expected[y][x] = otherExpected[y][x] == 3;
+				area += expected[y][x];
+			}
+		}
+
+		ISLE_CHECK(Paint(intersection, actual));
+		ISLE_CHECK(SDL_memcmp(actual, expected, sizeof(actual)) == 0);
+		ISLE_CHECK(BoundsMatch(intersection, expected));
+		ISLE_CHECK((intersection.IsEmpty() != FALSE) == (area == 0));
+
+		region.Union(other);
+
+		for (MxS32 y = 0; y < TEST_SIZE; y++) {
+			for (MxS32 x = 0; x < TEST_SIZE; x++) {
+				expected[y][x] = otherExpected[y][x] != 0;
+			}
+		}
+
+		ISLE_CHECK(Paint(region, actual));
+		ISLE_CHECK(SDL_memcmp(actual, expected, sizeof(actual)) == 0);
+
+		region.Intersect(clip);
+
+		for (MxS32 y = 0; y < TEST_SIZE; y++) {
+			for (MxS32 x = 0; x < TEST_SIZE; x++) {
+				if (clip.Empty() || x < clip.GetLeft() || x >= clip.GetRight() || y < clip.GetTop() ||
+					y >= clip.GetBottom()) {
+					expected[y][x] = 0;
+				}
+			}
+		}
+
+		ISLE_CHECK(Paint(region, actual));
+		ISLE_CHECK(SDL_memcmp(actual, expected, sizeof(actual)) == 0);
+		ISLE_CHECK(BoundsMatch(region, expected));
+
+		region.Reset();
+		other.Reset();
+		intersection.Reset();
+		ISLE_CHECK(region.IsEmpty());
+	}
+}
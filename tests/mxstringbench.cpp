@@ -0,0 +1,127 @@
+// Counts the heap allocations MxString makes over a scripted workload: a few
+// world loads, which intern script atoms, build SI paths and name objects and
+// variables, then a minute of frames that read and write variables and build
+// names the way presenters and actors do. The original MxString allocated on
+// every construction, assignment and concatenation, so the number of string
+// operations is what it would have allocated at least.
+//
+// Usage: mxstring-bench [frames]
+
+#include "mxatom.h"
+#include "mxstring.h"
+#include "mxvariabletable.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#define BENCH_NUM_OBJECTS 200
+#define BENCH_NUM_VARIABLES 40
+
+// A typical install path, longer than MxString's inline buffer like most real ones
+static const char* g_hdPath = "/home/player/.local/share/isledecomp/isle/LEGO";
+
+static const char* g_worlds[] = {
+	"\\lego\\scripts\\isle\\isle",
+	"\\lego\\scripts\\infocntr\\infomain",
+	"\\lego\\scripts\\race\\carrace",
+	"\\lego\\scripts\\police\\police",
+};
+
+static MxU32 g_numOperations;
+
+static void LoadWorld(MxAtomSet& p_atoms, MxVariableTable& p_variables, const char* p_world)
+{
+	char name[32];
+
+	// MxStreamer opening the world's script
+	p_atoms.Intern(p_world, e_lowerCase2);
+	MxString path = MxString(g_hdPath) + p_world + ".si";
+	g_numOperations += 3;
+
+	// Every object of the script gets a name, which its presenter copies and
+	// its atom interns
+	for (MxS32 i = 0; i < BENCH_NUM_OBJECTS; i++) {
+		SDL_snprintf(name, sizeof(name), "%s_obj%03d", SDL_strrchr(p_world, '\\') + 1, i);
+
+		MxString objectName(name);
+		MxString presenterName(objectName);
+		presenterName = objectName;
+		p_atoms.Intern(name, e_lowerCase2);
+		g_numOperations += 3;
+	}
+
+	for (MxS32 i = 0; i < BENCH_NUM_VARIABLES; i++) {
+		char value[16];
+		SDL_snprintf(name, sizeof(name), "WORLD_VARIABLE_%02d", i);
+		SDL_snprintf(value, sizeof(value), "%d", i);
+
+		// A key and a value, and the key of the lookup that finds an existing one
+		p_variables.SetVariable(name, value);
+		g_numOperations += 3;
+	}
+}
+
+static void PlayFrame(MxVariableTable& p_variables, MxU32 p_frame)
+{
+	char value[16];
+	SDL_snprintf(value, sizeof(value), "%u", p_frame % 7);
+
+	// Scripts and actors read and write a few variables per frame
+	for (MxS32 i = 0; i < 4; i++) {
+		char key[32];
+		SDL_snprintf(key, sizeof(key), "WORLD_VARIABLE_%02d", (p_frame + i * 11) % BENCH_NUM_VARIABLES);
+		p_variables.GetVariable(key);
+		g_numOperations += 2;
+	}
+
+	p_variables.SetVariable("CURRENT_ACTOR", value);
+	g_numOperations += 3;
+
+	// Animation and sound names built from a prefix and a number
+	MxString name("ACT");
+	name += "_";
+	name += value;
+	MxString copy = name + ".wav";
+	g_numOperations += 4;
+}
+
+int main(int argc, char** argv)
+{
+	MxU32 numFrames = argc > 1 ? SDL_atoi(argv[1]) : 3600;
+	if (numFrames == 0) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Usage: %s [frames]", argv[0]);
+		return 1;
+	}
+
+	MxAtomSet atoms;
+	MxVariableTable variables;
+
+	MxU32 allocations = MxString::GetHeapAllocations();
+	g_numOperations = 0;
+
+	for (MxU32 i = 0; i < sizeof(g_worlds) / sizeof(g_worlds[0]); i++) {
+		LoadWorld(atoms, variables, g_worlds[i]);
+	}
+
+	SDL_Log(
+		"mxstring-bench: world loads %u string operations, %u heap allocations",
+		g_numOperations,
+		MxString::GetHeapAllocations() - allocations
+	);
+
+	allocations = MxString::GetHeapAllocations();
+	g_numOperations = 0;
+
+	for (MxU32 frame = 0; frame < numFrames; frame++) {
+		PlayFrame(variables, frame);
+	}
+
+	SDL_Log(
+		"mxstring-bench: %u frames %u string operations, %u heap allocations",
+		numFrames,
+		g_numOperations,
+		MxString::GetHeapAllocations() - allocations
+	);
+
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include "isletest.h"
+#include "mxtransitionhelpers.h"
+
+#include <SDL3/SDL_stdinc.h>
+
+// Wider than a row of 32-bit pixels, so that rows do not follow each other directly
+#define TEST_PITCH (640 * 4 + 12)
+
+static MxU8 g_original[TEST_PITCH * 480];
+static MxU8 g_surface[TEST_PITCH * 480];
+
+// The transitions as they were before their column order was inverted and
+// their pixel loops were split by pixel type
+struct OriginalTransition {
+	// The column order and scanline shifts, consuming random numbers as the original did
+	void Start(MxS32 p_numColumns, MxS32 p_numRows)
+	{
+		MxS32 i;
+		for (i = 0; i < p_numColumns; i++) {
+			m_columnOrder[i] = i;
+		}
+
+		for (i = 0; i < p_numColumns; i++) {
+			MxS32 swap = SDL_rand(p_numColumns);
+			MxU16 t = m_columnOrder[i];
+			m_columnOrder[i] = m_columnOrder[swap];
+			m_columnOrder[swap] = t;
+		}
+
+		for (i = 0; i < p_numRows; i++) {
+			m_randomShift[i] = SDL_rand(p_numColumns);
+		}
+	}
+
+	void Dissolve(DDSURFACEDESC& p_ddsd, MxS32 p_tick)
+	{
+		for (MxS32 col = 0; col < 640; col++) {
+			if (p_tick * 16 > m_columnOrder[col] || p_tick * 16 + 15 < m_columnOrder[col]) {
+				continue;
+			}
+
+			for (MxS32 row = 0; row < 480; row++) {
+				MxS32 xShift = (m_randomShift[row] + col) % 640;
+
+				if (p_ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
+					MxU8* surf = (MxU8*) p_ddsd.lpSurface + p_ddsd.lPitch * row + xShift;
+					*surf = 0;
+				}
+				else if (p_ddsd.ddpfPixelFormat.dwRGBBitCount == 16) {
+					MxU8* surf = (MxU8*) p_ddsd.lpSurface + p_ddsd.lPitch * row + xShift * 2;
+					*(MxU16*) surf = 0;
+				}
+				else {
+					MxU8* surf = (MxU8*) p_ddsd.lpSurface + p_ddsd.lPitch * row + xShift * 4;
+					*(MxU32*) surf = 0xFF000000;
+				}
+			}
+		}
+	}
+
+	void Mosaic(DDSURFACEDESC& p_ddsd, MxS32 p_tick)
+	{
+		for (MxS32 col = 0; col < 64; col++) {
+			if (p_tick * 4 > m_columnOrder[col] || p_tick * 4 + 3 < m_columnOrder[col]) {
+				continue;
+			}
+
+			for (MxS32 row = 0; row < 48; row++) {
+				MxS32 xShift = 10 * ((m_randomShift[row] + col) % 64);
+				MxS32 bytesPerPixel = p_ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
+				MxU8* source = (MxU8*) p_ddsd.lpSurface + 10 * row * p_ddsd.lPitch + bytesPerPixel * xShift;
+
+				MxU32 sample;
+				switch (bytesPerPixel) {
+				case 1:
+					sample = *source;
+					break;
+				case 2:
+					sample = *(MxU16*) source;
+					break;
+				default:
+					sample = *(MxU32*) source;
+					break;
+				}
+
+				for (MxS32 k = 10 * row; k < 10 * row + 10; k++) {
+					MxU8* pos = (MxU8*) p_ddsd.lpSurface + k * p_ddsd.lPitch + bytesPerPixel * xShift;
+
+					for (MxS32 tt = 0; tt < 10; tt++) {
+						switch (bytesPerPixel) {
+						case 1:
+							pos[tt] = (MxU8) sample;
+							break;
+						case 2:
+							((MxU16*) pos)[tt] = (MxU16) sample;
+							break;
+						default:
+							((MxU32*) pos)[tt] = sample;
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	MxU16 m_columnOrder[640];
+	MxU16 m_randomShift[480];
+};
+
+// Fills both surfaces with the same noise, which the random numbers of the
+// transitions do not depend on
+static void FillSurfaces(MxU32 p_seed)
+{
+	IsleRandom random(p_seed);
+
+	for (MxU32 i = 0; i < sizeof(g_surface); i++) {
+		g_surface[i] = (MxU8) random.Next(256);
+	}
+
+	SDL_memcpy(g_original, g_surface, sizeof(g_surface));
+}
+
+static void SetupSurface(DDSURFACEDESC& p_ddsd, MxU8* p_pixels, MxU32 p_bitCount)
+{
+	SDL_zero(p_ddsd);
+	p_ddsd.dwSize = sizeof(p_ddsd);
+	p_ddsd.lpSurface = p_pixels;
+	p_ddsd.lPitch = TEST_PITCH;
+	p_ddsd.ddpfPixelFormat.dwRGBBitCount = p_bitCount;
+}
+
+// Every tick of the dissolve leaves the same pixels as the original loop, at
+// every pixel size, for a fixed set of seeds
+ISLE_TEST(TransitionDissolveMatchesOriginal)
+{
+	static const MxU32 bitCounts[] = {8, 16, 32};
+
+	for (MxU32 seed = 1; seed <= 8; seed++) {
+		for (MxU32 b = 0; b < sizeof(bitCounts) / sizeof(bitCounts[0]); b++) {
+			OriginalTransition original;
+			MxU16 columnOrder[640];
+			MxU16 randomShift[480];
+			DDSURFACEDESC originalDesc;
+			DDSURFACEDESC desc;
+
+			SDL_srand(seed);
+			original.Start(640, 480);
+
+			SDL_srand(seed);
+			ShuffleColumns(columnOrder, 640);
+			for (MxS32 i = 0; i < 480; i++) {
+				randomShift[i] = SDL_rand(640);
+			}
+
+			ISLE_CHECK(SDL_memcmp(randomShift, original.m_randomShift, sizeof(randomShift)) == 0);
+
+			FillSurfaces(seed);
+			SetupSurface(originalDesc, g_original, bitCounts[b]);
+			SetupSurface(desc, g_surface, bitCounts[b]);
+
+			for (MxS32 tick = 0; tick < 40; tick++) {
+				original.Dissolve(originalDesc, tick);
+
+				MxU16 columns[16];
+				GetTickColumns(columnOrder, tick, 16, columns);
+
+				switch (bitCounts[b]) {
+				case 8:
+					DissolveRows<MxU8>(&desc, randomShift, columns, 16, 0);
+					break;
+				case 16:
+					DissolveRows<MxU16>(&desc, randomShift, columns, 16, 0);
+					break;
+				default:
+					DissolveRows<MxU32>(&desc, randomShift, columns, 16, 0xFF000000);
+					break;
+				}
+
+				ISLE_CHECK(SDL_memcmp(g_surface, g_original, sizeof(g_surface)) == 0);
+			}
+		}
+	}
+}
+
+// Every tick of the mosaic leaves the same pixels as the original loop, at
+// every pixel size, for a fixed set of seeds
+ISLE_TEST(TransitionMosaicMatchesOriginal)
+{
+	static const MxU32 bitCounts[] = {8, 16, 32};
+
+	for (MxU32 seed = 1; seed <= 8; seed++) {
+		for (MxU32 b = 0; b < sizeof(bitCounts) / sizeof(bitCounts[0]); b++) {
+			OriginalTransition original;
+			MxU16 columnOrder[64];
+			MxU16 randomShift[48];
+			DDSURFACEDESC originalDesc;
+			DDSURFACEDESC desc;
+
+			SDL_srand(seed);
+			original.Start(64, 48);
+
+			SDL_srand(seed);
+			ShuffleColumns(columnOrder, 64);
+			for (MxS32 i = 0; i < 48; i++) {
+				randomShift[i] = SDL_rand(64);
+			}
+
+			ISLE_CHECK(SDL_memcmp(randomShift, original.m_randomShift, sizeof(randomShift)) == 0);
+
+			FillSurfaces(seed);
+			SetupSurface(originalDesc, g_original, bitCounts[b]);
+			SetupSurface(desc, g_surface, bitCounts[b]);
+
+			for (MxS32 tick = 0; tick < 16; tick++) {
+				original.Mosaic(originalDesc, tick);
+
+				MxU16 columns[4];
+				GetTickColumns(columnOrder, tick, 4, columns);
+
+				switch (bitCounts[b]) {
+				case 8:
+					MosaicBlocks<MxU8>(&desc, randomShift, columns, 4);
+					break;
+				case 16:
+					MosaicBlocks<MxU16>(&desc, randomShift, columns, 4);
+					break;
+				default:
+					MosaicBlocks<MxU32>(&desc, randomShift, columns, 4);
+					break;
+				}
+
+				ISLE_CHECK(SDL_memcmp(g_surface, g_original, sizeof(g_surface)) == 0);
+			}
+		}
+	}
+}